@@ -4879,6 +4879,22 @@ compile_test() {
             compile_check_conftest "$CODE" "NV_PAGE_PGMAP_PRESENT" "" "functions"
         ;;
 
+        vm_insert_pages)
+            #
+            # Determine if the vm_insert_pages() function is present.
+            #
+            # Added by commit 8cd3984d81d5 ("mm/memory.c: add
+            # vm_insert_pages()") in v5.8
+            #
+            CODE="
+            #include <linux/mm.h>
+            int conftest_vm_insert_pages(void) {
+                return vm_insert_pages();
+            }"
+
+            compile_check_conftest "$CODE" "NV_VM_INSERT_PAGES_PRESENT" "" "functions"
+        ;;
+
     folio_test_swapcache)
             #
             # Determine if the folio_test_swapcache() function is present.
@@ -181,6 +181,75 @@ static void channel_pool_unlock(uvm_channel_pool_t *pool)
         uvm_spin_unlock(&pool->spinlock);
 }
 
+NvU32 uvm_channel_wait_histogram_bucket(NvU64 wait_ns)
+{
+    NvU64 wait_us = wait_ns / 1000;
+
+    if (wait_us == 0)
+        return 0;
+
+    return min((NvU32)ilog2(wait_us) + 1, (NvU32)UVM_PUSH_WAIT_HISTOGRAM_BUCKETS - 1);
+}
+
+NvU32 uvm_channel_occupancy_histogram_bucket(NvU32 used, NvU32 total)
+{
+    UVM_ASSERT(total > 0);
+
+    return min((NvU32)(((NvU64)used * UVM_PUSH_OCCUPANCY_HISTOGRAM_BUCKETS) / total),
+               (NvU32)UVM_PUSH_OCCUPANCY_HISTOGRAM_BUCKETS - 1);
+}
+
+// Account a successful reservation of the given channel. wait_start_ns is the
+// time at which the reservation started waiting for GPFIFO space, or 0 if it
+// was satisfied without waiting.
+//
+// The statistics are only visible in debug procfs, so they are not collected
+// otherwise to keep the atomics off the push paths.
+static void channel_pool_record_reservation(uvm_channel_pool_t *pool, uvm_channel_t *channel, NvU64 wait_start_ns)
+{
+    NvU32 fullness;
+
+    if (!uvm_procfs_is_debug_enabled())
+        return;
+
+    fullness = uvm_channel_occupancy_histogram_bucket(READ_ONCE(channel->current_gpfifo_count),
+                                                      channel->num_gpfifo_entries);
+
+    atomic64_inc(&pool->stats.num_reservations);
+    atomic64_inc(&pool->stats.gpfifo_fullness_histogram[fullness]);
+
+    if (wait_start_ns != 0) {
+        NvU64 wait_ns = NV_GETTIME() - wait_start_ns;
+
+        atomic64_inc(&pool->stats.num_stalls);
+        atomic64_add(wait_ns, &pool->stats.stall_ns);
+        atomic64_inc(&pool->stats.stall_histogram[uvm_channel_wait_histogram_bucket(wait_ns)]);
+    }
+}
+
+// Same as channel_pool_record_reservation(), only collected with debug procfs
+static void channel_pool_record_completed_lag(uvm_channel_pool_t *pool, NvU64 lag)
+{
+    NvU64 max_lag;
+    NvU32 bucket;
+
+    if (!uvm_procfs_is_debug_enabled())
+        return;
+
+    max_lag = atomic64_read(&pool->stats.completed_lag_max);
+    bucket = lag == 0 ? 0 : min((NvU32)ilog2(lag) + 1, (NvU32)UVM_CHANNEL_LAG_HISTOGRAM_BUCKETS - 1);
+
+    atomic64_inc(&pool->stats.completed_lag_histogram[bucket]);
+
+    while (lag > max_lag) {
+        NvU64 prev = atomic64_cmpxchg(&pool->stats.completed_lag_max, max_lag, lag);
+        if (prev == max_lag)
+            break;
+
+        max_lag = prev;
+    }
+}
+
 // Update channel progress, completing up to max_to_complete entries
 static NvU32 uvm_channel_update_progress_with_max(uvm_channel_t *channel,
                                                   NvU32 max_to_complete,
@@ -190,6 +259,7 @@ static NvU32 uvm_channel_update_progress_with_max(uvm_channel_t *channel,
     NvU32 cpu_put;
     NvU32 completed_count = 0;
     NvU32 pending_gpfifos;
+    NvU64 queued_value;
 
     NvU64 completed_value = uvm_channel_update_completed_value(channel);
 
@@ -211,6 +281,7 @@ static NvU32 uvm_channel_update_progress_with_max(uvm_channel_t *channel,
 
     cpu_put = channel->cpu_put;
     gpu_get = channel->gpu_get;
+    queued_value = channel->tracking_sem.queued_value;
 
     while (gpu_get != cpu_put && completed_count < max_to_complete) {
         uvm_gpfifo_entry_t *entry = &channel->gpfifo_entries[gpu_get];
@@ -231,6 +302,8 @@ static NvU32 uvm_channel_update_progress_with_max(uvm_channel_t *channel,
 
     channel_pool_unlock(channel->pool);
 
+    channel_pool_record_completed_lag(channel->pool, queued_value - completed_value);
+
     if (cpu_put >= gpu_get)
         pending_gpfifos = cpu_put - gpu_get;
     else
@@ -514,6 +587,7 @@ static NV_STATUS channel_reserve_and_lock_in_pool(uvm_channel_pool_t *pool,
     uvm_spin_loop_t spin;
     NvU32 index;
     NV_STATUS status;
+    NvU64 wait_start_ns = 0;
 
     UVM_ASSERT(pool);
     UVM_ASSERT(g_uvm_global.conf_computing_enabled);
@@ -547,6 +621,7 @@ static NV_STATUS channel_reserve_and_lock_in_pool(uvm_channel_pool_t *pool,
 
     // No channels are available. Update and check errors on all channels until
     // one becomes available.
+    wait_start_ns = NV_GETTIME();
     uvm_spin_loop_init(&spin);
     while (1) {
         uvm_for_each_channel_in_pool(channel, pool) {
@@ -576,39 +651,58 @@ static NV_STATUS channel_reserve_and_lock_in_pool(uvm_channel_pool_t *pool,
 
 done:
     channel_pool_unlock(pool);
+    channel_pool_record_reservation(pool, channel, wait_start_ns);
     *channel_out = channel;
     return NV_OK;
 }
 
 // Reserve a channel in the specified pool
+//
+// The search for an available channel starts at the channel with index
+// (channel_hint % pool->num_channels) and wraps around the pool, so a hint of 0
+// always prefers the first channel. Callers issuing many independent pushes
+// can vary the hint to spread them across the channels of the pool.
 static NV_STATUS channel_reserve_in_pool(uvm_channel_pool_t *pool,
                                          uvm_channel_reserve_type_t reserve_type,
+                                         NvU32 channel_hint,
                                          uvm_channel_t **channel_out)
 {
     uvm_channel_t *channel;
     uvm_spin_loop_t spin;
+    NvU32 first_index;
+    NvU32 i;
+    NvU64 wait_start_ns;
 
     UVM_ASSERT(pool);
 
     if (g_uvm_global.conf_computing_enabled)
         return channel_reserve_and_lock_in_pool(pool, reserve_type, channel_out);
 
-    uvm_for_each_channel_in_pool(channel, pool) {
+    first_index = channel_hint % pool->num_channels;
+
+    for (i = 0; i < pool->num_channels; i++) {
+        channel = pool->channels + (first_index + i) % pool->num_channels;
+
         // TODO: Bug 1764953: Prefer idle/less busy channels
         if (try_claim_channel(channel, 1, reserve_type)) {
+            channel_pool_record_reservation(pool, channel, 0);
             *channel_out = channel;
             return NV_OK;
         }
     }
 
+    wait_start_ns = NV_GETTIME();
     uvm_spin_loop_init(&spin);
     while (1) {
-        uvm_for_each_channel_in_pool(channel, pool) {
+        for (i = 0; i < pool->num_channels; i++) {
             NV_STATUS status;
 
+            channel = pool->channels + (first_index + i) % pool->num_channels;
+
             uvm_channel_update_progress(channel);
 
             if (try_claim_channel(channel, 1, reserve_type)) {
+                channel_pool_record_reservation(pool, channel, wait_start_ns);
                 *channel_out = channel;
 
                 return NV_OK;
@@ -630,7 +724,10 @@ static NV_STATUS channel_reserve_in_pool(uvm_channel_pool_t *pool,
     return NV_ERR_GENERIC;
 }
 
-NV_STATUS uvm_channel_reserve_type(uvm_channel_manager_t *manager, uvm_channel_type_t type, uvm_channel_t **channel_out)
+NV_STATUS uvm_channel_reserve_type_with_hint(uvm_channel_manager_t *manager,
+                                             uvm_channel_type_t type,
+                                             NvU32 channel_hint,
+                                             uvm_channel_t **channel_out)
 {
     uvm_channel_reserve_type_t reserve_type;
     uvm_channel_pool_t *pool = manager->pool_to_use.default_for_type[type];
@@ -643,12 +740,18 @@ NV_STATUS uvm_channel_reserve_type(uvm_channel_manager_t *manager, uvm_channel_t
     else
         reserve_type = UVM_CHANNEL_RESERVE_NO_P2P;
 
-    return channel_reserve_in_pool(pool, reserve_type, channel_out);
+    return channel_reserve_in_pool(pool, reserve_type, channel_hint, channel_out);
 }
 
-NV_STATUS uvm_channel_reserve_gpu_to_gpu(uvm_channel_manager_t *manager,
-                                         uvm_gpu_t *dst_gpu,
-                                         uvm_channel_t **channel_out)
+NV_STATUS uvm_channel_reserve_type(uvm_channel_manager_t *manager, uvm_channel_type_t type, uvm_channel_t **channel_out)
+{
+    return uvm_channel_reserve_type_with_hint(manager, type, 0, channel_out);
+}
+
+NV_STATUS uvm_channel_reserve_gpu_to_gpu_with_hint(uvm_channel_manager_t *manager,
+                                                   uvm_gpu_t *dst_gpu,
+                                                   NvU32 channel_hint,
+                                                   uvm_channel_t **channel_out)
 {
     const NvU32 dst_gpu_index = uvm_id_gpu_index(dst_gpu->id);
     uvm_channel_pool_t *pool = manager->pool_to_use.gpu_to_gpu[dst_gpu_index];
@@ -659,7 +762,46 @@ NV_STATUS uvm_channel_reserve_gpu_to_gpu(uvm_channel_manager_t *manager,
 
     UVM_ASSERT(pool->pool_type == UVM_CHANNEL_POOL_TYPE_CE);
 
-    return channel_reserve_in_pool(pool, UVM_CHANNEL_RESERVE_WITH_P2P, channel_out);
+    return channel_reserve_in_pool(pool, UVM_CHANNEL_RESERVE_WITH_P2P, channel_hint, channel_out);
+}
+
+NV_STATUS uvm_channel_reserve_gpu_to_gpu(uvm_channel_manager_t *manager,
+                                         uvm_gpu_t *dst_gpu,
+                                         uvm_channel_t **channel_out)
+{
+    return uvm_channel_reserve_gpu_to_gpu_with_hint(manager, dst_gpu, 0, channel_out);
+}
+
+uvm_channel_t *uvm_channel_manager_stripe_channel(uvm_channel_manager_t *manager,
+                                                  uvm_channel_type_t type,
+                                                  uvm_gpu_t *dst_gpu,
+                                                  NvU32 channel_hint,
+                                                  NvU32 stripe_index)
+{
+    uvm_channel_pool_t *pool;
+    NvU32 num_pools = 1;
+
+    UVM_ASSERT(!g_uvm_global.conf_computing_enabled);
+    UVM_ASSERT(type < UVM_CHANNEL_TYPE_CE_COUNT);
+
+    if (type == UVM_CHANNEL_TYPE_GPU_TO_GPU) {
+        pool = NULL;
+        if (dst_gpu != NULL)
+            pool = manager->pool_to_use.gpu_to_gpu[uvm_id_gpu_index(dst_gpu->id)];
+
+        if (pool == NULL)
+            pool = manager->pool_to_use.default_for_type[UVM_CHANNEL_TYPE_GPU_TO_GPU];
+    }
+    else {
+        num_pools = manager->pool_to_use.num_stripe_pools[type];
+        UVM_ASSERT(num_pools > 0);
+
+        pool = manager->pool_to_use.stripe_for_type[type][stripe_index % num_pools];
+    }
+
+    UVM_ASSERT(pool->pool_type == UVM_CHANNEL_POOL_TYPE_CE);
+
+    return pool->channels + (channel_hint + stripe_index / num_pools) % pool->num_channels;
 }
 
 NV_STATUS uvm_channel_manager_wait(uvm_channel_manager_t *manager)
@@ -1814,6 +1956,7 @@ static NV_STATUS channel_reserve_and_lock(uvm_channel_t *channel,
     NV_STATUS status;
     uvm_spin_loop_t spin;
     uvm_channel_pool_t *pool = channel->pool;
+    NvU64 wait_start_ns = 0;
 
     UVM_ASSERT(g_uvm_global.conf_computing_enabled);
 
@@ -1837,6 +1980,7 @@ static NV_STATUS channel_reserve_and_lock(uvm_channel_t *channel,
 
     channel_pool_unlock(pool);
 
+    wait_start_ns = NV_GETTIME();
     uvm_spin_loop_init(&spin);
     while (1) {
         uvm_channel_update_progress(channel);
@@ -1859,6 +2003,7 @@ static NV_STATUS channel_reserve_and_lock(uvm_channel_t *channel,
 
 out:
     channel_pool_unlock(pool);
+    channel_pool_record_reservation(pool, channel, wait_start_ns);
     return NV_OK;
 }
 
@@ -1866,15 +2011,19 @@ NV_STATUS uvm_channel_reserve(uvm_channel_t *channel, NvU32 num_gpfifo_entries)
 {
     NV_STATUS status = NV_OK;
     uvm_spin_loop_t spin;
+    NvU64 wait_start_ns;
 
     // Direct channel reservations don't use p2p
     if (g_uvm_global.conf_computing_enabled)
         return channel_reserve_and_lock(channel, num_gpfifo_entries, UVM_CHANNEL_RESERVE_NO_P2P);
 
     // Direct channel reservations don't use p2p
-    if (try_claim_channel(channel, num_gpfifo_entries, UVM_CHANNEL_RESERVE_NO_P2P))
+    if (try_claim_channel(channel, num_gpfifo_entries, UVM_CHANNEL_RESERVE_NO_P2P)) {
+        channel_pool_record_reservation(channel->pool, channel, 0);
         return NV_OK;
+    }
 
+    wait_start_ns = NV_GETTIME();
     uvm_channel_update_progress(channel);
 
     uvm_spin_loop_init(&spin);
@@ -1884,6 +2033,9 @@ NV_STATUS uvm_channel_reserve(uvm_channel_t *channel, NvU32 num_gpfifo_entries)
         uvm_channel_update_progress(channel);
     }
 
+    if (status == NV_OK)
+        channel_pool_record_reservation(channel->pool, channel, wait_start_ns);
+
     return status;
 }
 
@@ -2910,6 +3062,29 @@ static NV_STATUS channel_pool_add(uvm_channel_manager_t *channel_manager,
     return status;
 }
 
+// Whether the CE can process stripes of large copies of the given type, in
+// addition to the CE preferred for the type.
+static bool ce_can_stripe_for_channel_type(const UvmGpuCopyEngineCaps *cap, uvm_channel_type_t type)
+{
+    // CEs sharing PCEs with other CEs don't add copy bandwidth
+    if (cap->shared)
+        return false;
+
+    switch (type) {
+        case UVM_CHANNEL_TYPE_CPU_TO_GPU:
+        case UVM_CHANNEL_TYPE_GPU_TO_CPU:
+            return cap->sysmem;
+
+        case UVM_CHANNEL_TYPE_GPU_INTERNAL:
+            return true;
+
+        // GPU to GPU stripes stay in the pool selected for the peer, since the
+        // optimal CE depends on the links between the GPUs.
+        default:
+            return false;
+    }
+}
+
 static bool ce_is_usable(const UvmGpuCopyEngineCaps *cap)
 {
     // When Confidential Computing is enabled, all Copy Engines must support
@@ -3094,9 +3269,13 @@ static void pick_ces_for_channel_types(uvm_channel_manager_t *manager,
             // In Confidential Computing, do not mark all usable CEs, only the
             // preferred ones, because non-preferred CE channels are guaranteed
             // to not be used.
-            if (!g_uvm_global.conf_computing_enabled)
+            if (!g_uvm_global.conf_computing_enabled) {
                 __set_bit(ce, manager->ce_mask);
 
+                if (type < UVM_CHANNEL_TYPE_CE_COUNT && ce_can_stripe_for_channel_type(ce_caps + ce, type))
+                    __set_bit(ce, manager->stripe_ce_mask[type]);
+            }
+
             if (best_ce == UVM_COPY_ENGINE_COUNT_MAX) {
                 best_ce = ce;
                 continue;
@@ -3452,6 +3631,22 @@ static NV_STATUS channel_manager_create_ce_pools(uvm_channel_manager_t *manager,
         manager->pool_to_use.default_for_type[type] = channel_manager_ce_pool(manager, ce);
     }
 
+    for (type = 0; type < UVM_CHANNEL_TYPE_CE_COUNT; type++) {
+        uvm_channel_pool_t *default_pool = manager->pool_to_use.default_for_type[type];
+        NvU32 num_pools = 0;
+
+        manager->pool_to_use.stripe_for_type[type][num_pools++] = default_pool;
+
+        for_each_set_bit(ce, manager->stripe_ce_mask[type], UVM_COPY_ENGINE_COUNT_MAX) {
+            uvm_channel_pool_t *pool = channel_manager_ce_pool(manager, ce);
+
+            if (pool != default_pool)
+                manager->pool_to_use.stripe_for_type[type][num_pools++] = pool;
+        }
+
+        manager->pool_to_use.num_stripe_pools[type] = num_pools;
+    }
+
     return NV_OK;
 }
 
@@ -3978,6 +4173,7 @@ void uvm_channel_manager_destroy(uvm_channel_manager_t *channel_manager)
     if (channel_manager == NULL)
         return;
 
+    proc_remove(channel_manager->procfs.pool_stats);
     proc_remove(channel_manager->procfs.pending_pushes);
 
     if (uvm_channel_manager_is_wlc_ready(channel_manager))
@@ -4260,6 +4456,75 @@ static void channel_manager_print_pending_pushes(uvm_channel_manager_t *manager,
     }
 }
 
+void uvm_channel_print_wait_histogram(atomic64_t *histogram, struct seq_file *s)
+{
+    NvU32 i;
+
+    UVM_SEQ_OR_DBG_PRINT(s, "  wait_us < 1         %llu\n", (NvU64)atomic64_read(&histogram[0]));
+    for (i = 1; i < UVM_PUSH_WAIT_HISTOGRAM_BUCKETS; i++) {
+        UVM_SEQ_OR_DBG_PRINT(s,
+                             "  wait_us >= %-8u %llu\n",
+                             1u << (i - 1),
+                             (NvU64)atomic64_read(&histogram[i]));
+    }
+}
+
+void uvm_channel_print_occupancy_histogram(atomic64_t *histogram, struct seq_file *s)
+{
+    NvU32 i;
+
+    for (i = 0; i < UVM_PUSH_OCCUPANCY_HISTOGRAM_BUCKETS; i++) {
+        UVM_SEQ_OR_DBG_PRINT(s,
+                             "  full %3u%%-%3u%%      %llu\n",
+                             (i * 100) / UVM_PUSH_OCCUPANCY_HISTOGRAM_BUCKETS,
+                             ((i + 1) * 100) / UVM_PUSH_OCCUPANCY_HISTOGRAM_BUCKETS,
+                             (NvU64)atomic64_read(&histogram[i]));
+    }
+}
+
+static void channel_pool_print_stats(uvm_channel_pool_t *pool, struct seq_file *s)
+{
+    NvU64 num_reservations = atomic64_read(&pool->stats.num_reservations);
+    NvU64 num_stalls = atomic64_read(&pool->stats.num_stalls);
+    NvU64 stall_ns = atomic64_read(&pool->stats.stall_ns);
+    NvU32 i;
+
+    UVM_SEQ_OR_DBG_PRINT(s,
+                         "Pool %u type %s engine %u\n",
+                         uvm_channel_pool_index_in_channel_manager(pool),
+                         uvm_channel_pool_type_to_string(pool->pool_type),
+                         pool->engine_index);
+    UVM_SEQ_OR_DBG_PRINT(s, " reservations           %llu\n", num_reservations);
+    UVM_SEQ_OR_DBG_PRINT(s, " reservation_stalls     %llu\n", num_stalls);
+    UVM_SEQ_OR_DBG_PRINT(s, " stall_time_us          %llu\n", stall_ns / 1000);
+    UVM_SEQ_OR_DBG_PRINT(s, " avg_stall_us           %llu\n", num_stalls ? stall_ns / 1000 / num_stalls : 0);
+    UVM_SEQ_OR_DBG_PRINT(s, " stall_histogram:\n");
+    uvm_channel_print_wait_histogram(pool->stats.stall_histogram, s);
+    UVM_SEQ_OR_DBG_PRINT(s, " gpfifo_fullness_histogram:\n");
+    uvm_channel_print_occupancy_histogram(pool->stats.gpfifo_fullness_histogram, s);
+    UVM_SEQ_OR_DBG_PRINT(s,
+                         " completed_lag_max      %llu\n",
+                         (NvU64)atomic64_read(&pool->stats.completed_lag_max));
+    UVM_SEQ_OR_DBG_PRINT(s, " completed_lag_histogram:\n");
+    UVM_SEQ_OR_DBG_PRINT(s,
+                         "  lag 0               %llu\n",
+                         (NvU64)atomic64_read(&pool->stats.completed_lag_histogram[0]));
+    for (i = 1; i < UVM_CHANNEL_LAG_HISTOGRAM_BUCKETS; i++) {
+        UVM_SEQ_OR_DBG_PRINT(s,
+                             "  lag >= %-12u %llu\n",
+                             1u << (i - 1),
+                             (NvU64)atomic64_read(&pool->stats.completed_lag_histogram[i]));
+    }
+}
+
+static void channel_manager_print_pool_stats(uvm_channel_manager_t *manager, struct seq_file *seq)
+{
+    uvm_channel_pool_t *pool;
+
+    uvm_for_each_pool(pool, manager)
+        channel_pool_print_stats(pool, seq);
+}
+
 static NV_STATUS manager_create_procfs_dirs(uvm_channel_manager_t *manager)
 {
     uvm_gpu_t *gpu = manager->gpu;
@@ -4296,6 +4561,27 @@ static int nv_procfs_read_manager_pending_pushes_entry(struct seq_file *s, void
 
 UVM_DEFINE_SINGLE_PROCFS_FILE(manager_pending_pushes_entry);
 
+static int nv_procfs_read_manager_pool_stats(struct seq_file *s, void *v)
+{
+    uvm_channel_manager_t *manager = (uvm_channel_manager_t *)s->private;
+
+    if (!uvm_down_read_trylock(&g_uvm_global.pm.lock))
+        return -EAGAIN;
+
+    channel_manager_print_pool_stats(manager, s);
+
+    uvm_up_read(&g_uvm_global.pm.lock);
+
+    return 0;
+}
+
+static int nv_procfs_read_manager_pool_stats_entry(struct seq_file *s, void *v)
+{
+    UVM_ENTRY_RET(nv_procfs_read_manager_pool_stats(s, v));
+}
+
+UVM_DEFINE_SINGLE_PROCFS_FILE(manager_pool_stats_entry);
+
 static NV_STATUS manager_create_procfs(uvm_channel_manager_t *manager)
 {
     uvm_gpu_t *gpu = manager->gpu;
@@ -4311,6 +4597,13 @@ static NV_STATUS manager_create_procfs(uvm_channel_manager_t *manager)
     if (manager->procfs.pending_pushes == NULL)
         return NV_ERR_OPERATING_SYSTEM;
 
+    manager->procfs.pool_stats = NV_CREATE_PROC_FILE("pool_stats",
+                                                     manager->procfs.channels_dir,
+                                                     manager_pool_stats_entry,
+                                                     manager);
+    if (manager->procfs.pool_stats == NULL)
+        return NV_ERR_OPERATING_SYSTEM;
+
     return NV_OK;
 }
 
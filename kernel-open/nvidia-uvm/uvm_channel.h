@@ -189,6 +189,9 @@ struct uvm_gpfifo_entry_struct
     uvm_push_info_t *push_info;
 };
 
+// Number of log2 buckets in the completed value lag histogram
+#define UVM_CHANNEL_LAG_HISTOGRAM_BUCKETS 8
+
 // A channel pool is a set of channels that use the same engine. For example,
 // all channels in a CE pool share the same (logical) Copy Engine.
 typedef struct
@@ -288,6 +291,29 @@ typedef struct
         } key_rotation;
 
     } conf_computing;
+
+    // Push reservation and channel occupancy statistics, updated locklessly
+    // and printed in the channels/pool_stats procfs file. Only collected when
+    // debug procfs is enabled.
+    struct
+    {
+        // Number of channel reservations in the pool
+        atomic64_t num_reservations;
+
+        // Reservations that found no GPFIFO space and had to wait for the GPU
+        // to make progress, the total time spent waiting, and its distribution
+        atomic64_t num_stalls;
+        atomic64_t stall_ns;
+        atomic64_t stall_histogram[UVM_PUSH_WAIT_HISTOGRAM_BUCKETS];
+
+        // GPFIFO fullness of the reserved channel, sampled on reservation
+        atomic64_t gpfifo_fullness_histogram[UVM_PUSH_OCCUPANCY_HISTOGRAM_BUCKETS];
+
+        // Number of tracking semaphore values queued but not yet completed,
+        // sampled on each progress update
+        atomic64_t completed_lag_max;
+        atomic64_t completed_lag_histogram[UVM_CHANNEL_LAG_HISTOGRAM_BUCKETS];
+    } stats;
 } uvm_channel_pool_t;
 
 struct uvm_channel_struct
@@ -439,6 +465,11 @@ struct uvm_channel_manager_struct
     // has at least one pool of type UVM_CHANNEL_POOL_TYPE_CE associated with it
     DECLARE_BITMAP(ce_mask, UVM_COPY_ENGINE_COUNT_MAX);
 
+    // Masks containing, for each CE channel type, the indexes of the usable
+    // Copy Engines that can also process stripes of large copies of that type.
+    // Always empty when Confidential Computing is enabled.
+    DECLARE_BITMAP(stripe_ce_mask[UVM_CHANNEL_TYPE_CE_COUNT], UVM_COPY_ENGINE_COUNT_MAX);
+
     struct
     {
         // Pools to be used by each channel type by default.
@@ -454,12 +485,21 @@ struct uvm_channel_manager_struct
         // If there is no optimal pool (the entry is NULL), use default pool
         // default_for_type[UVM_CHANNEL_GPU_TO_GPU] instead.
         uvm_channel_pool_t *gpu_to_gpu[UVM_ID_MAX_GPUS];
+
+        // Pools across which the stripes of large copies of each CE channel
+        // type are spread. The first entry is always default_for_type[type].
+        // See uvm_channel_manager_stripe_channel().
+        uvm_channel_pool_t *stripe_for_type[UVM_CHANNEL_TYPE_CE_COUNT][UVM_COPY_ENGINE_COUNT_MAX];
+
+        // Number of valid entries in each stripe_for_type array
+        NvU32 num_stripe_pools[UVM_CHANNEL_TYPE_CE_COUNT];
     } pool_to_use;
 
     struct
     {
         struct proc_dir_entry *channels_dir;
         struct proc_dir_entry *pending_pushes;
+        struct proc_dir_entry *pool_stats;
     } procfs;
 
     struct
@@ -690,6 +730,38 @@ NV_STATUS uvm_channel_reserve_gpu_to_gpu(uvm_channel_manager_t *channel_manager,
                                          uvm_gpu_t *dst_gpu,
                                          uvm_channel_t **channel_out);
 
+// Same as uvm_channel_reserve_type and uvm_channel_reserve_gpu_to_gpu, except
+// that the search for an available channel starts at the channel with index
+// (channel_hint % num_channels) of the selected pool, instead of always
+// starting at the first channel. A hint of 0 is equivalent to the functions
+// above. The hint is ignored when Confidential Computing is enabled.
+NV_STATUS uvm_channel_reserve_type_with_hint(uvm_channel_manager_t *manager,
+                                             uvm_channel_type_t type,
+                                             NvU32 channel_hint,
+                                             uvm_channel_t **channel_out);
+
+NV_STATUS uvm_channel_reserve_gpu_to_gpu_with_hint(uvm_channel_manager_t *channel_manager,
+                                                   uvm_gpu_t *dst_gpu,
+                                                   NvU32 channel_hint,
+                                                   uvm_channel_t **channel_out);
+
+// Return the channel to use for the stripe_index-th stripe of a copy of the
+// given CE channel type, when a large copy is split into stripes pushed on
+// different channels. Stripes are spread round-robin across the pools in
+// manager->pool_to_use.stripe_for_type[type], and across the channels of each
+// pool starting at the channel with index (channel_hint % num_channels).
+//
+// GPU to GPU stripes are only spread across the channels of the pool used for
+// transfers to dst_gpu.
+//
+// The channel is not reserved. Must not be called when Confidential Computing
+// is enabled.
+uvm_channel_t *uvm_channel_manager_stripe_channel(uvm_channel_manager_t *manager,
+                                                  uvm_channel_type_t type,
+                                                  uvm_gpu_t *dst_gpu,
+                                                  NvU32 channel_hint,
+                                                  NvU32 stripe_index);
+
 // Reserve a specific channel for a push or for a control GPFIFO entry.
 NV_STATUS uvm_channel_reserve(uvm_channel_t *channel, NvU32 num_gpfifo_entries);
 
@@ -728,6 +800,13 @@ NvU32 uvm_channel_get_available_gpfifo_entries(uvm_channel_t *channel);
 void uvm_gpu_print_ce_mapping(const uvm_gpu_t *gpu, struct seq_file *s);
 void uvm_channel_print_pending_pushes(uvm_channel_t *channel);
 
+// Histogram helpers shared by the channel pool and pushbuffer statistics.
+// Wait buckets are log2 microseconds, occupancy buckets are quartiles of total.
+NvU32 uvm_channel_wait_histogram_bucket(NvU64 wait_ns);
+NvU32 uvm_channel_occupancy_histogram_bucket(NvU32 used, NvU32 total);
+void uvm_channel_print_wait_histogram(atomic64_t *histogram, struct seq_file *s);
+void uvm_channel_print_occupancy_histogram(atomic64_t *histogram, struct seq_file *s);
+
 bool uvm_channel_is_locked_for_push(uvm_channel_t *channel);
 
 static uvm_gpu_t *uvm_channel_get_gpu(uvm_channel_t *channel)
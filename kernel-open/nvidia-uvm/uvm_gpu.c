@@ -558,6 +558,8 @@ static void gpu_info_print_common(uvm_gpu_t *gpu, struct seq_file *s)
     NvU64 num_pages_in;
     NvU64 num_pages_out;
     NvU64 mapped_cpu_pages_size;
+    NvU64 pte_batches;
+    NvU64 pte_bytes_written;
     NvU32 get;
     NvU32 put;
     NvU32 i;
@@ -640,8 +642,14 @@ static void gpu_info_print_common(uvm_gpu_t *gpu, struct seq_file *s)
                              gpu->parent->fault_buffer.max_batch_size);
         UVM_SEQ_OR_DBG_PRINT(s, "replayable_faults_replay_policy        %s\n",
                              uvm_perf_fault_replay_policy_string(gpu->parent->fault_buffer.replayable.replay_policy));
+        UVM_SEQ_OR_DBG_PRINT(s, "replayable_faults_service_workers      %u\n",
+                             gpu->parent->fault_buffer.replayable.parallel.num_workers);
+        UVM_SEQ_OR_DBG_PRINT(s, "replayable_faults_parallel_batches     %llu\n",
+                             gpu->parent->fault_buffer.replayable.parallel.num_parallel_batches);
+        UVM_SEQ_OR_DBG_PRINT(s, "replayable_faults_pipelined_batches    %llu\n",
+                             gpu->parent->fault_buffer.replayable.pipeline.num_pipelined_batches);
         UVM_SEQ_OR_DBG_PRINT(s, "replayable_faults_num_faults           %llu\n",
-                             gpu->parent->stats.num_replayable_faults);
+                             (NvU64)atomic64_read(&gpu->parent->stats.num_replayable_faults));
     }
     if (gpu->parent->isr.non_replayable_faults.handling) {
         UVM_SEQ_OR_DBG_PRINT(s, "non_replayable_faults_bh               %llu\n",
@@ -698,6 +706,15 @@ static void gpu_info_print_common(uvm_gpu_t *gpu, struct seq_file *s)
                          mapped_cpu_pages_size / PAGE_SIZE,
                          mapped_cpu_pages_size / (1024u * 1024u));
 
+    pte_batches = atomic64_read(&gpu->parent->stats.pte_batch.num_batches);
+    pte_bytes_written = atomic64_read(&gpu->parent->stats.pte_batch.bytes_written);
+    UVM_SEQ_OR_DBG_PRINT(s, "pte_batches                            %llu\n", pte_batches);
+    UVM_SEQ_OR_DBG_PRINT(s, "pte_bytes_written                      %llu\n", pte_bytes_written);
+    UVM_SEQ_OR_DBG_PRINT(s, "pte_bytes_inline                       %llu\n",
+                         (NvU64)atomic64_read(&gpu->parent->stats.pte_batch.bytes_inline));
+    UVM_SEQ_OR_DBG_PRINT(s, "pte_bytes_per_batch                    %llu\n",
+                         pte_batches ? pte_bytes_written / pte_batches : 0);
+
     gpu_info_print_ce_caps(gpu, s);
     uvm_gpu_print_ce_mapping(gpu, s);
 
@@ -715,18 +732,20 @@ gpu_fault_stats_print_common(uvm_parent_gpu_t *parent_gpu, struct seq_file *s)
 
     UVM_ASSERT(uvm_procfs_is_debug_enabled());
 
-    UVM_SEQ_OR_DBG_PRINT(s, "replayable_faults      %llu\n", parent_gpu->stats.num_replayable_faults);
+    UVM_SEQ_OR_DBG_PRINT(s,
+                         "replayable_faults      %llu\n",
+                         (NvU64)atomic64_read(&parent_gpu->stats.num_replayable_faults));
     UVM_SEQ_OR_DBG_PRINT(s, "duplicates             %llu\n",
-                         parent_gpu->fault_buffer.replayable.stats.num_duplicate_faults);
+                         (NvU64)atomic64_read(&parent_gpu->fault_buffer.replayable.stats.num_duplicate_faults));
     UVM_SEQ_OR_DBG_PRINT(s, "faults_by_access_type:\n");
     UVM_SEQ_OR_DBG_PRINT(s, "  prefetch             %llu\n",
-                         parent_gpu->fault_buffer.replayable.stats.num_prefetch_faults);
+                         (NvU64)atomic64_read(&parent_gpu->fault_buffer.replayable.stats.num_prefetch_faults));
     UVM_SEQ_OR_DBG_PRINT(s, "  read                 %llu\n",
-                         parent_gpu->fault_buffer.replayable.stats.num_read_faults);
+                         (NvU64)atomic64_read(&parent_gpu->fault_buffer.replayable.stats.num_read_faults));
     UVM_SEQ_OR_DBG_PRINT(s, "  write                %llu\n",
-                         parent_gpu->fault_buffer.replayable.stats.num_write_faults);
+                         (NvU64)atomic64_read(&parent_gpu->fault_buffer.replayable.stats.num_write_faults));
     UVM_SEQ_OR_DBG_PRINT(s, "  atomic               %llu\n",
-                         parent_gpu->fault_buffer.replayable.stats.num_atomic_faults);
+                         (NvU64)atomic64_read(&parent_gpu->fault_buffer.replayable.stats.num_atomic_faults));
     num_pages_out = atomic64_read(&parent_gpu->fault_buffer.replayable.stats.num_pages_out);
     num_pages_in = atomic64_read(&parent_gpu->fault_buffer.replayable.stats.num_pages_in);
     UVM_SEQ_OR_DBG_PRINT(s, "migrations:\n");
@@ -762,6 +781,47 @@ gpu_fault_stats_print_common(uvm_parent_gpu_t *parent_gpu, struct seq_file *s)
                          (num_pages_out * (NvU64)PAGE_SIZE) / (1024u * 1024u));
 }
 
+static void gpu_fault_batch_control_print_common(uvm_parent_gpu_t *parent_gpu, struct seq_file *s)
+{
+    uvm_replayable_fault_buffer_t *replayable_faults = &parent_gpu->fault_buffer.replayable;
+    uvm_fault_batch_control_t *batch_control = &replayable_faults->batch_control;
+    NvU64 num_decisions = batch_control->num_decisions;
+    NvU64 i;
+
+    UVM_ASSERT(uvm_procfs_is_debug_enabled());
+
+    UVM_SEQ_OR_DBG_PRINT(s, "adaptive                %u\n", batch_control->enabled);
+    UVM_SEQ_OR_DBG_PRINT(s, "batch_size              %u\n", parent_gpu->fault_buffer.max_batch_size);
+    UVM_SEQ_OR_DBG_PRINT(s, "batch_size_range        [%u:%u]\n",
+                         batch_control->min_batch_size,
+                         batch_control->max_batch_size);
+    UVM_SEQ_OR_DBG_PRINT(s, "max_batches_per_service %u\n", batch_control->max_batches_per_service);
+    UVM_SEQ_OR_DBG_PRINT(s, "replay_policy           %s\n",
+                         uvm_perf_fault_replay_policy_string(replayable_faults->replay_policy));
+    UVM_SEQ_OR_DBG_PRINT(s, "replay_update_put_ratio %u\n", replayable_faults->replay_update_put_ratio);
+    UVM_SEQ_OR_DBG_PRINT(s, "decisions               %llu\n", num_decisions);
+
+    if (num_decisions == 0)
+        return;
+
+    UVM_SEQ_OR_DBG_PRINT(s, "history (oldest first):\n");
+    UVM_SEQ_OR_DBG_PRINT(s, "  timestamp_ns         batch  batches/service  ns/fault  dup%%  full%%  policy\n");
+
+    i = num_decisions > UVM_FAULT_BATCH_CONTROL_HISTORY_SIZE ? num_decisions - UVM_FAULT_BATCH_CONTROL_HISTORY_SIZE : 0;
+    for (; i < num_decisions; i++) {
+        uvm_fault_batch_control_decision_t *decision = &batch_control->history[i % UVM_FAULT_BATCH_CONTROL_HISTORY_SIZE];
+
+        UVM_SEQ_OR_DBG_PRINT(s, "  %-20llu %-6u %-16u %-9u %-5u %-6u %s\n",
+                             decision->timestamp,
+                             decision->batch_size,
+                             decision->max_batches_per_service,
+                             decision->ns_per_fault,
+                             decision->duplicate_percentage,
+                             decision->full_batch_percentage,
+                             uvm_perf_fault_replay_policy_string(decision->replay_policy));
+    }
+}
+
 static void gpu_access_counters_print_common(uvm_parent_gpu_t *parent_gpu, struct seq_file *s)
 {
     NvU64 num_pages_in;
@@ -951,6 +1011,25 @@ static int nv_procfs_read_gpu_info_entry(struct seq_file *s, void *v)
     UVM_ENTRY_RET(nv_procfs_read_gpu_info(s, v));
 }
 
+static int nv_procfs_read_gpu_pmm_eviction(struct seq_file *s, void *v)
+{
+    uvm_gpu_t *gpu = (uvm_gpu_t *)s->private;
+
+    if (!uvm_down_read_trylock(&g_uvm_global.pm.lock))
+        return -EAGAIN;
+
+    uvm_pmm_gpu_print_eviction_stats(&gpu->pmm, s);
+
+    uvm_up_read(&g_uvm_global.pm.lock);
+
+    return 0;
+}
+
+static int nv_procfs_read_gpu_pmm_eviction_entry(struct seq_file *s, void *v)
+{
+    UVM_ENTRY_RET(nv_procfs_read_gpu_pmm_eviction(s, v));
+}
+
 static int nv_procfs_read_gpu_fault_stats(struct seq_file *s, void *v)
 {
     uvm_parent_gpu_t *parent_gpu = (uvm_parent_gpu_t *)s->private;
@@ -970,6 +1049,25 @@ static int nv_procfs_read_gpu_fault_stats_entry(struct seq_file *s, void *v)
     UVM_ENTRY_RET(nv_procfs_read_gpu_fault_stats(s, v));
 }
 
+static int nv_procfs_read_gpu_fault_batch_control(struct seq_file *s, void *v)
+{
+    uvm_parent_gpu_t *parent_gpu = (uvm_parent_gpu_t *)s->private;
+
+    if (!uvm_down_read_trylock(&g_uvm_global.pm.lock))
+        return -EAGAIN;
+
+    gpu_fault_batch_control_print_common(parent_gpu, s);
+
+    uvm_up_read(&g_uvm_global.pm.lock);
+
+    return 0;
+}
+
+static int nv_procfs_read_gpu_fault_batch_control_entry(struct seq_file *s, void *v)
+{
+    UVM_ENTRY_RET(nv_procfs_read_gpu_fault_batch_control(s, v));
+}
+
 static int nv_procfs_read_gpu_access_counters(struct seq_file *s, void *v)
 {
     uvm_parent_gpu_t *parent_gpu = (uvm_parent_gpu_t *)s->private;
@@ -989,9 +1087,31 @@ static int nv_procfs_read_gpu_access_counters_entry(struct seq_file *s, void *v)
     UVM_ENTRY_RET(nv_procfs_read_gpu_access_counters(s, v));
 }
 
+static int nv_procfs_read_gpu_access_counters_hotness(struct seq_file *s, void *v)
+{
+    uvm_parent_gpu_t *parent_gpu = (uvm_parent_gpu_t *)s->private;
+
+    if (!uvm_down_read_trylock(&g_uvm_global.pm.lock))
+        return -EAGAIN;
+
+    uvm_parent_gpu_access_counters_print_hotness(parent_gpu, s);
+
+    uvm_up_read(&g_uvm_global.pm.lock);
+
+    return 0;
+}
+
+static int nv_procfs_read_gpu_access_counters_hotness_entry(struct seq_file *s, void *v)
+{
+    UVM_ENTRY_RET(nv_procfs_read_gpu_access_counters_hotness(s, v));
+}
+
 UVM_DEFINE_SINGLE_PROCFS_FILE(gpu_info_entry);
+UVM_DEFINE_SINGLE_PROCFS_FILE(gpu_pmm_eviction_entry);
 UVM_DEFINE_SINGLE_PROCFS_FILE(gpu_fault_stats_entry);
+UVM_DEFINE_SINGLE_PROCFS_FILE(gpu_fault_batch_control_entry);
 UVM_DEFINE_SINGLE_PROCFS_FILE(gpu_access_counters_entry);
+UVM_DEFINE_SINGLE_PROCFS_FILE(gpu_access_counters_hotness_entry);
 
 static void uvm_parent_gpu_uuid_string(char *buffer, const NvProcessorUuid *uuid)
 {
@@ -1052,6 +1172,13 @@ static NV_STATUS init_parent_procfs_files(uvm_parent_gpu_t *parent_gpu)
     if (parent_gpu->procfs.fault_stats_file == NULL)
         return NV_ERR_OPERATING_SYSTEM;
 
+    parent_gpu->procfs.fault_batch_control_file = NV_CREATE_PROC_FILE("fault_batch_control",
+                                                                      parent_gpu->procfs.dir,
+                                                                      gpu_fault_batch_control_entry,
+                                                                      parent_gpu);
+    if (parent_gpu->procfs.fault_batch_control_file == NULL)
+        return NV_ERR_OPERATING_SYSTEM;
+
     parent_gpu->procfs.access_counters_file = NV_CREATE_PROC_FILE("access_counters",
                                                                   parent_gpu->procfs.dir,
                                                                   gpu_access_counters_entry,
@@ -1059,12 +1186,21 @@ static NV_STATUS init_parent_procfs_files(uvm_parent_gpu_t *parent_gpu)
     if (parent_gpu->procfs.access_counters_file == NULL)
         return NV_ERR_OPERATING_SYSTEM;
 
+    parent_gpu->procfs.access_counters_hotness_file = NV_CREATE_PROC_FILE("access_counters_hotness",
+                                                                          parent_gpu->procfs.dir,
+                                                                          gpu_access_counters_hotness_entry,
+                                                                          parent_gpu);
+    if (parent_gpu->procfs.access_counters_hotness_file == NULL)
+        return NV_ERR_OPERATING_SYSTEM;
+
     return NV_OK;
 }
 
 static void deinit_parent_procfs_files(uvm_parent_gpu_t *parent_gpu)
 {
+    proc_remove(parent_gpu->procfs.access_counters_hotness_file);
     proc_remove(parent_gpu->procfs.access_counters_file);
+    proc_remove(parent_gpu->procfs.fault_batch_control_file);
     proc_remove(parent_gpu->procfs.fault_stats_file);
 }
 
@@ -1127,11 +1263,23 @@ static NV_STATUS init_procfs_files(uvm_gpu_t *gpu)
     if (gpu->procfs.info_file == NULL)
         return NV_ERR_OPERATING_SYSTEM;
 
+    // PMM eviction file is debug only
+    if (!uvm_procfs_is_debug_enabled())
+        return NV_OK;
+
+    gpu->procfs.pmm_eviction_file = NV_CREATE_PROC_FILE("pmm_eviction",
+                                                        gpu->procfs.dir,
+                                                        gpu_pmm_eviction_entry,
+                                                        gpu);
+    if (gpu->procfs.pmm_eviction_file == NULL)
+        return NV_ERR_OPERATING_SYSTEM;
+
     return NV_OK;
 }
 
 static void deinit_procfs_files(uvm_gpu_t *gpu)
 {
+    proc_remove(gpu->procfs.pmm_eviction_file);
     proc_remove(gpu->procfs.info_file);
 }
 
@@ -1838,8 +1986,10 @@ static void deinit_gpu(uvm_gpu_t *gpu)
     // correct spot
     uvm_mmu_destroy_flat_mappings(gpu);
 
-    // Wait for any deferred frees and their associated trackers to be finished
-    // before tearing down channels.
+    // Stop any background PMM work pushing to the channels, then wait for any
+    // deferred frees and their associated trackers to be finished before
+    // tearing down channels.
+    uvm_pmm_gpu_stop_background_work(&gpu->pmm);
     uvm_pmm_gpu_sync(&gpu->pmm);
 
     uvm_channel_manager_destroy(gpu->channel_manager);
@@ -1928,25 +2078,25 @@ static void update_stats_parent_gpu_fault_instance(uvm_parent_gpu_t *parent_gpu,
     switch (fault_entry->fault_access_type)
     {
         case UVM_FAULT_ACCESS_TYPE_PREFETCH:
-            ++parent_gpu->fault_buffer.replayable.stats.num_prefetch_faults;
+            atomic64_inc(&parent_gpu->fault_buffer.replayable.stats.num_prefetch_faults);
             break;
         case UVM_FAULT_ACCESS_TYPE_READ:
-            ++parent_gpu->fault_buffer.replayable.stats.num_read_faults;
+            atomic64_inc(&parent_gpu->fault_buffer.replayable.stats.num_read_faults);
             break;
         case UVM_FAULT_ACCESS_TYPE_WRITE:
-            ++parent_gpu->fault_buffer.replayable.stats.num_write_faults;
+            atomic64_inc(&parent_gpu->fault_buffer.replayable.stats.num_write_faults);
             break;
         case UVM_FAULT_ACCESS_TYPE_ATOMIC_WEAK:
         case UVM_FAULT_ACCESS_TYPE_ATOMIC_STRONG:
-            ++parent_gpu->fault_buffer.replayable.stats.num_atomic_faults;
+            atomic64_inc(&parent_gpu->fault_buffer.replayable.stats.num_atomic_faults);
             break;
         default:
             break;
     }
     if (is_duplicate || fault_entry->filtered)
-        ++parent_gpu->fault_buffer.replayable.stats.num_duplicate_faults;
+        atomic64_inc(&parent_gpu->fault_buffer.replayable.stats.num_duplicate_faults);
 
-    ++parent_gpu->stats.num_replayable_faults;
+    atomic64_inc(&parent_gpu->stats.num_replayable_faults);
 }
 
 static void update_stats_fault_cb(uvm_va_space_t *va_space,
@@ -45,6 +45,7 @@
 #include "uvm_va_block_types.h"
 #include "uvm_perf_module.h"
 #include "uvm_rb_tree.h"
+#include "uvm_sort.h"
 #include "uvm_perf_prefetch.h"
 #include "nv-kthread-q.h"
 #include <linux/mmu_notifier.h>
@@ -297,6 +298,10 @@ struct uvm_fault_service_batch_context_struct
     // max_batch_size
     uvm_fault_buffer_entry_t **ordered_fault_cache;
 
+    // Packed keys used to sort ordered_fault_cache. The arrays have as many
+    // elements as fault_cache
+    uvm_sort_key_context_t sort_context;
+
     // Per uTLB fault information. Used for replay policies and fault
     // cancellation on Pascal
     uvm_fault_utlb_info_t *utlbs;
@@ -339,6 +344,15 @@ struct uvm_fault_service_batch_context_struct
 
     // Last fetched fault. Used for fault filtering.
     uvm_fault_buffer_entry_t *last_fault;
+
+    // Structure used to coalesce fault servicing in a VA block. Points to the
+    // replayable fault buffer's block_service_context, or to the private
+    // context of a parallel service worker.
+    uvm_service_block_context_t *block_service_context;
+
+    // Information required to invalidate stale ATS PTEs from the GPU TLBs.
+    // Same ownership as block_service_context.
+    uvm_ats_fault_invalidate_t *ats_invalidate;
 };
 
 struct uvm_ats_fault_invalidate_struct
@@ -347,6 +361,117 @@ struct uvm_ats_fault_invalidate_struct
     uvm_tlb_batch_t tlb_batch;
 };
 
+// State of a replayable fault service worker. When parallel fault servicing is
+// enabled, the sorted fault batch is split into partitions that never share a
+// VA block, and each partition is serviced by a different worker. Worker 0
+// runs in the bottom half thread, the rest run in their own kthread queue.
+typedef struct
+{
+    uvm_parent_gpu_t *parent_gpu;
+
+    // Queue and queue item used to run the worker. Unused for worker 0.
+    nv_kthread_q_t q;
+
+    nv_kthread_q_item_t q_item;
+
+    // Signaled by the worker when its partition has been serviced
+    struct completion done;
+
+    // Private batch context. It shares the fault_cache and ordered_fault_cache
+    // arrays with the parent batch context, but has its own counters, tracker
+    // and block service context. utlbs is always NULL: the uTLB state is
+    // updated by the bottom half when the workers are joined.
+    uvm_fault_service_batch_context_t batch_context;
+
+    uvm_service_block_context_t *block_service_context;
+
+    uvm_ats_fault_invalidate_t ats_invalidate;
+
+    // Index of the first fault in ordered_fault_cache that belongs to the
+    // partition. The partition ends at batch_context.num_coalesced_faults.
+    NvU32 first_fault_index;
+
+    NV_STATUS status;
+} uvm_fault_service_worker_t;
+
+#define UVM_FAULT_BATCH_CONTROL_HISTORY_SIZE 32
+
+// Snapshot of the adaptive batch control state taken at the end of a window
+typedef struct
+{
+    NvU64 timestamp;
+
+    NvU32 batch_size;
+
+    NvU32 max_batches_per_service;
+
+    uvm_perf_fault_replay_policy_t replay_policy;
+
+    // Average cost of servicing a fault in the window, including fetch and
+    // replay time
+    NvU32 ns_per_fault;
+
+    NvU32 duplicate_percentage;
+
+    NvU32 full_batch_percentage;
+} uvm_fault_batch_control_decision_t;
+
+// Adaptive replayable fault batch control. When enabled, the bottom half
+// measures the time spent fetching, servicing and replaying each batch, and
+// adjusts the batch size, the replay policy and the number of batches per
+// service at the end of each window of batches.
+typedef struct
+{
+    bool enabled;
+
+    // Range in which the batch size is adjusted. max_batch_size is the value
+    // of uvm_perf_fault_batch_count.
+    NvU32 min_batch_size;
+
+    NvU32 max_batch_size;
+
+    // The replay policy is only adjusted if the configured policy is BATCH or
+    // BATCH_FLUSH
+    bool adjust_replay_policy;
+
+    // Maximum number of batches serviced per execution of the bottom half
+    NvU32 max_batches_per_service;
+
+    // Direction in which the batch size is currently being moved
+    bool growing;
+
+    // Cost per fault in the previous window, 0 if unknown
+    NvU32 prev_ns_per_fault;
+
+    // Last cost per fault measured under BATCH and BATCH_FLUSH, 0 if unknown.
+    // The cost of the policy not in use decays, so it is eventually retried.
+    NvU32 policy_ns_per_fault[2];
+
+    // Accumulators for the current window
+    struct
+    {
+        NvU32 num_batches;
+
+        NvU32 num_full_batches;
+
+        NvU64 num_faults;
+
+        NvU64 num_duplicate_faults;
+
+        NvU64 fetch_ns;
+
+        NvU64 service_ns;
+
+        NvU64 replay_ns;
+    } window;
+
+    // Ring of the last decisions. The newest entry is at
+    // (num_decisions - 1) % UVM_FAULT_BATCH_CONTROL_HISTORY_SIZE.
+    NvU64 num_decisions;
+
+    uvm_fault_batch_control_decision_t history[UVM_FAULT_BATCH_CONTROL_HISTORY_SIZE];
+} uvm_fault_batch_control_t;
+
 typedef struct
 {
     // Fault buffer information and structures provided by RM
@@ -382,21 +507,22 @@ typedef struct
         // that comes before the replay method.
         NvU32 replay_update_put_ratio;
 
-        // Fault statistics. These fields are per-GPU and most of them are only
-        // updated during fault servicing, and can be safely incremented.
-        // Migrations may be triggered by different GPUs and need to be
-        // incremented using atomics
+        // Fault statistics. These fields are per-GPU. Fault counters may be
+        // updated concurrently by the parallel fault service workers, and
+        // migrations may be triggered by different GPUs, so they need to be
+        // incremented using atomics. Replay counters are only updated by the
+        // bottom half and can be safely incremented.
         struct
         {
-            NvU64 num_prefetch_faults;
+            atomic64_t num_prefetch_faults;
 
-            NvU64 num_read_faults;
+            atomic64_t num_read_faults;
 
-            NvU64 num_write_faults;
+            atomic64_t num_write_faults;
 
-            NvU64 num_atomic_faults;
+            atomic64_t num_atomic_faults;
 
-            NvU64 num_duplicate_faults;
+            atomic64_t num_duplicate_faults;
 
             atomic64_t num_pages_out;
 
@@ -418,6 +544,35 @@ typedef struct
 
         // Information required to invalidate stale ATS PTEs from the GPU TLBs
         uvm_ats_fault_invalidate_t ats_invalidate;
+
+        // Parallel fault servicing. num_workers is 1 when faults are serviced
+        // serially by the bottom half.
+        struct
+        {
+            NvU32 num_workers;
+
+            // Array of num_workers elements
+            uvm_fault_service_worker_t *workers;
+
+            NvU64 num_parallel_batches;
+        } parallel;
+
+        // Batch pipelining. When enabled, the next batch is fetched and
+        // preprocessed into a second batch context while the work pushed to
+        // service the current batch is in flight. The bottom half alternates
+        // between both batch contexts.
+        struct
+        {
+            bool enabled;
+
+            uvm_fault_service_batch_context_t batch_service_context;
+
+            NvU64 num_pipelined_batches;
+        } pipeline;
+
+        // Adaptive batch size and replay policy. Only accessed by the bottom
+        // half, except for the debug procfs file.
+        uvm_fault_batch_control_t batch_control;
     } replayable;
 
     struct uvm_non_replayable_fault_buffer_struct
@@ -494,6 +649,9 @@ struct uvm_access_counter_service_batch_context_struct
 
     NvU32 num_notifications;
 
+    // Packed keys used to sort notifications
+    uvm_sort_key_context_t sort_context;
+
     // Boolean used to avoid sorting the fault batch by instance_ptr if we
     // determine at fetch time that all the access counter notifications in
     // the batch report the same instance_ptr
@@ -919,6 +1077,9 @@ struct uvm_gpu_struct
 
         // "gpus/UVM-GPU-${physical-UUID}/${sub_processor_index}/info"
         struct proc_dir_entry *info_file;
+
+        // "gpus/UVM-GPU-${physical-UUID}/${sub_processor_index}/pmm_eviction"
+        struct proc_dir_entry *pmm_eviction_file;
     } procfs;
 
     // Placeholder for per-GPU performance heuristics information
@@ -1174,6 +1335,12 @@ struct uvm_parent_gpu_struct
         // "gpus/UVM-GPU-${physical-UUID}/access_counters"
         struct proc_dir_entry *access_counters_file;
 
+        // "gpus/UVM-GPU-${physical-UUID}/fault_batch_control"
+        struct proc_dir_entry *fault_batch_control_file;
+
+        // "gpus/UVM-GPU-${physical-UUID}/access_counters_hotness"
+        struct proc_dir_entry *access_counters_hotness_file;
+
         // "gpus/UVM-GPU-${physical-UUID}/peers/"
         struct proc_dir_entry *dir_peers;
     } procfs;
@@ -1263,15 +1430,30 @@ struct uvm_parent_gpu_struct
 
     // Global statistics. These fields are per-GPU and most of them are only
     // updated during fault servicing, and can be safely incremented.
+    // Replayable faults may be serviced by parallel workers, so their counter
+    // is atomic.
     struct
     {
-        NvU64          num_replayable_faults;
+        atomic64_t     num_replayable_faults;
 
         NvU64      num_non_replayable_faults;
 
         atomic64_t             num_pages_out;
 
         atomic64_t              num_pages_in;
+
+        // PTE batches (see uvm_pte_batch.h) pushed to the GPU, bytes of PTEs
+        // they wrote, and how many of those bytes were pushed as inline data.
+        // The rest were written with memsets. PTE batches are ended from many
+        // paths concurrently, so the counters are atomic.
+        struct
+        {
+            atomic64_t           num_batches;
+
+            atomic64_t         bytes_written;
+
+            atomic64_t          bytes_inline;
+        } pte_batch;
     } stats;
 
     // Structure to hold nvswitch specific information. In an nvswitch
@@ -55,6 +55,91 @@
 #define UVM_MAX_TRANSLATION_SIZE (2 * 1024 * 1024ULL)
 #define UVM_SUB_GRANULARITY_REGIONS 32
 
+#define UVM_PERF_ACCESS_COUNTER_HOTNESS_PERIOD_MS_DEFAULT       20
+#define UVM_PERF_ACCESS_COUNTER_HOTNESS_DECAY_MS_DEFAULT        100
+#define UVM_PERF_ACCESS_COUNTER_HOTNESS_TOP_N_DEFAULT           16
+#define UVM_PERF_ACCESS_COUNTER_HOTNESS_TOP_N_MAX               128
+#define UVM_PERF_ACCESS_COUNTER_HOTNESS_MIN_NOTIFICATIONS_DEFAULT 1
+
+// The hotness table is set-associative and indexed by VA block start address.
+// Each entry tracks the decayed notification score of a (VA block, accessing
+// GPU) pair.
+#define UVM_ACCESS_COUNTER_HOTNESS_SETS_SHIFT 8
+#define UVM_ACCESS_COUNTER_HOTNESS_SETS       (1 << UVM_ACCESS_COUNTER_HOTNESS_SETS_SHIFT)
+#define UVM_ACCESS_COUNTER_HOTNESS_WAYS       4
+#define UVM_ACCESS_COUNTER_HOTNESS_ENTRIES    (UVM_ACCESS_COUNTER_HOTNESS_SETS * UVM_ACCESS_COUNTER_HOTNESS_WAYS)
+
+// Scores are stored in fixed point so that the halving applied on every decay
+// epoch does not immediately drop blocks with a single notification.
+#define UVM_ACCESS_COUNTER_HOTNESS_SCORE_SHIFT 4
+
+// Number of log2 buckets in the score histogram and number of hottest blocks
+// exported through procfs
+#define UVM_ACCESS_COUNTER_HOTNESS_HISTOGRAM_BUCKETS 16
+#define UVM_ACCESS_COUNTER_HOTNESS_PRINT_TOP         8
+
+typedef struct
+{
+    // Start address of the tracked VA block
+    NvU64 va_block_start;
+
+    // Score in UVM_ACCESS_COUNTER_HOTNESS_SCORE_SHIFT fixed point, as of the
+    // decay epoch below. A score of 0 means that the entry is free.
+    NvU64 score;
+
+    NvU64 epoch;
+
+    // GPU whose notifications contributed to the score
+    uvm_gpu_id_t gpu_id;
+
+    // Index of the notification buffer of the most recent notification
+    NvU32 buffer_index;
+} access_counter_hotness_entry_t;
+
+// Per-VA space hotness tracker. When enabled, notifications on managed VA
+// blocks are accumulated here instead of triggering migrations, and a
+// background worker periodically migrates the hottest blocks to the GPU that
+// accesses them.
+typedef struct
+{
+    // Protects entries and stats
+    uvm_spinlock_t lock;
+
+    access_counter_hotness_entry_t *entries;
+
+    // Reference time for the decay epochs
+    NvU64 start_time_ns;
+
+    struct delayed_work dwork;
+
+    // Whether uvm_perf_access_counters_stop has been called. Protected by the
+    // VA space lock.
+    bool in_va_space_teardown;
+
+    // The fields below are only used by the worker, which never runs
+    // concurrently with itself.
+    access_counter_hotness_entry_t *selected[UVM_PERF_ACCESS_COUNTER_HOTNESS_TOP_N_MAX];
+
+    access_counter_hotness_entry_t hot[UVM_PERF_ACCESS_COUNTER_HOTNESS_TOP_N_MAX];
+
+    uvm_service_block_context_t *service_context;
+
+    uvm_page_mask_t accessed_pages;
+
+    uvm_va_space_t *va_space;
+
+    struct
+    {
+        NvU64 num_notifications;
+
+        NvU64 num_evictions;
+
+        NvU64 num_worker_runs;
+
+        NvU64 num_blocks_migrated;
+    } stats;
+} access_counter_hotness_t;
+
 // Per-VA space access counters information
 typedef struct
 {
@@ -62,6 +147,9 @@ typedef struct
     // settings
     atomic_t enable_migrations;
 
+    // NULL unless uvm_perf_access_counter_hotness is set
+    access_counter_hotness_t *hotness;
+
     uvm_va_space_t *va_space;
 } va_space_access_counters_info_t;
 
@@ -86,6 +174,33 @@ MODULE_PARM_DESC(uvm_perf_access_counter_threshold,
                  "Number of remote accesses on a region required to trigger a notification."
                  "Valid values: [1, 65535]");
 
+// Hotness tracking tunables. See module param documentation below.
+static unsigned uvm_perf_access_counter_hotness = 0;
+static unsigned uvm_perf_access_counter_hotness_period_ms = UVM_PERF_ACCESS_COUNTER_HOTNESS_PERIOD_MS_DEFAULT;
+static unsigned uvm_perf_access_counter_hotness_decay_ms = UVM_PERF_ACCESS_COUNTER_HOTNESS_DECAY_MS_DEFAULT;
+static unsigned uvm_perf_access_counter_hotness_top_n = UVM_PERF_ACCESS_COUNTER_HOTNESS_TOP_N_DEFAULT;
+static unsigned uvm_perf_access_counter_hotness_min_notifications =
+    UVM_PERF_ACCESS_COUNTER_HOTNESS_MIN_NOTIFICATIONS_DEFAULT;
+
+module_param(uvm_perf_access_counter_hotness, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_perf_access_counter_hotness,
+                 "Accumulate access counter notifications on managed memory into per-VA space "
+                 "hotness histograms and migrate the hottest VA blocks from a background worker "
+                 "instead of on every notification.");
+module_param(uvm_perf_access_counter_hotness_period_ms, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_perf_access_counter_hotness_period_ms,
+                 "Period in milliseconds of the hotness migration worker.");
+module_param(uvm_perf_access_counter_hotness_decay_ms, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_perf_access_counter_hotness_decay_ms,
+                 "Time in milliseconds after which hotness scores are halved.");
+module_param(uvm_perf_access_counter_hotness_top_n, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_perf_access_counter_hotness_top_n,
+                 "Maximum number of VA blocks migrated per hotness worker run. "
+                 "Valid values: [1, 128]");
+module_param(uvm_perf_access_counter_hotness_min_notifications, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_perf_access_counter_hotness_min_notifications,
+                 "Decayed number of notifications required for a VA block to be migrated.");
+
 static void access_counter_buffer_flush_locked(uvm_access_counter_buffer_t *access_counters,
                                                uvm_gpu_buffer_flush_mode_t flush_mode);
 
@@ -156,6 +271,45 @@ static bool is_migration_enabled(void)
     return false;
 }
 
+static void hotness_migrate_entry(struct work_struct *work);
+
+static access_counter_hotness_t *hotness_create(uvm_va_space_t *va_space)
+{
+    access_counter_hotness_t *hotness = uvm_kvmalloc_zero(sizeof(*hotness));
+    if (!hotness)
+        return NULL;
+
+    hotness->entries = uvm_kvmalloc_zero(sizeof(*hotness->entries) * UVM_ACCESS_COUNTER_HOTNESS_ENTRIES);
+    if (!hotness->entries)
+        goto error;
+
+    hotness->service_context = uvm_service_block_context_alloc(NULL);
+    if (!hotness->service_context)
+        goto error;
+
+    uvm_spin_lock_init(&hotness->lock, UVM_LOCK_ORDER_LEAF);
+    INIT_DELAYED_WORK(&hotness->dwork, hotness_migrate_entry);
+    hotness->start_time_ns = NV_GETTIME();
+    hotness->va_space = va_space;
+
+    return hotness;
+
+error:
+    uvm_kvfree(hotness->entries);
+    uvm_kvfree(hotness);
+    return NULL;
+}
+
+static void hotness_destroy(access_counter_hotness_t *hotness)
+{
+    if (!hotness)
+        return;
+
+    uvm_service_block_context_free(hotness->service_context);
+    uvm_kvfree(hotness->entries);
+    uvm_kvfree(hotness);
+}
+
 // Create the access counters tracking struct for the given VA space
 //
 // VA space lock needs to be held in write mode
@@ -167,6 +321,14 @@ static va_space_access_counters_info_t *va_space_access_counters_info_create(uvm
     UVM_ASSERT(va_space_access_counters_info_get_or_null(va_space) == NULL);
 
     va_space_access_counters = uvm_kvmalloc_zero(sizeof(*va_space_access_counters));
+    if (va_space_access_counters && uvm_perf_access_counter_hotness) {
+        va_space_access_counters->hotness = hotness_create(va_space);
+        if (!va_space_access_counters->hotness) {
+            uvm_kvfree(va_space_access_counters);
+            va_space_access_counters = NULL;
+        }
+    }
+
     if (va_space_access_counters) {
         uvm_perf_module_type_set_data(va_space->perf_modules_data,
                                       va_space_access_counters,
@@ -191,6 +353,7 @@ static void va_space_access_counters_info_destroy(uvm_va_space_t *va_space)
 
     if (va_space_access_counters) {
         uvm_perf_module_type_unset_data(va_space->perf_modules_data, UVM_PERF_MODULE_TYPE_ACCESS_COUNTERS);
+        hotness_destroy(va_space_access_counters->hotness);
         uvm_kvfree(va_space_access_counters);
     }
 }
@@ -464,8 +627,9 @@ NV_STATUS uvm_parent_gpu_init_access_counters(uvm_parent_gpu_t *parent_gpu, NvU3
         goto fail;
     }
 
-    batch_context->notification_cache = uvm_kvmalloc_zero(access_counters->max_notifications *
-                                                          sizeof(*batch_context->notification_cache));
+    batch_context->notification_cache = uvm_kvmalloc_zero_node(access_counters->max_notifications *
+                                                               sizeof(*batch_context->notification_cache),
+                                                               uvm_parent_gpu_isr_numa_node(parent_gpu));
     if (!batch_context->notification_cache) {
         status = NV_ERR_NO_MEMORY;
         goto fail;
@@ -476,13 +640,20 @@ NV_STATUS uvm_parent_gpu_init_access_counters(uvm_parent_gpu_t *parent_gpu, NvU3
         goto fail;
     }
 
-    batch_context->notifications = uvm_kvmalloc_zero(access_counters->max_notifications *
-                                                     sizeof(*batch_context->notifications));
+    batch_context->notifications = uvm_kvmalloc_zero_node(access_counters->max_notifications *
+                                                          sizeof(*batch_context->notifications),
+                                                          uvm_parent_gpu_isr_numa_node(parent_gpu));
     if (!batch_context->notifications) {
         status = NV_ERR_NO_MEMORY;
         goto fail;
     }
 
+    status = uvm_sort_key_context_init(&batch_context->sort_context,
+                                       access_counters->max_notifications,
+                                       uvm_parent_gpu_isr_numa_node(parent_gpu));
+    if (status != NV_OK)
+        goto fail;
+
     return NV_OK;
 
 fail:
@@ -514,6 +685,7 @@ void uvm_parent_gpu_deinit_access_counters(uvm_parent_gpu_t *parent_gpu, NvU32 n
         access_counters->rm_info.accessCntrBufferHandle = 0;
         uvm_kvfree(batch_context->notification_cache);
         uvm_kvfree(batch_context->notifications);
+        uvm_sort_key_context_deinit(&batch_context->sort_context);
         batch_context->notification_cache = NULL;
         batch_context->notifications = NULL;
     }
@@ -894,6 +1066,72 @@ static int cmp_sort_notifications_by_va_space_gpu_address(const void *_a, const
     return UVM_CMP_DEFAULT((*a)->address, (*b)->address);
 }
 
+// Sort notifications by instance pointer and ve_id using packed keys. Returns
+// false if the keys could not be packed, in which case the array is left
+// untouched.
+static bool sort_notifications_by_instance_ptr_keys(uvm_access_counter_service_batch_context_t *batch_context)
+{
+    uvm_sort_key_context_t *sort_context = &batch_context->sort_context;
+    uvm_sort_key_entry_t *entries = sort_context->entries;
+    NvU32 i;
+
+    for (i = 0; i < batch_context->num_notifications; ++i) {
+        uvm_access_counter_buffer_entry_t *current_entry = batch_context->notifications[i];
+
+        if (!uvm_sort_key_instance_ptr(current_entry->instance_ptr, current_entry->ve_id, &entries[i].key))
+            return false;
+
+        entries[i].ptr = current_entry;
+    }
+
+    uvm_sort_key_entries(sort_context, batch_context->num_notifications);
+
+    for (i = 0; i < batch_context->num_notifications; ++i)
+        batch_context->notifications[i] = entries[i].ptr;
+
+    return true;
+}
+
+// Sort notifications by va_space, GPU ID, and notification address using
+// packed keys, which yields the same order as
+// cmp_sort_notifications_by_va_space_gpu_address. Returns false if the keys
+// could not be packed, in which case the array is left untouched.
+static bool sort_notifications_by_va_space_gpu_address_keys(uvm_access_counter_service_batch_context_t *batch_context)
+{
+    uvm_sort_key_context_t *sort_context = &batch_context->sort_context;
+    uvm_sort_key_entry_t *entries = sort_context->entries;
+    NvU32 i;
+
+    uvm_sort_key_begin(sort_context, 0);
+
+    for (i = 0; i < batch_context->num_notifications; ++i) {
+        uvm_access_counter_buffer_entry_t *current_entry = batch_context->notifications[i];
+
+        uvm_sort_key_add(sort_context, current_entry->va_space, current_entry->gpu, current_entry->address);
+    }
+
+    if (!uvm_sort_key_finalize(sort_context))
+        return false;
+
+    for (i = 0; i < batch_context->num_notifications; ++i) {
+        uvm_access_counter_buffer_entry_t *current_entry = batch_context->notifications[i];
+
+        entries[i].key = uvm_sort_key_pack(sort_context,
+                                           current_entry->va_space,
+                                           current_entry->gpu,
+                                           current_entry->address,
+                                           0);
+        entries[i].ptr = current_entry;
+    }
+
+    uvm_sort_key_entries(sort_context, batch_context->num_notifications);
+
+    for (i = 0; i < batch_context->num_notifications; ++i)
+        batch_context->notifications[i] = entries[i].ptr;
+
+    return true;
+}
+
 typedef enum
 {
     // Fetch a batch of notifications from the buffer. Stop at the first entry
@@ -1020,7 +1258,7 @@ static void translate_notifications_instance_ptrs(uvm_parent_gpu_t *parent_gpu,
 static void preprocess_notifications(uvm_parent_gpu_t *parent_gpu,
                                      uvm_access_counter_service_batch_context_t *batch_context)
 {
-    if (!batch_context->is_single_instance_ptr) {
+    if (!batch_context->is_single_instance_ptr && !sort_notifications_by_instance_ptr_keys(batch_context)) {
         sort(batch_context->notifications,
              batch_context->num_notifications,
              sizeof(*batch_context->notifications),
@@ -1030,11 +1268,13 @@ static void preprocess_notifications(uvm_parent_gpu_t *parent_gpu,
 
     translate_notifications_instance_ptrs(parent_gpu, batch_context);
 
-    sort(batch_context->notifications,
-         batch_context->num_notifications,
-         sizeof(*batch_context->notifications),
-         cmp_sort_notifications_by_va_space_gpu_address,
-         NULL);
+    if (!sort_notifications_by_va_space_gpu_address_keys(batch_context)) {
+        sort(batch_context->notifications,
+             batch_context->num_notifications,
+             sizeof(*batch_context->notifications),
+             cmp_sort_notifications_by_va_space_gpu_address,
+             NULL);
+    }
 }
 
 static NV_STATUS notify_tools_broadcast_and_process_flags(uvm_access_counter_buffer_t *access_counters,
@@ -1189,7 +1429,11 @@ static NV_STATUS service_va_block_locked(uvm_processor_id_t processor,
         if (!iter.migratable)
             continue;
 
-        thrashing_hint = uvm_perf_thrashing_get_hint(va_block, service_context->block_context, address, processor);
+        thrashing_hint = uvm_perf_thrashing_get_hint(va_block,
+                                                     service_context->block_context,
+                                                     address,
+                                                     processor,
+                                                     uvm_fault_access_type_mask_bit(UVM_FAULT_ACCESS_TYPE_PREFETCH));
         if (thrashing_hint.type == UVM_PERF_THRASHING_HINT_TYPE_THROTTLE) {
             // If the page is throttling, ignore the access counter
             // notification
@@ -1399,6 +1643,260 @@ static void expand_notification_block(uvm_gpu_va_space_t *gpu_va_space,
     }
 }
 
+// Return the hotness tracker of the VA space if notifications on managed VA
+// blocks are to be accumulated instead of serviced right away.
+static access_counter_hotness_t *va_space_hotness_get_or_null(uvm_va_space_t *va_space)
+{
+    va_space_access_counters_info_t *va_space_access_counters = va_space_access_counters_info_get(va_space);
+
+    if (!atomic_read(&va_space_access_counters->enable_migrations))
+        return NULL;
+
+    return va_space_access_counters->hotness;
+}
+
+static NvU64 hotness_epoch(const access_counter_hotness_t *hotness)
+{
+    return (NV_GETTIME() - hotness->start_time_ns) / (uvm_perf_access_counter_hotness_decay_ms * 1000ULL * 1000ULL);
+}
+
+// Scores are decayed lazily: they are halved once per epoch elapsed since they
+// were last updated.
+static NvU64 hotness_entry_score(const access_counter_hotness_entry_t *entry, NvU64 epoch)
+{
+    NvU64 elapsed = epoch - entry->epoch;
+
+    if (elapsed >= 64)
+        return 0;
+
+    return entry->score >> elapsed;
+}
+
+static access_counter_hotness_entry_t *hotness_set_get(access_counter_hotness_t *hotness, NvU64 va_block_start)
+{
+    NvU64 hash = (va_block_start >> UVM_VA_BLOCK_BITS) * 0x9e3779b97f4a7c15ULL;
+    NvU32 set = hash >> (64 - UVM_ACCESS_COUNTER_HOTNESS_SETS_SHIFT);
+
+    return hotness->entries + set * UVM_ACCESS_COUNTER_HOTNESS_WAYS;
+}
+
+// Add num_notifications to the score of the (va_block, gpu) pair. If the pair
+// is not tracked yet, the entry with the lowest decayed score in its set is
+// replaced.
+static void hotness_record(access_counter_hotness_t *hotness,
+                           uvm_va_block_t *va_block,
+                           uvm_gpu_t *gpu,
+                           NvU32 buffer_index,
+                           NvU32 num_notifications)
+{
+    access_counter_hotness_entry_t *set;
+    access_counter_hotness_entry_t *victim = NULL;
+    NvU64 victim_score = ~0ULL;
+    NvU64 epoch = hotness_epoch(hotness);
+    bool hit = false;
+    NvU32 way;
+
+    uvm_spin_lock(&hotness->lock);
+
+    set = hotness_set_get(hotness, va_block->start);
+
+    for (way = 0; way < UVM_ACCESS_COUNTER_HOTNESS_WAYS; way++) {
+        access_counter_hotness_entry_t *entry = &set[way];
+        NvU64 score = hotness_entry_score(entry, epoch);
+
+        if (score != 0 && entry->va_block_start == va_block->start && uvm_id_equal(entry->gpu_id, gpu->id)) {
+            victim = entry;
+            victim_score = score;
+            hit = true;
+            break;
+        }
+
+        if (score < victim_score) {
+            victim = entry;
+            victim_score = score;
+        }
+    }
+
+    if (!hit) {
+        if (victim_score != 0)
+            ++hotness->stats.num_evictions;
+
+        victim->va_block_start = va_block->start;
+        victim->gpu_id = gpu->id;
+        victim_score = 0;
+    }
+
+    victim->score = victim_score + ((NvU64)num_notifications << UVM_ACCESS_COUNTER_HOTNESS_SCORE_SHIFT);
+    victim->epoch = epoch;
+    victim->buffer_index = buffer_index;
+
+    hotness->stats.num_notifications += num_notifications;
+
+    uvm_spin_unlock(&hotness->lock);
+}
+
+// Copy up to uvm_perf_access_counter_hotness_top_n entries with the highest
+// decayed scores above the migration threshold to hotness->hot, sorted by
+// descending score, and reset their scores. Returns the number of selected
+// entries.
+static NvU32 hotness_select_hot(access_counter_hotness_t *hotness)
+{
+    access_counter_hotness_entry_t **selected = hotness->selected;
+    NvU64 epoch = hotness_epoch(hotness);
+    NvU64 min_score;
+    NvU32 num_selected = 0;
+    NvU32 i;
+
+    min_score = (NvU64)uvm_perf_access_counter_hotness_min_notifications << UVM_ACCESS_COUNTER_HOTNESS_SCORE_SHIFT;
+
+    uvm_spin_lock(&hotness->lock);
+
+    for (i = 0; i < UVM_ACCESS_COUNTER_HOTNESS_ENTRIES; i++) {
+        access_counter_hotness_entry_t *entry = &hotness->entries[i];
+        NvU64 score = hotness_entry_score(entry, epoch);
+        NvU32 pos;
+
+        if (score == 0 || score < min_score)
+            continue;
+
+        entry->score = score;
+        entry->epoch = epoch;
+
+        if (num_selected == uvm_perf_access_counter_hotness_top_n &&
+            selected[num_selected - 1]->score >= score)
+            continue;
+
+        // Insertion into the sorted selection, dropping the coldest entry if
+        // the selection is full
+        if (num_selected < uvm_perf_access_counter_hotness_top_n)
+            ++num_selected;
+
+        for (pos = num_selected - 1; pos > 0 && selected[pos - 1]->score < score; pos--)
+            selected[pos] = selected[pos - 1];
+
+        selected[pos] = entry;
+    }
+
+    for (i = 0; i < num_selected; i++) {
+        hotness->hot[i] = *selected[i];
+        selected[i]->score = 0;
+    }
+
+    uvm_spin_unlock(&hotness->lock);
+
+    return num_selected;
+}
+
+// Migrate the pages of the VA block of the given entry that are mapped by the
+// GPU but resident elsewhere to the GPU, using the same residency policies as
+// regular access counter servicing.
+static NV_STATUS hotness_migrate_block(access_counter_hotness_t *hotness,
+                                       struct mm_struct *mm,
+                                       const access_counter_hotness_entry_t *hot)
+{
+    NV_STATUS status;
+    uvm_va_block_t *va_block;
+    uvm_va_block_retry_t va_block_retry;
+    uvm_processor_id_t id;
+    uvm_va_space_t *va_space = hotness->va_space;
+    uvm_service_block_context_t *service_context = hotness->service_context;
+    uvm_page_mask_t *accessed_pages = &hotness->accessed_pages;
+
+    uvm_assert_rwsem_locked(&va_space->lock);
+
+    // The GPU VA space may have been destroyed since the notifications were
+    // received
+    if (!uvm_processor_mask_test(&va_space->registered_gpu_va_spaces, hot->gpu_id))
+        return NV_OK;
+
+    // Likewise, the VA range may have been freed
+    status = uvm_va_block_find(va_space, hot->va_block_start, &va_block);
+    if (status != NV_OK)
+        return NV_OK;
+
+    uvm_va_block_context_init(service_context->block_context, mm);
+    service_context->operation = UVM_SERVICE_OPERATION_ACCESS_COUNTERS;
+    service_context->num_retries = 0;
+    service_context->access_counters_buffer_index = hot->buffer_index;
+
+    uvm_mutex_lock(&va_block->lock);
+
+    status = NV_OK;
+
+    // service_va_block_locked skips blocks not mapped by the GPU
+    if (uvm_processor_mask_test(&va_block->mapped, hot->gpu_id)) {
+        uvm_page_mask_zero(accessed_pages);
+
+        for_each_id_in_mask(id, &va_block->resident) {
+            if (!uvm_id_equal(id, hot->gpu_id))
+                uvm_page_mask_or(accessed_pages,
+                                 accessed_pages,
+                                 uvm_va_block_resident_mask_get(va_block, id, NUMA_NO_NODE));
+        }
+
+        if (uvm_page_mask_and(accessed_pages, accessed_pages, uvm_va_block_map_mask_get(va_block, hot->gpu_id))) {
+            status = UVM_VA_BLOCK_RETRY_LOCKED(va_block,
+                                               &va_block_retry,
+                                               service_va_block_locked(hot->gpu_id,
+                                                                       va_block,
+                                                                       &va_block_retry,
+                                                                       service_context,
+                                                                       accessed_pages));
+        }
+    }
+
+    uvm_mutex_unlock(&va_block->lock);
+
+    return status;
+}
+
+static void hotness_migrate(struct work_struct *work)
+{
+    struct delayed_work *dwork = to_delayed_work(work);
+    access_counter_hotness_t *hotness = container_of(dwork, access_counter_hotness_t, dwork);
+    uvm_va_space_t *va_space = hotness->va_space;
+    struct mm_struct *mm;
+    NvU32 num_hot;
+    NvU32 num_migrated = 0;
+    NvU32 i;
+
+    mm = uvm_va_space_mm_retain_lock(va_space);
+    uvm_va_space_down_read(va_space);
+
+    if (hotness->in_va_space_teardown)
+        goto out;
+
+    num_hot = hotness_select_hot(hotness);
+
+    for (i = 0; i < num_hot; i++) {
+        NV_STATUS status = hotness_migrate_block(hotness, mm, &hotness->hot[i]);
+
+        // Migration failures, most likely due to memory pressure on the
+        // destination, are not fatal. The block will be selected again if it
+        // keeps generating notifications.
+        if (status == NV_OK)
+            ++num_migrated;
+    }
+
+    uvm_spin_lock(&hotness->lock);
+    ++hotness->stats.num_worker_runs;
+    hotness->stats.num_blocks_migrated += num_migrated;
+    uvm_spin_unlock(&hotness->lock);
+
+    // The selection was capped, so more blocks may be above the threshold
+    if (num_hot == uvm_perf_access_counter_hotness_top_n)
+        schedule_delayed_work(&hotness->dwork, msecs_to_jiffies(uvm_perf_access_counter_hotness_period_ms));
+
+out:
+    uvm_va_space_up_read(va_space);
+    uvm_va_space_mm_release_unlock(va_space, mm);
+}
+
+static void hotness_migrate_entry(struct work_struct *work)
+{
+    UVM_ENTRY_VOID(hotness_migrate(work));
+}
+
 static NV_STATUS service_notifications_in_block(uvm_gpu_va_space_t *gpu_va_space,
                                                 struct mm_struct *mm,
                                                 uvm_access_counter_buffer_t *access_counters,
@@ -1416,12 +1914,38 @@ static NV_STATUS service_notifications_in_block(uvm_gpu_va_space_t *gpu_va_space
     uvm_page_mask_t *accessed_pages = &batch_context->accessed_pages;
     uvm_access_counter_buffer_entry_t **notifications = batch_context->notifications;
     uvm_service_block_context_t *service_context = &batch_context->block_service_context;
+    access_counter_hotness_t *hotness;
 
     UVM_ASSERT(va_block);
     UVM_ASSERT(index < batch_context->num_notifications);
 
     uvm_assert_rwsem_locked(&va_space->lock);
 
+    hotness = va_space_hotness_get_or_null(va_space);
+    if (hotness) {
+        for (i = index; i < batch_context->num_notifications; i++) {
+            uvm_access_counter_buffer_entry_t *current_entry = notifications[i];
+
+            if (current_entry->va_space != va_space ||
+                current_entry->gpu != gpu ||
+                current_entry->address > va_block->end)
+                break;
+        }
+
+        *out_index = i;
+
+        // Accumulate the notifications and let the worker migrate the block
+        // if it turns out to be among the hottest ones. The notifications are
+        // cleared so that the GPU keeps reporting accesses to the region.
+        hotness_record(hotness, va_block, gpu, access_counters->index, *out_index - index);
+
+        // The flag is protected by the VA space lock, held here in read mode
+        if (!hotness->in_va_space_teardown)
+            schedule_delayed_work(&hotness->dwork, msecs_to_jiffies(uvm_perf_access_counter_hotness_period_ms));
+
+        goto out;
+    }
+
     uvm_page_mask_zero(accessed_pages);
 
     uvm_va_block_context_init(service_context->block_context, mm);
@@ -1454,6 +1978,7 @@ static NV_STATUS service_notifications_in_block(uvm_gpu_va_space_t *gpu_va_space
 
     uvm_mutex_unlock(&va_block->lock);
 
+out:
     if (status == NV_OK)
         flags |= UVM_ACCESS_COUNTER_ACTION_BATCH_CLEAR;
 
@@ -1888,6 +2413,100 @@ bool uvm_va_space_has_access_counter_migrations(uvm_va_space_t *va_space)
     return atomic_read(&va_space_access_counters->enable_migrations);
 }
 
+void uvm_parent_gpu_access_counters_print_hotness(uvm_parent_gpu_t *parent_gpu, struct seq_file *s)
+{
+    uvm_va_space_t *va_space;
+
+    // VA spaces are removed from the list before their perf data is
+    // destroyed, so the list lock keeps the trackers alive.
+    uvm_mutex_lock(&g_uvm_global.va_spaces.lock);
+
+    list_for_each_entry(va_space, &g_uvm_global.va_spaces.list, list_node) {
+        va_space_access_counters_info_t *va_space_access_counters;
+        access_counter_hotness_t *hotness;
+        NvU64 histogram[UVM_ACCESS_COUNTER_HOTNESS_HISTOGRAM_BUCKETS] = {0};
+        access_counter_hotness_entry_t top[UVM_ACCESS_COUNTER_HOTNESS_PRINT_TOP];
+        NvU64 top_scores[UVM_ACCESS_COUNTER_HOTNESS_PRINT_TOP] = {0};
+        NvU64 num_notifications;
+        NvU64 num_evictions;
+        NvU64 num_worker_runs;
+        NvU64 num_blocks_migrated;
+        NvU32 num_live = 0;
+        NvU64 epoch;
+        NvU32 i;
+
+        va_space_access_counters = va_space_access_counters_info_get_or_null(va_space);
+        if (!va_space_access_counters || !va_space_access_counters->hotness)
+            continue;
+
+        hotness = va_space_access_counters->hotness;
+        epoch = hotness_epoch(hotness);
+
+        uvm_spin_lock(&hotness->lock);
+
+        for (i = 0; i < UVM_ACCESS_COUNTER_HOTNESS_ENTRIES; i++) {
+            access_counter_hotness_entry_t *entry = &hotness->entries[i];
+            NvU64 score = hotness_entry_score(entry, epoch);
+            NvU32 bucket;
+            NvU32 pos;
+
+            if (score == 0 || !uvm_parent_id_equal(uvm_parent_gpu_id_from_gpu_id(entry->gpu_id), parent_gpu->id))
+                continue;
+
+            ++num_live;
+
+            // Bucket 0 holds blocks below one decayed notification, bucket i
+            // blocks in [2^(i-1), 2^i) notifications.
+            if ((score >> UVM_ACCESS_COUNTER_HOTNESS_SCORE_SHIFT) == 0)
+                bucket = 0;
+            else
+                bucket = 1 + ilog2(score >> UVM_ACCESS_COUNTER_HOTNESS_SCORE_SHIFT);
+
+            ++histogram[min(bucket, (NvU32)UVM_ACCESS_COUNTER_HOTNESS_HISTOGRAM_BUCKETS - 1)];
+
+            if (score <= top_scores[ARRAY_SIZE(top) - 1])
+                continue;
+
+            for (pos = ARRAY_SIZE(top) - 1; pos > 0 && top_scores[pos - 1] < score; pos--) {
+                top[pos] = top[pos - 1];
+                top_scores[pos] = top_scores[pos - 1];
+            }
+
+            top[pos] = *entry;
+            top_scores[pos] = score;
+        }
+
+        num_notifications = hotness->stats.num_notifications;
+        num_evictions = hotness->stats.num_evictions;
+        num_worker_runs = hotness->stats.num_worker_runs;
+        num_blocks_migrated = hotness->stats.num_blocks_migrated;
+
+        uvm_spin_unlock(&hotness->lock);
+
+        UVM_SEQ_OR_DBG_PRINT(s, "va_space %p:\n", va_space);
+        UVM_SEQ_OR_DBG_PRINT(s, "  num_notifications    %llu\n", num_notifications);
+        UVM_SEQ_OR_DBG_PRINT(s, "  num_evictions        %llu\n", num_evictions);
+        UVM_SEQ_OR_DBG_PRINT(s, "  num_worker_runs      %llu\n", num_worker_runs);
+        UVM_SEQ_OR_DBG_PRINT(s, "  num_blocks_migrated  %llu\n", num_blocks_migrated);
+        UVM_SEQ_OR_DBG_PRINT(s, "  tracked_blocks       %u\n", num_live);
+        UVM_SEQ_OR_DBG_PRINT(s, "  histogram (decayed notifications):\n");
+
+        UVM_SEQ_OR_DBG_PRINT(s, "    < 1              %llu\n", histogram[0]);
+        for (i = 1; i < UVM_ACCESS_COUNTER_HOTNESS_HISTOGRAM_BUCKETS; i++)
+            UVM_SEQ_OR_DBG_PRINT(s, "    >= %-12u  %llu\n", 1u << (i - 1), histogram[i]);
+
+        for (i = 0; i < ARRAY_SIZE(top) && top_scores[i] != 0; i++) {
+            UVM_SEQ_OR_DBG_PRINT(s,
+                                 "  hot 0x%llx gpu %u score %llu\n",
+                                 top[i].va_block_start,
+                                 uvm_id_value(top[i].gpu_id),
+                                 top_scores[i] >> UVM_ACCESS_COUNTER_HOTNESS_SCORE_SHIFT);
+        }
+    }
+
+    uvm_mutex_unlock(&g_uvm_global.va_spaces.lock);
+}
+
 NV_STATUS uvm_access_counters_init(void)
 {
     NV_STATUS status = NV_OK;
@@ -1923,6 +2542,21 @@ void uvm_access_counters_exit(void)
 
 NV_STATUS uvm_perf_access_counters_init(void)
 {
+    if (uvm_perf_access_counter_hotness_top_n == 0 ||
+        uvm_perf_access_counter_hotness_top_n > UVM_PERF_ACCESS_COUNTER_HOTNESS_TOP_N_MAX) {
+        UVM_INFO_PRINT("Invalid value %u for uvm_perf_access_counter_hotness_top_n, using %u instead\n",
+                       uvm_perf_access_counter_hotness_top_n,
+                       UVM_PERF_ACCESS_COUNTER_HOTNESS_TOP_N_DEFAULT);
+        uvm_perf_access_counter_hotness_top_n = UVM_PERF_ACCESS_COUNTER_HOTNESS_TOP_N_DEFAULT;
+    }
+
+    if (uvm_perf_access_counter_hotness_decay_ms == 0) {
+        UVM_INFO_PRINT("Invalid value %u for uvm_perf_access_counter_hotness_decay_ms, using %u instead\n",
+                       uvm_perf_access_counter_hotness_decay_ms,
+                       UVM_PERF_ACCESS_COUNTER_HOTNESS_DECAY_MS_DEFAULT);
+        uvm_perf_access_counter_hotness_decay_ms = UVM_PERF_ACCESS_COUNTER_HOTNESS_DECAY_MS_DEFAULT;
+    }
+
     uvm_perf_module_init("perf_access_counters",
                          UVM_PERF_MODULE_TYPE_ACCESS_COUNTERS,
                          g_callbacks_access_counters,
@@ -1952,6 +2586,28 @@ NV_STATUS uvm_perf_access_counters_load(uvm_va_space_t *va_space)
     return NV_OK;
 }
 
+void uvm_perf_access_counters_stop(uvm_va_space_t *va_space)
+{
+    va_space_access_counters_info_t *va_space_access_counters;
+    access_counter_hotness_t *hotness = NULL;
+
+    uvm_va_space_down_write(va_space);
+    va_space_access_counters = va_space_access_counters_info_get_or_null(va_space);
+
+    // Prevent further hotness migrations from being scheduled
+    if (va_space_access_counters && va_space_access_counters->hotness) {
+        hotness = va_space_access_counters->hotness;
+        hotness->in_va_space_teardown = true;
+    }
+
+    uvm_va_space_up_write(va_space);
+
+    // The tracker is only freed by uvm_perf_access_counters_unload, which is
+    // called later in the teardown path.
+    if (hotness)
+        (void)cancel_delayed_work_sync(&hotness->dwork);
+}
+
 void uvm_perf_access_counters_unload(uvm_va_space_t *va_space)
 {
     uvm_perf_module_unload(&g_module_access_counters, va_space);
@@ -65,8 +65,14 @@ void uvm_perf_access_counters_exit(void);
 // VA space initialization/cleanup functions. See comments in
 // uvm_perf_heuristics.h
 NV_STATUS uvm_perf_access_counters_load(uvm_va_space_t *va_space);
+void uvm_perf_access_counters_stop(uvm_va_space_t *va_space);
 void uvm_perf_access_counters_unload(uvm_va_space_t *va_space);
 
+// Print the access counter hotness histograms of all VA spaces for the GPUs
+// under the given parent GPU. Only VA spaces created with
+// uvm_perf_access_counter_hotness set track hotness.
+void uvm_parent_gpu_access_counters_print_hotness(uvm_parent_gpu_t *parent_gpu, struct seq_file *s);
+
 // Check whether access counters should be enabled when the given GPU is
 // registered on any VA space.
 bool uvm_parent_gpu_access_counters_required(const uvm_parent_gpu_t *parent_gpu);
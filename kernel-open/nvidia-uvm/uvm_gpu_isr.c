@@ -51,6 +51,15 @@
 // re-evaluated by writing to GET. Non-replayable faults work the same way, but
 // they are currently owned by RM, so UVM doesn't have to do anything.
 
+// Whether the bottom half threads of each GPU, and the state they use, are
+// placed on the NUMA node closest to the GPU. When enabled, the threads are
+// restricted to the CPUs of that node.
+static int uvm_isr_numa_affinity = 1;
+module_param(uvm_isr_numa_affinity, int, S_IRUGO);
+MODULE_PARM_DESC(uvm_isr_numa_affinity,
+                 "Run the GPU bottom half threads on, and allocate their state from, the NUMA node closest to "
+                 "the GPU. Default: 1.");
+
 // For use by the nv_kthread_q that is servicing the replayable fault bottom
 // half, only.
 static void replayable_faults_isr_bottom_half_entry(void *args);
@@ -284,6 +293,14 @@ NV_STATUS uvm_isr_top_half_entry(const NvProcessorUuid *gpu_uuid)
     UVM_ENTRY_RET(uvm_isr_top_half(gpu_uuid));
 }
 
+int uvm_parent_gpu_isr_numa_node(uvm_parent_gpu_t *parent_gpu)
+{
+    if (!uvm_isr_numa_affinity)
+        return NUMA_NO_NODE;
+
+    return parent_gpu->closest_cpu_numa_node;
+}
+
 static NV_STATUS init_queue_on_node(nv_kthread_q_t *queue, const char *name, int node)
 {
 #if UVM_THREAD_AFFINITY_SUPPORTED()
@@ -301,6 +318,11 @@ static NV_STATUS init_queue_on_node(nv_kthread_q_t *queue, const char *name, int
     return errno_to_nv_status(nv_kthread_q_init(queue, name));
 }
 
+NV_STATUS uvm_parent_gpu_isr_init_queue(uvm_parent_gpu_t *parent_gpu, nv_kthread_q_t *queue, const char *name)
+{
+    return init_queue_on_node(queue, name, uvm_parent_gpu_isr_numa_node(parent_gpu));
+}
+
 static NV_STATUS uvm_isr_init_access_counters(uvm_parent_gpu_t *parent_gpu, NvU32 notif_buf_index)
 {
     NV_STATUS status = NV_OK;
@@ -382,7 +404,7 @@ NV_STATUS uvm_parent_gpu_init_isr(uvm_parent_gpu_t *parent_gpu)
     parent_gpu->isr.replayable_faults.handling = true;
 
     snprintf(kthread_name, sizeof(kthread_name), "UVM GPU%u BH", uvm_parent_id_value(parent_gpu->id));
-    status = init_queue_on_node(&parent_gpu->isr.bottom_half_q, kthread_name, parent_gpu->closest_cpu_numa_node);
+    status = uvm_parent_gpu_isr_init_queue(parent_gpu, &parent_gpu->isr.bottom_half_q, kthread_name);
     if (status != NV_OK) {
         UVM_ERR_PRINT("Failed in nv_kthread_q_init for bottom_half_q: %s, GPU %s\n",
                       nvstatusToString(status),
@@ -409,9 +431,7 @@ NV_STATUS uvm_parent_gpu_init_isr(uvm_parent_gpu_t *parent_gpu)
     parent_gpu->isr.non_replayable_faults.handling = true;
 
     snprintf(kthread_name, sizeof(kthread_name), "UVM GPU%u KC", uvm_parent_id_value(parent_gpu->id));
-    status = init_queue_on_node(&parent_gpu->isr.kill_channel_q,
-                                kthread_name,
-                                parent_gpu->closest_cpu_numa_node);
+    status = uvm_parent_gpu_isr_init_queue(parent_gpu, &parent_gpu->isr.kill_channel_q, kthread_name);
     if (status != NV_OK) {
         UVM_ERR_PRINT("Failed in nv_kthread_q_init for kill_channel_q: %s, GPU %s\n",
                       nvstatusToString(status),
@@ -193,6 +193,16 @@ void uvm_access_counters_intr_disable(uvm_access_counter_buffer_t *access_counte
 // parent_gpu->isr.interrupts_lock must be held to call this function.
 void uvm_access_counters_intr_enable(uvm_access_counter_buffer_t *access_counters);
 
+// Return the NUMA node on which the bottom half threads of the GPU run and
+// their state is allocated, or NUMA_NO_NODE if they are not placed on a
+// specific node. See the uvm_isr_numa_affinity module parameter.
+int uvm_parent_gpu_isr_numa_node(uvm_parent_gpu_t *parent_gpu);
+
+// Initialize a queue used to service bottom half work of the GPU. The queue
+// thread is created on, and restricted to the CPUs of, the node returned by
+// uvm_parent_gpu_isr_numa_node(), if any.
+NV_STATUS uvm_parent_gpu_isr_init_queue(uvm_parent_gpu_t *parent_gpu, nv_kthread_q_t *queue, const char *name);
+
 // Return the first valid GPU given the parent GPU or NULL if no MIG instances
 // are registered. This should only be called from bottom halves or if the
 // g_uvm_global.global_lock is held so that the returned pointer remains valid.
@@ -120,6 +120,7 @@
 NV_STATUS uvm_parent_gpu_fault_buffer_init_non_replayable_faults(uvm_parent_gpu_t *parent_gpu)
 {
     uvm_non_replayable_fault_buffer_t *non_replayable_faults = &parent_gpu->fault_buffer.non_replayable;
+    int node = uvm_parent_gpu_isr_numa_node(parent_gpu);
 
     non_replayable_faults->shadow_buffer_copy = NULL;
     non_replayable_faults->fault_cache        = NULL;
@@ -128,12 +129,13 @@ NV_STATUS uvm_parent_gpu_fault_buffer_init_non_replayable_faults(uvm_parent_gpu_
                                         parent_gpu->fault_buffer_hal->entry_size(parent_gpu);
 
     non_replayable_faults->shadow_buffer_copy =
-        uvm_kvmalloc_zero(parent_gpu->fault_buffer.rm_info.nonReplayable.bufferSize);
+        uvm_kvmalloc_zero_node(parent_gpu->fault_buffer.rm_info.nonReplayable.bufferSize, node);
     if (!non_replayable_faults->shadow_buffer_copy)
         return NV_ERR_NO_MEMORY;
 
-    non_replayable_faults->fault_cache = uvm_kvmalloc_zero(non_replayable_faults->max_faults *
-                                                           sizeof(*non_replayable_faults->fault_cache));
+    non_replayable_faults->fault_cache = uvm_kvmalloc_zero_node(non_replayable_faults->max_faults *
+                                                                sizeof(*non_replayable_faults->fault_cache),
+                                                                node);
     if (!non_replayable_faults->fault_cache)
         return NV_ERR_NO_MEMORY;
 
@@ -23,6 +23,7 @@
 
 #include "linux/sort.h"
 #include "nv_uvm_interface.h"
+#include "uvm_api.h"
 #include "uvm_common.h"
 #include "uvm_linux.h"
 #include "uvm_global.h"
@@ -115,6 +116,93 @@ module_param(uvm_perf_fault_max_throttle_per_service, uint, S_IRUGO);
 static unsigned uvm_perf_fault_coalesce = 1;
 module_param(uvm_perf_fault_coalesce, uint, S_IRUGO);
 
+#define UVM_PERF_FAULT_SERVICE_WORKERS_DEFAULT 1
+#define UVM_PERF_FAULT_SERVICE_WORKERS_MAX 16
+
+// Number of threads that service each replayable fault batch. With the default
+// value, the batch is serviced by the bottom half thread only. Larger values
+// create additional per-GPU kthreads, and the sorted batch is split into
+// partitions that never share a VA block, which are serviced concurrently.
+//
+// Parallel servicing is not used with UVM_PERF_FAULT_REPLAY_POLICY_BLOCK, since
+// that policy issues a replay after each VA block, or on GPUs that support ATS.
+static unsigned uvm_perf_fault_service_workers = UVM_PERF_FAULT_SERVICE_WORKERS_DEFAULT;
+module_param(uvm_perf_fault_service_workers, uint, S_IRUGO);
+
+// Minimum number of coalesced faults per partition. Smaller partitions are not
+// worth the cost of waking up a worker.
+#define UVM_PERF_FAULT_SERVICE_MIN_FAULTS_PER_WORKER 16
+
+// Fetch, coalesce and sort the next fault batch while the copies and mappings
+// pushed to service the current batch are in flight, instead of after the
+// current batch has been replayed. This hides the CPU preprocessing latency
+// behind the GPU work at the cost of a second batch context.
+static unsigned uvm_perf_fault_pipeline = 0;
+module_param(uvm_perf_fault_pipeline, uint, S_IRUGO);
+
+// Adjust the batch size, the replay policy and the number of batches serviced
+// per bottom half execution at runtime, based on the fetch, service and replay
+// latency and the duplicate ratio measured on each GPU. uvm_perf_fault_batch_count
+// becomes the upper bound of the batch size, and the replay policy is only
+// adjusted between BATCH and BATCH_FLUSH.
+static unsigned uvm_perf_fault_batch_adaptive = 0;
+module_param(uvm_perf_fault_batch_adaptive, uint, S_IRUGO);
+
+#define UVM_PERF_FAULT_SERVICE_BUDGET_USEC_DEFAULT 2000
+
+// Target duration of a bottom half execution when adaptive batch control is
+// enabled. Used to derive the maximum number of batches per service from the
+// average batch latency.
+static unsigned uvm_perf_fault_service_budget_usec = UVM_PERF_FAULT_SERVICE_BUDGET_USEC_DEFAULT;
+module_param(uvm_perf_fault_service_budget_usec, uint, S_IRUGO);
+
+// Number of batches over which latency is accumulated before a decision is
+// made
+#define UVM_FAULT_BATCH_CONTROL_WINDOW 16
+
+#define UVM_FAULT_BATCH_CONTROL_MIN_BATCH_SIZE 32
+
+// The maximum number of batches per service can grow up to this factor of
+// uvm_perf_fault_max_batches_per_service
+#define UVM_FAULT_BATCH_CONTROL_MAX_BATCHES_FACTOR 4
+
+// Duplicate percentages above which BATCH_FLUSH is selected, and below which
+// BATCH is selected. The gap prevents oscillation between both policies.
+#define UVM_FAULT_BATCH_CONTROL_FLUSH_DUPLICATE_PCT_HIGH 25
+#define UVM_FAULT_BATCH_CONTROL_FLUSH_DUPLICATE_PCT_LOW   5
+
+// Changes in cost per fault smaller than 1/N are considered noise
+#define UVM_FAULT_BATCH_CONTROL_NOISE_SHIFT 3
+
+static void fault_service_worker_entry(void *args);
+
+static void fault_batch_control_init(uvm_parent_gpu_t *parent_gpu)
+{
+    uvm_replayable_fault_buffer_t *replayable_faults = &parent_gpu->fault_buffer.replayable;
+    uvm_fault_batch_control_t *batch_control = &replayable_faults->batch_control;
+
+    memset(batch_control, 0, sizeof(*batch_control));
+
+    batch_control->max_batches_per_service = uvm_perf_fault_max_batches_per_service;
+    batch_control->max_batch_size = parent_gpu->fault_buffer.max_batch_size;
+    batch_control->min_batch_size = min(batch_control->max_batch_size, (NvU32)UVM_FAULT_BATCH_CONTROL_MIN_BATCH_SIZE);
+
+    if (!uvm_perf_fault_batch_adaptive)
+        return;
+
+    batch_control->enabled = true;
+    batch_control->adjust_replay_policy = replayable_faults->replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BATCH ||
+                                          replayable_faults->replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BATCH_FLUSH;
+
+    // Start from the configured batch size, which is also the upper bound, so
+    // the first move is downwards
+    batch_control->growing = false;
+
+    // Guarantee forward progress even if the budget is too small for a single
+    // batch
+    batch_control->max_batches_per_service = max(batch_control->max_batches_per_service, 1u);
+}
+
 // This function is used for both the initial fault buffer initialization and
 // the power management resume path.
 static void fault_buffer_reinit_replayable_faults(uvm_parent_gpu_t *parent_gpu)
@@ -135,6 +223,157 @@ static void fault_buffer_reinit_replayable_faults(uvm_parent_gpu_t *parent_gpu)
         parent_gpu->arch_hal->disable_prefetch_faults(parent_gpu);
 }
 
+// There is no error handling in this function. The caller is in charge of
+// calling fault_service_workers_deinit on failure.
+static NV_STATUS fault_service_workers_init(uvm_parent_gpu_t *parent_gpu)
+{
+    NV_STATUS status;
+    NvU32 i;
+    uvm_replayable_fault_buffer_t *replayable_faults = &parent_gpu->fault_buffer.replayable;
+    NvU32 num_workers = max(uvm_perf_fault_service_workers, 1u);
+
+    num_workers = min(num_workers, (NvU32)UVM_PERF_FAULT_SERVICE_WORKERS_MAX);
+    if (num_workers != uvm_perf_fault_service_workers) {
+        UVM_INFO_PRINT("Invalid uvm_perf_fault_service_workers value on GPU %s: %u. Valid range [1:%u] Using %u instead\n",
+                       uvm_parent_gpu_name(parent_gpu),
+                       uvm_perf_fault_service_workers,
+                       UVM_PERF_FAULT_SERVICE_WORKERS_MAX,
+                       num_workers);
+    }
+
+    replayable_faults->parallel.num_workers = 1;
+    if (num_workers == 1)
+        return NV_OK;
+
+    replayable_faults->parallel.workers = uvm_kvmalloc_zero_node(num_workers * sizeof(*replayable_faults->parallel.workers),
+                                                                 uvm_parent_gpu_isr_numa_node(parent_gpu));
+    if (!replayable_faults->parallel.workers)
+        return NV_ERR_NO_MEMORY;
+
+    replayable_faults->parallel.num_workers = num_workers;
+
+    for (i = 0; i < num_workers; ++i) {
+        uvm_fault_service_worker_t *worker = &replayable_faults->parallel.workers[i];
+        char kthread_name[TASK_COMM_LEN + 1];
+
+        worker->parent_gpu = parent_gpu;
+        init_completion(&worker->done);
+        uvm_tracker_init(&worker->batch_context.tracker);
+
+        worker->batch_context.ats_invalidate = &worker->ats_invalidate;
+
+        worker->block_service_context = uvm_kvmalloc_zero_node(sizeof(*worker->block_service_context),
+                                                               uvm_parent_gpu_isr_numa_node(parent_gpu));
+        if (!worker->block_service_context)
+            return NV_ERR_NO_MEMORY;
+
+        worker->block_service_context->block_context = uvm_va_block_context_alloc(NULL);
+        if (!worker->block_service_context->block_context)
+            return NV_ERR_NO_MEMORY;
+
+        worker->batch_context.block_service_context = worker->block_service_context;
+
+        // Worker 0 runs in the bottom half thread
+        if (i == 0)
+            continue;
+
+        nv_kthread_q_item_init(&worker->q_item, fault_service_worker_entry, worker);
+
+        snprintf(kthread_name, sizeof(kthread_name), "UVM GPU%u FW%u", uvm_parent_id_value(parent_gpu->id), i);
+        status = uvm_parent_gpu_isr_init_queue(parent_gpu, &worker->q, kthread_name);
+        if (status != NV_OK) {
+            UVM_ERR_PRINT("Failed in nv_kthread_q_init for fault service worker %u: %s, GPU %s\n",
+                          i,
+                          nvstatusToString(status),
+                          uvm_parent_gpu_name(parent_gpu));
+            return status;
+        }
+    }
+
+    return NV_OK;
+}
+
+static void fault_service_workers_deinit(uvm_parent_gpu_t *parent_gpu)
+{
+    NvU32 i;
+    uvm_replayable_fault_buffer_t *replayable_faults = &parent_gpu->fault_buffer.replayable;
+
+    if (!replayable_faults->parallel.workers)
+        return;
+
+    for (i = 0; i < replayable_faults->parallel.num_workers; ++i) {
+        uvm_fault_service_worker_t *worker = &replayable_faults->parallel.workers[i];
+
+        // It is safe to stop a queue that was never initialized
+        nv_kthread_q_stop(&worker->q);
+
+        if (worker->block_service_context) {
+            uvm_va_block_context_free(worker->block_service_context->block_context);
+            uvm_kvfree(worker->block_service_context);
+        }
+
+        UVM_ASSERT(uvm_tracker_is_empty(&worker->batch_context.tracker));
+        uvm_tracker_deinit(&worker->batch_context.tracker);
+    }
+
+    uvm_kvfree(replayable_faults->parallel.workers);
+    replayable_faults->parallel.workers = NULL;
+    replayable_faults->parallel.num_workers = 1;
+}
+
+// The arrays are sized for FAULT_FETCH_MODE_ALL, since any batch context may
+// end up being used by the fault cancel algorithm.
+//
+// There is no error handling in this function. The caller is in charge of
+// calling fault_batch_context_deinit on failure.
+static NV_STATUS fault_batch_context_init(uvm_parent_gpu_t *parent_gpu,
+                                          uvm_fault_service_batch_context_t *batch_context)
+{
+    uvm_replayable_fault_buffer_t *replayable_faults = &parent_gpu->fault_buffer.replayable;
+    int node = uvm_parent_gpu_isr_numa_node(parent_gpu);
+    NV_STATUS status;
+
+    batch_context->fault_cache = uvm_kvmalloc_zero_node(replayable_faults->max_faults *
+                                                        sizeof(*batch_context->fault_cache),
+                                                        node);
+    if (!batch_context->fault_cache)
+        return NV_ERR_NO_MEMORY;
+
+    batch_context->ordered_fault_cache = uvm_kvmalloc_zero_node(replayable_faults->max_faults *
+                                                                sizeof(*batch_context->ordered_fault_cache),
+                                                                node);
+    if (!batch_context->ordered_fault_cache)
+        return NV_ERR_NO_MEMORY;
+
+    status = uvm_sort_key_context_init(&batch_context->sort_context, replayable_faults->max_faults, node);
+    if (status != NV_OK)
+        return status;
+
+    batch_context->utlbs = uvm_kvmalloc_zero_node(replayable_faults->utlb_count * sizeof(*batch_context->utlbs), node);
+    if (!batch_context->utlbs)
+        return NV_ERR_NO_MEMORY;
+
+    batch_context->max_utlb_id = 0;
+
+    // Batches are never serviced concurrently, so all the batch contexts share
+    // the same block service context
+    batch_context->block_service_context = &replayable_faults->block_service_context;
+    batch_context->ats_invalidate = &replayable_faults->ats_invalidate;
+
+    return NV_OK;
+}
+
+static void fault_batch_context_deinit(uvm_fault_service_batch_context_t *batch_context)
+{
+    uvm_kvfree(batch_context->fault_cache);
+    uvm_kvfree(batch_context->ordered_fault_cache);
+    uvm_kvfree(batch_context->utlbs);
+    uvm_sort_key_context_deinit(&batch_context->sort_context);
+    batch_context->fault_cache         = NULL;
+    batch_context->ordered_fault_cache = NULL;
+    batch_context->utlbs               = NULL;
+}
+
 // There is no error handling in this function. The caller is in charge of
 // calling fault_buffer_deinit_replayable_faults on failure.
 static NV_STATUS fault_buffer_init_replayable_faults(uvm_parent_gpu_t *parent_gpu)
@@ -164,26 +403,27 @@ static NV_STATUS fault_buffer_init_replayable_faults(uvm_parent_gpu_t *parent_gp
                        parent_gpu->fault_buffer.max_batch_size);
     }
 
-    batch_context->fault_cache = uvm_kvmalloc_zero(replayable_faults->max_faults * sizeof(*batch_context->fault_cache));
-    if (!batch_context->fault_cache)
-        return NV_ERR_NO_MEMORY;
-
     // fault_cache is used to signal that the tracker was initialized.
     uvm_tracker_init(&replayable_faults->replay_tracker);
 
-    batch_context->ordered_fault_cache = uvm_kvmalloc_zero(replayable_faults->max_faults *
-                                                           sizeof(*batch_context->ordered_fault_cache));
-    if (!batch_context->ordered_fault_cache)
-        return NV_ERR_NO_MEMORY;
-
     // This value must be initialized by HAL
     UVM_ASSERT(replayable_faults->utlb_count > 0);
 
-    batch_context->utlbs = uvm_kvmalloc_zero(replayable_faults->utlb_count * sizeof(*batch_context->utlbs));
-    if (!batch_context->utlbs)
-        return NV_ERR_NO_MEMORY;
+    status = fault_batch_context_init(parent_gpu, batch_context);
+    if (status != NV_OK)
+        return status;
 
-    batch_context->max_utlb_id = 0;
+    if (uvm_perf_fault_pipeline) {
+        status = fault_batch_context_init(parent_gpu, &replayable_faults->pipeline.batch_service_context);
+        if (status != NV_OK)
+            return status;
+
+        replayable_faults->pipeline.enabled = true;
+    }
+
+    status = fault_service_workers_init(parent_gpu);
+    if (status != NV_OK)
+        return status;
 
     status = uvm_rm_locked_call(nvUvmInterfaceOwnPageFaultIntr(parent_gpu->rm_device, NV_TRUE));
     if (status != NV_OK) {
@@ -212,6 +452,8 @@ static NV_STATUS fault_buffer_init_replayable_faults(uvm_parent_gpu_t *parent_gp
                        replayable_faults->replay_update_put_ratio);
     }
 
+    fault_batch_control_init(parent_gpu);
+
     // Re-enable fault prefetching just in case it was disabled in a previous run
     parent_gpu->fault_buffer.prefetch_faults_enabled = true;
 
@@ -236,12 +478,12 @@ static void fault_buffer_deinit_replayable_faults(uvm_parent_gpu_t *parent_gpu)
             parent_gpu->arch_hal->enable_prefetch_faults(parent_gpu);
     }
 
-    uvm_kvfree(batch_context->fault_cache);
-    uvm_kvfree(batch_context->ordered_fault_cache);
-    uvm_kvfree(batch_context->utlbs);
-    batch_context->fault_cache         = NULL;
-    batch_context->ordered_fault_cache = NULL;
-    batch_context->utlbs               = NULL;
+    fault_service_workers_deinit(parent_gpu);
+
+    fault_batch_context_deinit(&replayable_faults->pipeline.batch_service_context);
+    replayable_faults->pipeline.enabled = false;
+
+    fault_batch_context_deinit(batch_context);
 }
 
 NV_STATUS uvm_parent_gpu_fault_buffer_init(uvm_parent_gpu_t *parent_gpu)
@@ -1005,6 +1247,76 @@ static int cmp_sort_fault_entry_by_va_space_gpu_address_access_type(const void *
     return cmp_access_type((*a)->fault_access_type, (*b)->fault_access_type);
 }
 
+// Sort ordered_fault_cache by instance pointer using packed keys. Returns false
+// if the keys could not be packed, in which case the array is left untouched.
+static bool sort_fault_entries_by_instance_ptr_keys(uvm_fault_service_batch_context_t *batch_context)
+{
+    uvm_sort_key_context_t *sort_context = &batch_context->sort_context;
+    uvm_sort_key_entry_t *entries = sort_context->entries;
+    NvU32 num_faults = batch_context->num_coalesced_faults;
+    NvU32 i;
+
+    for (i = 0; i < num_faults; ++i) {
+        uvm_fault_buffer_entry_t *current_entry = batch_context->ordered_fault_cache[i];
+
+        if (!uvm_sort_key_instance_ptr(current_entry->instance_ptr,
+                                       current_entry->fault_source.ve_id,
+                                       &entries[i].key))
+            return false;
+
+        entries[i].ptr = current_entry;
+    }
+
+    uvm_sort_key_entries(sort_context, num_faults);
+
+    for (i = 0; i < num_faults; ++i)
+        batch_context->ordered_fault_cache[i] = entries[i].ptr;
+
+    return true;
+}
+
+// Sort ordered_fault_cache by va_space, GPU ID, fault address, and fault access
+// type using packed keys, which yields the same order as
+// cmp_sort_fault_entry_by_va_space_gpu_address_access_type. Returns false if
+// the keys could not be packed, in which case the array is left untouched.
+static bool sort_fault_entries_by_va_space_gpu_address_access_type_keys(uvm_fault_service_batch_context_t *batch_context)
+{
+    uvm_sort_key_context_t *sort_context = &batch_context->sort_context;
+    uvm_sort_key_entry_t *entries = sort_context->entries;
+    NvU32 num_faults = batch_context->num_coalesced_faults;
+    NvU32 i;
+
+    uvm_sort_key_begin(sort_context, order_base_2(UVM_FAULT_ACCESS_TYPE_COUNT));
+
+    for (i = 0; i < num_faults; ++i) {
+        uvm_fault_buffer_entry_t *current_entry = batch_context->ordered_fault_cache[i];
+
+        uvm_sort_key_add(sort_context, current_entry->va_space, current_entry->gpu, current_entry->fault_address);
+    }
+
+    if (!uvm_sort_key_finalize(sort_context))
+        return false;
+
+    for (i = 0; i < num_faults; ++i) {
+        uvm_fault_buffer_entry_t *current_entry = batch_context->ordered_fault_cache[i];
+
+        // More intrusive access types go first. See cmp_access_type
+        entries[i].key = uvm_sort_key_pack(sort_context,
+                                           current_entry->va_space,
+                                           current_entry->gpu,
+                                           current_entry->fault_address,
+                                           UVM_FAULT_ACCESS_TYPE_COUNT - 1 - current_entry->fault_access_type);
+        entries[i].ptr = current_entry;
+    }
+
+    uvm_sort_key_entries(sort_context, num_faults);
+
+    for (i = 0; i < num_faults; ++i)
+        batch_context->ordered_fault_cache[i] = entries[i].ptr;
+
+    return true;
+}
+
 // Translate all instance pointers to a VA space and GPU instance. Since the
 // buffer is ordered by instance_ptr, we minimize the number of translations.
 //
@@ -1139,7 +1451,7 @@ static NV_STATUS preprocess_fault_batch(uvm_parent_gpu_t *parent_gpu,
     UVM_ASSERT(j == batch_context->num_coalesced_faults);
 
     // 1) if the fault batch contains more than one, sort by instance_ptr
-    if (!batch_context->is_single_instance_ptr) {
+    if (!batch_context->is_single_instance_ptr && !sort_fault_entries_by_instance_ptr_keys(batch_context)) {
         sort(ordered_fault_cache,
              batch_context->num_coalesced_faults,
              sizeof(*ordered_fault_cache),
@@ -1153,16 +1465,30 @@ static NV_STATUS preprocess_fault_batch(uvm_parent_gpu_t *parent_gpu,
         return status;
 
     // 3) sort by va_space, GPU ID, fault address (GPU already reports
-    // 4K-aligned address), and access type.
-    sort(ordered_fault_cache,
-         batch_context->num_coalesced_faults,
-         sizeof(*ordered_fault_cache),
-         cmp_sort_fault_entry_by_va_space_gpu_address_access_type,
-         NULL);
+    // 4K-aligned address), and access type. Packed keys are used unless the
+    // batch references too many VA spaces or too wide an address range.
+    if (!sort_fault_entries_by_va_space_gpu_address_access_type_keys(batch_context)) {
+        sort(ordered_fault_cache,
+             batch_context->num_coalesced_faults,
+             sizeof(*ordered_fault_cache),
+             cmp_sort_fault_entry_by_va_space_gpu_address_access_type,
+             NULL);
+    }
 
     return NV_OK;
 }
 
+// Reset the per-batch servicing state before fetching a new batch
+static void fault_batch_context_reset(uvm_fault_service_batch_context_t *batch_context)
+{
+    batch_context->num_invalid_prefetch_faults = 0;
+    batch_context->num_duplicate_faults        = 0;
+    batch_context->num_replays                 = 0;
+    batch_context->fatal_va_space              = NULL;
+    batch_context->fatal_gpu                   = NULL;
+    batch_context->has_throttled_faults        = false;
+}
+
 static bool check_fault_entry_duplicate(const uvm_fault_buffer_entry_t *current_entry,
                                         const uvm_fault_buffer_entry_t *previous_entry)
 {
@@ -1225,13 +1551,14 @@ static void mark_fault_fatal(uvm_fault_service_batch_context_t *batch_context,
                              UvmEventFatalReason fatal_reason,
                              uvm_fault_cancel_va_mode_t cancel_va_mode)
 {
-    uvm_fault_utlb_info_t *utlb = &batch_context->utlbs[fault_entry->fault_source.utlb_id];
-
     fault_entry->is_fatal = true;
     fault_entry->fatal_reason = fatal_reason;
     fault_entry->replayable.cancel_va_mode = cancel_va_mode;
 
-    utlb->has_fatal_faults = true;
+    // Parallel service workers don't have access to the uTLB array. The
+    // has_fatal_faults flag is set when the workers are joined.
+    if (batch_context->utlbs)
+        batch_context->utlbs[fault_entry->fault_source.utlb_id].has_fatal_faults = true;
 
     if (!batch_context->fatal_va_space) {
         UVM_ASSERT(fault_entry->va_space);
@@ -1369,10 +1696,9 @@ static NV_STATUS service_fault_batch_block_locked(uvm_gpu_t *gpu,
     uvm_page_index_t last_page_index;
     NvU32 page_fault_count = 0;
     uvm_range_group_range_iter_t iter;
-    uvm_replayable_fault_buffer_t *replayable_faults = &gpu->parent->fault_buffer.replayable;
     uvm_fault_buffer_entry_t **ordered_fault_cache = batch_context->ordered_fault_cache;
     uvm_fault_buffer_entry_t *first_fault_entry = ordered_fault_cache[first_fault_index];
-    uvm_service_block_context_t *block_context = &replayable_faults->block_service_context;
+    uvm_service_block_context_t *block_context = batch_context->block_service_context;
     uvm_va_space_t *va_space = uvm_va_block_get_va_space(va_block);
     const uvm_va_policy_t *policy;
     NvU64 end;
@@ -1506,7 +1832,8 @@ static NV_STATUS service_fault_batch_block_locked(uvm_gpu_t *gpu,
         thrashing_hint = uvm_perf_thrashing_get_hint(va_block,
                                                      block_context->block_context,
                                                      current_entry->fault_address,
-                                                     gpu->id);
+                                                     gpu->id,
+                                                     service_access_type_mask);
         if (thrashing_hint.type == UVM_PERF_THRASHING_HINT_TYPE_THROTTLE) {
             // Throttling is implemented by sleeping in the fault handler on
             // the CPU and by continuing to process faults on other pages on
@@ -1592,8 +1919,7 @@ static NV_STATUS service_fault_batch_block(uvm_gpu_t *gpu,
     NV_STATUS status;
     uvm_va_block_retry_t va_block_retry;
     NV_STATUS tracker_status;
-    uvm_replayable_fault_buffer_t *replayable_faults = &gpu->parent->fault_buffer.replayable;
-    uvm_service_block_context_t *fault_block_context = &replayable_faults->block_service_context;
+    uvm_service_block_context_t *fault_block_context = batch_context->block_service_context;
 
     fault_block_context->operation = UVM_SERVICE_OPERATION_REPLAYABLE_FAULTS;
     fault_block_context->num_retries = 0;
@@ -1935,8 +2261,7 @@ static NV_STATUS service_fault_batch_dispatch(uvm_va_space_t *va_space,
     uvm_va_range_t *va_range_next = NULL;
     uvm_va_block_t *va_block;
     uvm_gpu_t *gpu = gpu_va_space->gpu;
-    uvm_va_block_context_t *va_block_context =
-        gpu->parent->fault_buffer.replayable.block_service_context.block_context;
+    uvm_va_block_context_t *va_block_context = batch_context->block_service_context->block_context;
     uvm_fault_buffer_entry_t *current_entry = batch_context->ordered_fault_cache[fault_index];
     struct mm_struct *mm = va_block_context->mm;
     NvU64 fault_address = current_entry->fault_address;
@@ -2027,8 +2352,7 @@ static NV_STATUS service_fault_batch_for_cancel(uvm_fault_service_batch_context_
     uvm_gpu_va_space_t *gpu_va_space = NULL;
     struct mm_struct *mm;
     uvm_replayable_fault_buffer_t *replayable_faults = &gpu->parent->fault_buffer.replayable;
-    uvm_service_block_context_t *service_context = &gpu->parent->fault_buffer.replayable.block_service_context;
-    uvm_va_block_context_t *va_block_context = service_context->block_context;
+    uvm_va_block_context_t *va_block_context = batch_context->block_service_context->block_context;
 
     UVM_ASSERT(va_space);
     UVM_ASSERT(gpu);
@@ -2080,12 +2404,7 @@ static NV_STATUS service_fault_batch_for_cancel(uvm_fault_service_batch_context_
         goto done;
 
     // Re-parse the new faults
-    batch_context->num_invalid_prefetch_faults = 0;
-    batch_context->num_duplicate_faults        = 0;
-    batch_context->num_replays                 = 0;
-    batch_context->fatal_va_space              = NULL;
-    batch_context->fatal_gpu                   = NULL;
-    batch_context->has_throttled_faults        = false;
+    fault_batch_context_reset(batch_context);
 
     status = fetch_fault_buffer_entries(gpu->parent, batch_context, FAULT_FETCH_MODE_ALL);
     if (status != NV_OK)
@@ -2134,7 +2453,7 @@ static NV_STATUS service_fault_batch_for_cancel(uvm_fault_service_batch_context_
             ++i;
         }
         else {
-            uvm_ats_fault_invalidate_t *ats_invalidate = &gpu->parent->fault_buffer.replayable.ats_invalidate;
+            uvm_ats_fault_invalidate_t *ats_invalidate = batch_context->ats_invalidate;
             NvU32 block_faults;
             const bool hmm_migratable = true;
 
@@ -2201,35 +2520,34 @@ done:
     return status;
 }
 
-// Scan the ordered view of faults and group them by different va_blocks
-// (managed faults) and service faults for each va_block, in batch.
-// Service non-managed faults one at a time as they are encountered during the
-// scan.
+// Scan the ordered view of faults starting at first_fault_index and group them
+// by different va_blocks (managed faults) and service faults for each
+// va_block, in batch. Service non-managed faults one at a time as they are
+// encountered during the scan. The scan ends at
+// batch_context->num_coalesced_faults.
 //
 // Fatal faults are marked for later processing by the caller.
-static NV_STATUS service_fault_batch(uvm_parent_gpu_t *parent_gpu,
-                                     fault_service_mode_t service_mode,
-                                     uvm_fault_service_batch_context_t *batch_context)
+static NV_STATUS service_fault_batch_range(uvm_parent_gpu_t *parent_gpu,
+                                           fault_service_mode_t service_mode,
+                                           uvm_fault_service_batch_context_t *batch_context,
+                                           NvU32 first_fault_index)
 {
     NV_STATUS status = NV_OK;
     NvU32 i;
     uvm_va_space_t *va_space = NULL;
     uvm_gpu_va_space_t *prev_gpu_va_space = NULL;
-    uvm_ats_fault_invalidate_t *ats_invalidate = &parent_gpu->fault_buffer.replayable.ats_invalidate;
+    uvm_ats_fault_invalidate_t *ats_invalidate = batch_context->ats_invalidate;
     struct mm_struct *mm = NULL;
     const bool replay_per_va_block = service_mode != FAULT_SERVICE_MODE_CANCEL &&
                                      parent_gpu->fault_buffer.replayable.replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BLOCK;
-    uvm_service_block_context_t *service_context =
-        &parent_gpu->fault_buffer.replayable.block_service_context;
-    uvm_va_block_context_t *va_block_context = service_context->block_context;
+    uvm_va_block_context_t *va_block_context = batch_context->block_service_context->block_context;
     bool hmm_migratable = true;
 
     ats_invalidate->tlb_batch_pending = false;
 
-    for (i = 0; i < batch_context->num_coalesced_faults;) {
+    for (i = first_fault_index; i < batch_context->num_coalesced_faults;) {
         NvU32 block_faults;
         uvm_fault_buffer_entry_t *current_entry = batch_context->ordered_fault_cache[i];
-        uvm_fault_utlb_info_t *utlb = &batch_context->utlbs[current_entry->fault_source.utlb_id];
         uvm_gpu_va_space_t *gpu_va_space;
 
         UVM_ASSERT(current_entry->va_space);
@@ -2274,8 +2592,15 @@ static NV_STATUS service_fault_batch(uvm_parent_gpu_t *parent_gpu,
                 batch_context->fatal_gpu = current_entry->gpu;
             }
 
-            utlb->has_fatal_faults = true;
-            UVM_ASSERT(utlb->num_pending_faults > 0);
+            // Parallel service workers don't have access to the uTLB array.
+            // See service_fault_batch_parallel().
+            if (batch_context->utlbs) {
+                uvm_fault_utlb_info_t *utlb = &batch_context->utlbs[current_entry->fault_source.utlb_id];
+
+                utlb->has_fatal_faults = true;
+                UVM_ASSERT(utlb->num_pending_faults > 0);
+            }
+
             continue;
         }
 
@@ -2335,6 +2660,11 @@ static NV_STATUS service_fault_batch(uvm_parent_gpu_t *parent_gpu,
             // and we can service a number of VA blocks before returning.
             ++batch_context->batch_id;
         }
+
+        // Prefetch the VA blocks ahead of the streams detected while
+        // servicing the VA block, now that no VA block lock is held
+        if (service_mode != FAULT_SERVICE_MODE_CANCEL)
+            uvm_perf_prefetch_service_streams(va_space, batch_context->block_service_context);
     }
 
     if (prev_gpu_va_space) {
@@ -2352,6 +2682,196 @@ fail:
     return status;
 }
 
+static void fault_service_worker(void *args)
+{
+    uvm_fault_service_worker_t *worker = (uvm_fault_service_worker_t *)args;
+
+    worker->status = service_fault_batch_range(worker->parent_gpu,
+                                               FAULT_SERVICE_MODE_REGULAR,
+                                               &worker->batch_context,
+                                               worker->first_fault_index);
+
+    complete(&worker->done);
+}
+
+static void fault_service_worker_entry(void *args)
+{
+    UVM_ENTRY_VOID(fault_service_worker(args));
+}
+
+// Faults that belong to the same VA space, GPU and UVM_VA_BLOCK_SIZE aligned
+// region are always serviced by the same worker, since they may map to the
+// same VA block.
+static bool fault_entries_in_same_partition(const uvm_fault_buffer_entry_t *a, const uvm_fault_buffer_entry_t *b)
+{
+    return a->va_space == b->va_space &&
+           a->gpu == b->gpu &&
+           UVM_ALIGN_DOWN(a->fault_address, UVM_VA_BLOCK_SIZE) == UVM_ALIGN_DOWN(b->fault_address, UVM_VA_BLOCK_SIZE);
+}
+
+static bool fault_batch_can_service_parallel(uvm_parent_gpu_t *parent_gpu,
+                                             fault_service_mode_t service_mode,
+                                             uvm_fault_service_batch_context_t *batch_context)
+{
+    uvm_replayable_fault_buffer_t *replayable_faults = &parent_gpu->fault_buffer.replayable;
+
+    if (replayable_faults->parallel.num_workers <= 1)
+        return false;
+
+    if (service_mode != FAULT_SERVICE_MODE_REGULAR)
+        return false;
+
+    if (replayable_faults->replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BLOCK)
+        return false;
+
+    // ATS TLB invalidations are tracked in the per-GPU ats_invalidate state
+    if (uvm_parent_gpu_supports_ats(parent_gpu))
+        return false;
+
+    return batch_context->num_coalesced_faults >= 2 * UVM_PERF_FAULT_SERVICE_MIN_FAULTS_PER_WORKER;
+}
+
+// Split the ordered view of the batch into partitions of similar size and
+// assign them to the service workers. Partition boundaries are moved forward
+// until they don't split faults that may belong to the same VA block. Returns
+// the number of partitions.
+static NvU32 partition_fault_batch(uvm_parent_gpu_t *parent_gpu, uvm_fault_service_batch_context_t *batch_context)
+{
+    uvm_replayable_fault_buffer_t *replayable_faults = &parent_gpu->fault_buffer.replayable;
+    uvm_fault_buffer_entry_t **ordered_fault_cache = batch_context->ordered_fault_cache;
+    const NvU32 num_faults = batch_context->num_coalesced_faults;
+    const NvU32 num_workers = replayable_faults->parallel.num_workers;
+    NvU32 faults_per_worker = max((NvU32)DIV_ROUND_UP(num_faults, num_workers),
+                                  (NvU32)UVM_PERF_FAULT_SERVICE_MIN_FAULTS_PER_WORKER);
+    NvU32 num_partitions = 0;
+    NvU32 start = 0;
+
+    while (start < num_faults) {
+        uvm_fault_service_worker_t *worker = &replayable_faults->parallel.workers[num_partitions++];
+        NvU32 end = num_faults;
+
+        if (num_partitions < num_workers && num_faults - start > faults_per_worker) {
+            end = start + faults_per_worker;
+            while (end < num_faults && fault_entries_in_same_partition(ordered_fault_cache[end - 1],
+                                                                       ordered_fault_cache[end]))
+                ++end;
+        }
+
+        worker->first_fault_index = start;
+        worker->batch_context.num_coalesced_faults = end;
+        start = end;
+    }
+
+    return num_partitions;
+}
+
+static void fault_service_worker_prepare(uvm_fault_service_worker_t *worker,
+                                         uvm_fault_service_batch_context_t *batch_context)
+{
+    uvm_fault_service_batch_context_t *worker_context = &worker->batch_context;
+
+    UVM_ASSERT(uvm_tracker_is_empty(&worker_context->tracker));
+
+    // With batch pipelining, the batch context being serviced alternates
+    // between batches
+    worker_context->fault_cache                 = batch_context->fault_cache;
+    worker_context->ordered_fault_cache         = batch_context->ordered_fault_cache;
+    worker_context->num_cached_faults           = batch_context->num_cached_faults;
+    worker_context->batch_id                    = batch_context->batch_id;
+    fault_batch_context_reset(worker_context);
+
+    worker->status = NV_OK;
+    reinit_completion(&worker->done);
+}
+
+// Service the partitions of the batch concurrently, and merge the results of
+// all the workers into batch_context. Worker 0 runs in the calling thread.
+static NV_STATUS service_fault_batch_parallel(uvm_parent_gpu_t *parent_gpu,
+                                              uvm_fault_service_batch_context_t *batch_context,
+                                              NvU32 num_partitions)
+{
+    NV_STATUS status = NV_OK;
+    NvU32 i;
+    uvm_replayable_fault_buffer_t *replayable_faults = &parent_gpu->fault_buffer.replayable;
+    uvm_fault_service_worker_t *workers = replayable_faults->parallel.workers;
+
+    UVM_ASSERT(num_partitions > 1);
+    UVM_ASSERT(num_partitions <= replayable_faults->parallel.num_workers);
+
+    for (i = 0; i < num_partitions; ++i)
+        fault_service_worker_prepare(&workers[i], batch_context);
+
+    for (i = 1; i < num_partitions; ++i)
+        nv_kthread_q_schedule_q_item(&workers[i].q, &workers[i].q_item);
+
+    workers[0].status = service_fault_batch_range(parent_gpu,
+                                                  FAULT_SERVICE_MODE_REGULAR,
+                                                  &workers[0].batch_context,
+                                                  workers[0].first_fault_index);
+
+    for (i = 1; i < num_partitions; ++i)
+        wait_for_completion(&workers[i].done);
+
+    // Merge in partition order, so the VA space selected for the cancel
+    // sequence is the same as if the batch was serviced serially.
+    for (i = 0; i < num_partitions; ++i) {
+        uvm_fault_service_batch_context_t *worker_context = &workers[i].batch_context;
+        NV_STATUS tracker_status;
+        NvU32 j;
+
+        if (status == NV_OK)
+            status = workers[i].status;
+
+        batch_context->num_invalid_prefetch_faults += worker_context->num_invalid_prefetch_faults;
+        batch_context->num_duplicate_faults += worker_context->num_duplicate_faults;
+        batch_context->has_throttled_faults |= worker_context->has_throttled_faults;
+
+        if (!batch_context->fatal_va_space && worker_context->fatal_va_space) {
+            batch_context->fatal_va_space = worker_context->fatal_va_space;
+            batch_context->fatal_gpu = worker_context->fatal_gpu;
+        }
+
+        for (j = workers[i].first_fault_index; j < worker_context->num_coalesced_faults; ++j) {
+            uvm_fault_buffer_entry_t *current_entry = batch_context->ordered_fault_cache[j];
+
+            if (current_entry->is_fatal)
+                batch_context->utlbs[current_entry->fault_source.utlb_id].has_fatal_faults = true;
+        }
+
+        // The work is also tracked by the VA block trackers, so it is safe to
+        // drop the worker's tracker entries if they cannot be merged.
+        tracker_status = uvm_tracker_add_tracker_safe(&batch_context->tracker, &worker_context->tracker);
+        if (status == NV_OK)
+            status = tracker_status;
+
+        uvm_tracker_clear(&worker_context->tracker);
+    }
+
+    ++replayable_faults->parallel.num_parallel_batches;
+
+    return status;
+}
+
+// Service all the faults in the batch, either serially in the calling thread,
+// or in parallel using the fault service workers.
+//
+// Fatal faults are marked for later processing by the caller.
+static NV_STATUS service_fault_batch(uvm_parent_gpu_t *parent_gpu,
+                                     fault_service_mode_t service_mode,
+                                     uvm_fault_service_batch_context_t *batch_context)
+{
+    NvU32 num_partitions;
+
+    if (!fault_batch_can_service_parallel(parent_gpu, service_mode, batch_context))
+        return service_fault_batch_range(parent_gpu, service_mode, batch_context, 0);
+
+    num_partitions = partition_fault_batch(parent_gpu, batch_context);
+    if (num_partitions == 1)
+        return service_fault_batch_range(parent_gpu, service_mode, batch_context, 0);
+
+    return service_fault_batch_parallel(parent_gpu, batch_context, num_partitions);
+}
+
 // Tells if the given fault entry is the first one in its uTLB
 static bool is_first_fault_in_utlb(uvm_fault_service_batch_context_t *batch_context, NvU32 fault_index)
 {
@@ -2868,54 +3388,297 @@ static void enable_disable_prefetch_faults(uvm_parent_gpu_t *parent_gpu,
     }
 }
 
+// Fetch and preprocess the batch that follows batch_context into
+// next_batch_context. This is called after the current batch has been
+// serviced, but before it is replayed, so the CPU work overlaps with the
+// copies and mappings pushed to service the current batch.
+//
+// next_batch_context starts with the work of the current batch in its tracker,
+// so any replay pushed while preprocessing the next batch cannot overtake the
+// servicing of the current batch.
+//
+// *next_batch_ready is set to true if next_batch_context contains a batch
+// that is ready to be serviced.
+static NV_STATUS fetch_next_fault_batch(uvm_parent_gpu_t *parent_gpu,
+                                        uvm_fault_service_batch_context_t *batch_context,
+                                        uvm_fault_service_batch_context_t *next_batch_context,
+                                        bool *next_batch_ready)
+{
+    NV_STATUS status;
+
+    *next_batch_ready = false;
+
+    fault_batch_context_reset(next_batch_context);
+    next_batch_context->batch_id = batch_context->batch_id;
+
+    status = uvm_tracker_add_tracker_safe(&next_batch_context->tracker, &batch_context->tracker);
+    if (status != NV_OK)
+        return status;
+
+    status = fetch_fault_buffer_entries(parent_gpu, next_batch_context, FAULT_FETCH_MODE_BATCH_READY);
+    if (status != NV_OK)
+        return status;
+
+    if (next_batch_context->num_cached_faults == 0)
+        return NV_OK;
+
+    ++next_batch_context->batch_id;
+
+    status = preprocess_fault_batch(parent_gpu, next_batch_context);
+
+    // The fault buffer was flushed and the fetched faults were replayed. The
+    // next batch will be fetched again from scratch.
+    if (status == NV_WARN_MORE_PROCESSING_REQUIRED)
+        return NV_OK;
+
+    if (status == NV_OK) {
+        *next_batch_ready = true;
+        ++parent_gpu->fault_buffer.replayable.pipeline.num_pipelined_batches;
+    }
+
+    return status;
+}
+
+static NvU64 fault_batch_control_timestamp(uvm_parent_gpu_t *parent_gpu)
+{
+    if (!parent_gpu->fault_buffer.replayable.batch_control.enabled)
+        return 0;
+
+    return NV_GETTIME();
+}
+
+static NvU32 *fault_batch_control_policy_cost(uvm_fault_batch_control_t *batch_control,
+                                              uvm_perf_fault_replay_policy_t replay_policy)
+{
+    UVM_ASSERT(replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BATCH ||
+               replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BATCH_FLUSH);
+
+    return &batch_control->policy_ns_per_fault[replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BATCH_FLUSH];
+}
+
+// Switch between BATCH and BATCH_FLUSH. A high duplicate ratio under BATCH
+// means that faults left in the buffer after the replay show up again, which
+// BATCH_FLUSH avoids at the cost of a flush per batch. The policy in use is
+// also abandoned when its cost per fault is clearly worse than the last cost
+// measured under the other policy. Returns true if the policy was changed.
+static bool fault_batch_control_update_replay_policy(uvm_parent_gpu_t *parent_gpu,
+                                                     NvU32 ns_per_fault,
+                                                     NvU32 duplicate_percentage)
+{
+    uvm_replayable_fault_buffer_t *replayable_faults = &parent_gpu->fault_buffer.replayable;
+    uvm_fault_batch_control_t *batch_control = &replayable_faults->batch_control;
+    uvm_perf_fault_replay_policy_t replay_policy = replayable_faults->replay_policy;
+    uvm_perf_fault_replay_policy_t other_policy;
+    NvU32 *other_cost;
+    bool change;
+
+    if (!batch_control->adjust_replay_policy)
+        return false;
+
+    other_policy = replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BATCH? UVM_PERF_FAULT_REPLAY_POLICY_BATCH_FLUSH:
+                                                                        UVM_PERF_FAULT_REPLAY_POLICY_BATCH;
+    other_cost = fault_batch_control_policy_cost(batch_control, other_policy);
+    *fault_batch_control_policy_cost(batch_control, replay_policy) = ns_per_fault;
+
+    if (replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BATCH) {
+        change = duplicate_percentage >= UVM_FAULT_BATCH_CONTROL_FLUSH_DUPLICATE_PCT_HIGH ||
+                 (*other_cost != 0 &&
+                  ns_per_fault > *other_cost + (*other_cost >> UVM_FAULT_BATCH_CONTROL_NOISE_SHIFT));
+    }
+    else {
+        change = duplicate_percentage <= UVM_FAULT_BATCH_CONTROL_FLUSH_DUPLICATE_PCT_LOW &&
+                 (*other_cost == 0 || *other_cost < ns_per_fault);
+    }
+
+    if (!change) {
+        *other_cost -= *other_cost >> UVM_FAULT_BATCH_CONTROL_NOISE_SHIFT;
+        return false;
+    }
+
+    replayable_faults->replay_policy = other_policy;
+
+    return true;
+}
+
+// Hill climbing on the cost per fault: keep moving the batch size in the same
+// direction while the cost does not get worse, and reverse the direction
+// otherwise. Larger batches are only tried when the window had mostly full
+// batches, since the batch size does not limit the fetches otherwise.
+static void fault_batch_control_update_batch_size(uvm_parent_gpu_t *parent_gpu,
+                                                  NvU32 ns_per_fault,
+                                                  NvU32 full_batch_percentage)
+{
+    uvm_fault_batch_control_t *batch_control = &parent_gpu->fault_buffer.replayable.batch_control;
+    NvU32 batch_size = parent_gpu->fault_buffer.max_batch_size;
+    NvU32 step = max(batch_size / 4, 1u);
+    NvU32 prev_ns_per_fault = batch_control->prev_ns_per_fault;
+
+    if (prev_ns_per_fault != 0 && ns_per_fault > prev_ns_per_fault + (prev_ns_per_fault >> UVM_FAULT_BATCH_CONTROL_NOISE_SHIFT))
+        batch_control->growing = !batch_control->growing;
+
+    if (batch_control->growing && batch_size == batch_control->max_batch_size)
+        batch_control->growing = false;
+    else if (!batch_control->growing && batch_size == batch_control->min_batch_size)
+        batch_control->growing = true;
+
+    if (batch_control->growing) {
+        if (full_batch_percentage >= 50)
+            batch_size = min(batch_size + step, batch_control->max_batch_size);
+    }
+    else {
+        batch_size = max(batch_size - step, batch_control->min_batch_size);
+    }
+
+    parent_gpu->fault_buffer.max_batch_size = batch_size;
+    batch_control->prev_ns_per_fault = ns_per_fault;
+}
+
+static void fault_batch_control_update(uvm_parent_gpu_t *parent_gpu)
+{
+    uvm_replayable_fault_buffer_t *replayable_faults = &parent_gpu->fault_buffer.replayable;
+    uvm_fault_batch_control_t *batch_control = &replayable_faults->batch_control;
+    uvm_fault_batch_control_decision_t *decision;
+    NvU64 total_ns = batch_control->window.fetch_ns + batch_control->window.service_ns + batch_control->window.replay_ns;
+    NvU64 num_faults = max(batch_control->window.num_faults, 1ull);
+    NvU64 batch_ns = max(total_ns / batch_control->window.num_batches, 1ull);
+    NvU64 max_batches_per_service;
+    NvU32 ns_per_fault = (NvU32)min(total_ns / num_faults, (NvU64)NV_U32_MAX);
+    NvU32 duplicate_percentage = (NvU32)(batch_control->window.num_duplicate_faults * 100 / num_faults);
+    NvU32 full_batch_percentage = batch_control->window.num_full_batches * 100 / batch_control->window.num_batches;
+
+    // Do not move the batch size in the same window as the replay policy, so
+    // that the next cost comparison only reflects one change
+    if (fault_batch_control_update_replay_policy(parent_gpu, ns_per_fault, duplicate_percentage))
+        batch_control->prev_ns_per_fault = 0;
+    else
+        fault_batch_control_update_batch_size(parent_gpu, ns_per_fault, full_batch_percentage);
+
+    max_batches_per_service = (NvU64)uvm_perf_fault_service_budget_usec * 1000 / batch_ns;
+    max_batches_per_service = min(max_batches_per_service,
+                                  (NvU64)max(uvm_perf_fault_max_batches_per_service, 1u) *
+                                  UVM_FAULT_BATCH_CONTROL_MAX_BATCHES_FACTOR);
+    batch_control->max_batches_per_service = max((NvU32)max_batches_per_service, 1u);
+
+    decision = &batch_control->history[batch_control->num_decisions % UVM_FAULT_BATCH_CONTROL_HISTORY_SIZE];
+    decision->timestamp = NV_GETTIME();
+    decision->batch_size = parent_gpu->fault_buffer.max_batch_size;
+    decision->max_batches_per_service = batch_control->max_batches_per_service;
+    decision->replay_policy = replayable_faults->replay_policy;
+    decision->ns_per_fault = ns_per_fault;
+    decision->duplicate_percentage = duplicate_percentage;
+    decision->full_batch_percentage = full_batch_percentage;
+    ++batch_control->num_decisions;
+
+    memset(&batch_control->window, 0, sizeof(batch_control->window));
+}
+
+static void fault_batch_control_record(uvm_parent_gpu_t *parent_gpu,
+                                       uvm_fault_service_batch_context_t *batch_context,
+                                       NvU64 fetch_ns,
+                                       NvU64 service_ns,
+                                       NvU64 replay_ns)
+{
+    uvm_fault_batch_control_t *batch_control = &parent_gpu->fault_buffer.replayable.batch_control;
+
+    if (!batch_control->enabled)
+        return;
+
+    ++batch_control->window.num_batches;
+    if (batch_context->num_cached_faults >= parent_gpu->fault_buffer.max_batch_size)
+        ++batch_control->window.num_full_batches;
+
+    batch_control->window.num_faults += batch_context->num_cached_faults;
+    batch_control->window.num_duplicate_faults += batch_context->num_duplicate_faults;
+    batch_control->window.fetch_ns += fetch_ns;
+    batch_control->window.service_ns += service_ns;
+    batch_control->window.replay_ns += replay_ns;
+
+    if (batch_control->window.num_batches == UVM_FAULT_BATCH_CONTROL_WINDOW)
+        fault_batch_control_update(parent_gpu);
+}
+
 void uvm_parent_gpu_service_replayable_faults(uvm_parent_gpu_t *parent_gpu)
 {
     NvU32 num_replays = 0;
     NvU32 num_batches = 0;
     NvU32 num_throttled = 0;
     NV_STATUS status = NV_OK;
+    NV_STATUS lookahead_status = NV_OK;
     uvm_replayable_fault_buffer_t *replayable_faults = &parent_gpu->fault_buffer.replayable;
     uvm_fault_service_batch_context_t *batch_context = &replayable_faults->batch_service_context;
+    uvm_fault_service_batch_context_t *next_batch_context = NULL;
+    bool next_batch_fetched = false;
+    bool next_batch_ready = false;
 
     uvm_tracker_init(&batch_context->tracker);
 
+    if (replayable_faults->pipeline.enabled) {
+        next_batch_context = &replayable_faults->pipeline.batch_service_context;
+        uvm_tracker_init(&next_batch_context->tracker);
+    }
+
     // Process all faults in the buffer
     while (1) {
+        NvU64 timestamp_start = fault_batch_control_timestamp(parent_gpu);
+        NvU64 timestamp_fetched;
+        NvU64 timestamp_serviced;
+        NvU64 lookahead_ns = 0;
+
         if (num_throttled >= uvm_perf_fault_max_throttle_per_service ||
-            num_batches >= uvm_perf_fault_max_batches_per_service) {
+            num_batches >= replayable_faults->batch_control.max_batches_per_service) {
             break;
         }
 
-        batch_context->num_invalid_prefetch_faults = 0;
-        batch_context->num_duplicate_faults        = 0;
-        batch_context->num_replays                 = 0;
-        batch_context->fatal_va_space              = NULL;
-        batch_context->fatal_gpu                   = NULL;
-        batch_context->has_throttled_faults        = false;
+        if (next_batch_ready) {
+            // The batch was already fetched and preprocessed while the
+            // previous batch was being serviced
+            swap(batch_context, next_batch_context);
+            next_batch_fetched = false;
+            next_batch_ready = false;
+        }
+        else {
+            // A batch fetched ahead that could not be serviced may have used
+            // a batch id. Keep the batch ids increasing.
+            if (next_batch_fetched) {
+                batch_context->batch_id = next_batch_context->batch_id;
+                next_batch_fetched = false;
+            }
 
-        status = fetch_fault_buffer_entries(parent_gpu, batch_context, FAULT_FETCH_MODE_BATCH_READY);
-        if (status != NV_OK)
-            break;
+            fault_batch_context_reset(batch_context);
 
-        if (batch_context->num_cached_faults == 0)
-            break;
+            status = fetch_fault_buffer_entries(parent_gpu, batch_context, FAULT_FETCH_MODE_BATCH_READY);
+            if (status != NV_OK)
+                break;
 
-        ++batch_context->batch_id;
+            if (batch_context->num_cached_faults == 0)
+                break;
 
-        status = preprocess_fault_batch(parent_gpu, batch_context);
+            ++batch_context->batch_id;
 
-        num_replays += batch_context->num_replays;
+            status = preprocess_fault_batch(parent_gpu, batch_context);
 
-        if (status == NV_WARN_MORE_PROCESSING_REQUIRED)
-            continue;
-        else if (status != NV_OK)
-            break;
+            // The replays of batches that get serviced are counted after
+            // servicing them
+            if (status != NV_OK) {
+                num_replays += batch_context->num_replays;
+
+                if (status == NV_WARN_MORE_PROCESSING_REQUIRED)
+                    continue;
+
+                break;
+            }
+        }
+
+        timestamp_fetched = fault_batch_control_timestamp(parent_gpu);
 
         status = service_fault_batch(parent_gpu, FAULT_SERVICE_MODE_REGULAR, batch_context);
 
+        timestamp_serviced = fault_batch_control_timestamp(parent_gpu);
+
         // We may have issued replays even if status != NV_OK if
         // UVM_PERF_FAULT_REPLAY_POLICY_BLOCK is being used or the fault buffer
-        // was flushed
+        // was flushed. This also counts the replays issued while preprocessing
+        // the batch.
         num_replays += batch_context->num_replays;
 
         enable_disable_prefetch_faults(parent_gpu, batch_context);
@@ -2946,6 +3709,22 @@ void uvm_parent_gpu_service_replayable_faults(uvm_parent_gpu_t *parent_gpu)
             break;
         }
 
+        // Only look ahead if the loop is going to service another batch.
+        // Faults fetched into a batch that is never serviced are not lost,
+        // since they are replayed below, but they would be serviced twice.
+        // Errors are reported after the current batch has been replayed.
+        if (next_batch_context &&
+            num_batches + 1 < replayable_faults->batch_control.max_batches_per_service &&
+            num_throttled + (batch_context->has_throttled_faults ? 1 : 0) < uvm_perf_fault_max_throttle_per_service) {
+            lookahead_status = fetch_next_fault_batch(parent_gpu, batch_context, next_batch_context, &next_batch_ready);
+            next_batch_fetched = true;
+
+            // If the batch is ready, its replays are counted once serviced
+            if (!next_batch_ready)
+                num_replays += next_batch_context->num_replays;
+            lookahead_ns = fault_batch_control_timestamp(parent_gpu) - timestamp_serviced;
+        }
+
         if (replayable_faults->replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BATCH) {
             status = push_replay_on_parent_gpu(parent_gpu, UVM_FAULT_REPLAY_TYPE_START, batch_context);
             if (status != NV_OK)
@@ -2969,6 +3748,18 @@ void uvm_parent_gpu_service_replayable_faults(uvm_parent_gpu_t *parent_gpu)
                 break;
         }
 
+        // Faults fetched ahead are accounted to this batch's fetch time
+        fault_batch_control_record(parent_gpu,
+                                   batch_context,
+                                   timestamp_fetched - timestamp_start + lookahead_ns,
+                                   timestamp_serviced - timestamp_fetched,
+                                   fault_batch_control_timestamp(parent_gpu) - timestamp_serviced - lookahead_ns);
+
+        if (lookahead_status != NV_OK) {
+            status = lookahead_status;
+            break;
+        }
+
         if (batch_context->has_throttled_faults)
             ++num_throttled;
 
@@ -2978,13 +3769,27 @@ void uvm_parent_gpu_service_replayable_faults(uvm_parent_gpu_t *parent_gpu)
     if (status == NV_WARN_MORE_PROCESSING_REQUIRED)
         status = NV_OK;
 
+    // The batch fetched ahead is not serviced if the loop exited early
+    if (next_batch_ready)
+        num_replays += next_batch_context->num_replays;
+
     // Make sure that we issue at least one replay if no replay has been
     // issued yet to avoid dropping faults that do not show up in the buffer
     if ((status == NV_OK && replayable_faults->replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_ONCE) ||
         num_replays == 0)
         status = push_replay_on_parent_gpu(parent_gpu, UVM_FAULT_REPLAY_TYPE_START, batch_context);
 
+    // The next call starts from replayable_faults->batch_service_context, which
+    // may not be the context that serviced the last batch. Carry over the last
+    // batch id.
+    if (next_batch_fetched)
+        batch_context->batch_id = next_batch_context->batch_id;
+
+    replayable_faults->batch_service_context.batch_id = batch_context->batch_id;
+
     uvm_tracker_deinit(&batch_context->tracker);
+    if (next_batch_context)
+        uvm_tracker_deinit(&next_batch_context->tracker);
 
     if (status != NV_OK)
         UVM_DBG_PRINT("Error servicing replayable faults on GPU: %s\n", uvm_parent_gpu_name(parent_gpu));
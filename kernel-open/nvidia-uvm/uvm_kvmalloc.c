@@ -246,7 +246,7 @@ static uvm_vmalloc_hdr_t *get_hdr(void *p)
     return hdr;
 }
 
-static void *alloc_internal(size_t size, bool zero_memory)
+static void *alloc_internal(size_t size, bool zero_memory, int node)
 {
     uvm_vmalloc_hdr_t *hdr;
 
@@ -259,14 +259,14 @@ static void *alloc_internal(size_t size, bool zero_memory)
 
     if (size <= UVM_KMALLOC_THRESHOLD) {
         if (zero_memory)
-            return kzalloc(size, NV_UVM_GFP_FLAGS);
-        return kmalloc(size, NV_UVM_GFP_FLAGS);
+            return kzalloc_node(size, NV_UVM_GFP_FLAGS, node);
+        return kmalloc_node(size, NV_UVM_GFP_FLAGS, node);
     }
 
     if (zero_memory)
-        hdr = vzalloc(sizeof(*hdr) + size);
+        hdr = vzalloc_node(sizeof(*hdr) + size, node);
     else
-        hdr = vmalloc(sizeof(*hdr) + size);
+        hdr = vmalloc_node(sizeof(*hdr) + size, node);
 
     if (!hdr)
         return NULL;
@@ -275,9 +275,9 @@ static void *alloc_internal(size_t size, bool zero_memory)
     return hdr->ptr;
 }
 
-void *__uvm_kvmalloc(size_t size, const char *file, int line, const char *function)
+void *__uvm_kvmalloc_node(size_t size, int node, const char *file, int line, const char *function)
 {
-    void *p = alloc_internal(size, false);
+    void *p = alloc_internal(size, false, node);
 
     if (uvm_leak_checker && p)
         alloc_tracking_add(p, file, line, function);
@@ -285,9 +285,9 @@ void *__uvm_kvmalloc(size_t size, const char *file, int line, const char *functi
     return p;
 }
 
-void *__uvm_kvmalloc_zero(size_t size, const char *file, int line, const char *function)
+void *__uvm_kvmalloc_zero_node(size_t size, int node, const char *file, int line, const char *function)
 {
-    void *p = alloc_internal(size, true);
+    void *p = alloc_internal(size, true, node);
 
     if (uvm_leak_checker && p)
         alloc_tracking_add(p, file, line, function);
@@ -295,6 +295,16 @@ void *__uvm_kvmalloc_zero(size_t size, const char *file, int line, const char *f
     return p;
 }
 
+void *__uvm_kvmalloc(size_t size, const char *file, int line, const char *function)
+{
+    return __uvm_kvmalloc_node(size, NUMA_NO_NODE, file, line, function);
+}
+
+void *__uvm_kvmalloc_zero(size_t size, const char *file, int line, const char *function)
+{
+    return __uvm_kvmalloc_zero_node(size, NUMA_NO_NODE, file, line, function);
+}
+
 void uvm_kvfree(void *p)
 {
     if (!p)
@@ -319,7 +329,7 @@ static void *realloc_from_kmalloc(void *p, size_t new_size)
         return krealloc(p, new_size, NV_UVM_GFP_FLAGS);
 
     // kmalloc -> vmalloc
-    new_p = alloc_internal(new_size, false);
+    new_p = alloc_internal(new_size, false, NUMA_NO_NODE);
     if (!new_p)
         return NULL;
     memcpy(new_p, p, min(ksize(p), new_size));
@@ -343,7 +353,7 @@ static void *realloc_from_vmalloc(void *p, size_t new_size)
 
     // vmalloc has no realloc functionality so we need to do a separate alloc +
     // copy.
-    new_p = alloc_internal(new_size, false);
+    new_p = alloc_internal(new_size, false, NUMA_NO_NODE);
     if (!new_p)
         return NULL;
 
@@ -53,6 +53,17 @@ void *__uvm_kvmalloc_zero(size_t size, const char *file, int line, const char *f
 #define uvm_kvmalloc(__size) __uvm_kvmalloc(__size, __FILE__, __LINE__, __FUNCTION__)
 #define uvm_kvmalloc_zero(__size) __uvm_kvmalloc_zero(__size, __FILE__, __LINE__, __FUNCTION__)
 
+// Same as uvm_kvmalloc and uvm_kvmalloc_zero, but the memory is preferably
+// allocated on the given NUMA node. Allocations may fall back to other nodes.
+// NUMA_NO_NODE is equivalent to the non-node variants. The memory must be
+// freed with uvm_kvfree.
+void *__uvm_kvmalloc_node(size_t size, int node, const char *file, int line, const char *function);
+void *__uvm_kvmalloc_zero_node(size_t size, int node, const char *file, int line, const char *function);
+
+#define uvm_kvmalloc_node(__size, __node) __uvm_kvmalloc_node(__size, __node, __FILE__, __LINE__, __FUNCTION__)
+#define uvm_kvmalloc_zero_node(__size, __node) \
+    __uvm_kvmalloc_zero_node(__size, __node, __FILE__, __LINE__, __FUNCTION__)
+
 void uvm_kvfree(void *p);
 
 // Follows standard realloc semantics:
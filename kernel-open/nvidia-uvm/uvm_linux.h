@@ -46,6 +46,7 @@
 #include <linux/mm.h>
 #include <asm/barrier.h>
 #include <linux/atomic.h>
+#include <linux/completion.h>
 
 #include <asm/current.h>
 
@@ -24,7 +24,9 @@
 #include "uvm_test.h"
 #include "uvm_lock.h"
 #include "uvm_global.h"
+#include "uvm_kvmalloc.h"
 #include "uvm_thread_context.h"
+#include "uvm_va_space.h"
 
 #define UVM_LOCK_ORDER_FIRST  (UVM_LOCK_ORDER_INVALID + 1)
 #define UVM_LOCK_ORDER_SECOND (UVM_LOCK_ORDER_INVALID + 2)
@@ -410,7 +412,151 @@ static NV_STATUS test_try_locking_out_of_order(void)
     return NV_OK;
 }
 
-static NV_STATUS run_all_lock_tests(void)
+#define DOWNGRADE_CONTENTION_NUM_READERS       4
+#define DOWNGRADE_CONTENTION_NUM_ITERATIONS    1000
+#define DOWNGRADE_CONTENTION_READER_TIMEOUT_MS 1000
+
+typedef struct
+{
+    uvm_va_space_t *va_space;
+
+    // One queue per reader so that the readers run concurrently
+    nv_kthread_q_t queues[DOWNGRADE_CONTENTION_NUM_READERS];
+    nv_kthread_q_item_t q_items[DOWNGRADE_CONTENTION_NUM_READERS];
+
+    NvU32 reads_per_reader;
+
+    atomic_t writer_active;
+    atomic_t num_reads;
+    atomic_t num_errors;
+} downgrade_contention_test_t;
+
+static void downgrade_contention_reader(downgrade_contention_test_t *test)
+{
+    NvU32 i;
+
+    for (i = 0; i < test->reads_per_reader; i++) {
+        uvm_va_space_down_read(test->va_space);
+
+        if (atomic_read(&test->writer_active))
+            atomic_inc(&test->num_errors);
+
+        atomic_inc(&test->num_reads);
+
+        uvm_va_space_up_read(test->va_space);
+
+        cond_resched();
+    }
+}
+
+static void downgrade_contention_reader_entry(void *args)
+{
+    UVM_ENTRY_VOID(downgrade_contention_reader(args));
+}
+
+static void downgrade_contention_start_readers(downgrade_contention_test_t *test, NvU32 reads_per_reader)
+{
+    NvU32 i;
+
+    test->reads_per_reader = reads_per_reader;
+    atomic_set(&test->num_reads, 0);
+
+    for (i = 0; i < DOWNGRADE_CONTENTION_NUM_READERS; i++)
+        nv_kthread_q_schedule_q_item(&test->queues[i], &test->q_items[i]);
+}
+
+static void downgrade_contention_wait_readers(downgrade_contention_test_t *test)
+{
+    NvU32 i;
+
+    for (i = 0; i < DOWNGRADE_CONTENTION_NUM_READERS; i++)
+        nv_kthread_q_flush(&test->queues[i]);
+}
+
+static bool downgrade_contention_poll_reads(downgrade_contention_test_t *test, int num_reads)
+{
+    unsigned long timeout = jiffies + msecs_to_jiffies(DOWNGRADE_CONTENTION_READER_TIMEOUT_MS);
+
+    while (atomic_read(&test->num_reads) < num_reads) {
+        if (time_after(jiffies, timeout))
+            return false;
+
+        usleep_range(100, 200);
+    }
+
+    return true;
+}
+
+// Stress the VA space lock the way policy changes use it (see uvm_policy.c):
+// readers standing in for fault servicing threads have to make progress while
+// the writer holds the lock downgraded to map VA blocks and wait for GPU work,
+// and must never overlap with the exclusive section.
+static NV_STATUS test_downgrade_contention(uvm_va_space_t *va_space)
+{
+    downgrade_contention_test_t *test;
+    NV_STATUS status = NV_OK;
+    NvU32 num_queues = 0;
+    NvU32 i;
+
+    test = uvm_kvmalloc_zero(sizeof(*test));
+    if (!test)
+        return NV_ERR_NO_MEMORY;
+
+    test->va_space = va_space;
+
+    for (; num_queues < DOWNGRADE_CONTENTION_NUM_READERS; num_queues++) {
+        TEST_NV_CHECK_GOTO(errno_to_nv_status(nv_kthread_q_init(&test->queues[num_queues], "uvm_lock_test")),
+                           done);
+        nv_kthread_q_item_init(&test->q_items[num_queues], downgrade_contention_reader_entry, test);
+    }
+
+    // Readers get the lock while the downgraded writer still holds it
+    uvm_va_space_down_write(va_space);
+    uvm_va_space_downgrade_write(va_space);
+
+    downgrade_contention_start_readers(test, 1);
+    if (!downgrade_contention_poll_reads(test, DOWNGRADE_CONTENTION_NUM_READERS))
+        status = NV_ERR_TIMEOUT;
+
+    uvm_va_space_up_read(va_space);
+    downgrade_contention_wait_readers(test);
+
+    TEST_NV_CHECK_GOTO(status, done);
+
+    // Readers contending with a writer repeatedly taking the lock exclusively
+    // and downgrading it
+    downgrade_contention_start_readers(test, DOWNGRADE_CONTENTION_NUM_ITERATIONS);
+
+    for (i = 0; i < DOWNGRADE_CONTENTION_NUM_ITERATIONS; i++) {
+        uvm_va_space_down_write(va_space);
+
+        atomic_set(&test->writer_active, 1);
+        cpu_relax();
+        atomic_set(&test->writer_active, 0);
+
+        uvm_va_space_downgrade_write(va_space);
+        uvm_va_space_up_read(va_space);
+
+        cond_resched();
+    }
+
+    downgrade_contention_wait_readers(test);
+
+    TEST_CHECK_GOTO(atomic_read(&test->num_errors) == 0, done);
+    TEST_CHECK_GOTO(atomic_read(&test->num_reads) ==
+                    DOWNGRADE_CONTENTION_NUM_READERS * DOWNGRADE_CONTENTION_NUM_ITERATIONS,
+                    done);
+
+done:
+    for (i = 0; i < num_queues; i++)
+        nv_kthread_q_stop(&test->queues[i]);
+
+    uvm_kvfree(test);
+
+    return status;
+}
+
+static NV_STATUS run_all_lock_tests(uvm_va_space_t *va_space)
 {
     // The test needs all locks to be released initially
     TEST_CHECK_RET(__uvm_thread_check_all_unlocked());
@@ -435,6 +581,7 @@ static NV_STATUS run_all_lock_tests(void)
     TEST_CHECK_RET(test_downgrading_when_different_instance_held() == NV_OK);
     TEST_CHECK_RET(test_downgrading_when_locked_as_shared() == NV_OK);
     TEST_CHECK_RET(test_try_locking_out_of_order() == NV_OK);
+    TEST_CHECK_RET(test_downgrade_contention(va_space) == NV_OK);
 
     return NV_OK;
 }
@@ -452,7 +599,7 @@ NV_STATUS uvm_test_lock_sanity(UVM_TEST_LOCK_SANITY_PARAMS *params, struct file
     // code.
     uvm_thread_context_save(&thread_context_wrapper_backup.context);
 
-    status = run_all_lock_tests();
+    status = run_all_lock_tests(uvm_va_space_get(filp));
 
     uvm_thread_context_restore(&thread_context_wrapper_backup.context);
 
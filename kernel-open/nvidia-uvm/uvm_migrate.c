@@ -57,9 +57,17 @@ module_param(uvm_perf_migrate_cpu_preunmap_enable, int, S_IRUGO);
 static unsigned uvm_perf_migrate_cpu_preunmap_block_order = UVM_PERF_MIGRATE_CPU_PREUNMAP_BLOCK_ORDER_DEFAULT;
 module_param(uvm_perf_migrate_cpu_preunmap_block_order, uint, S_IRUGO);
 
+// When migrating a range spanning multiple VA blocks, use a different channel
+// hint for each block so that the copies of consecutive blocks are spread
+// across the channels of the CE pool instead of being queued on the first
+// channel with free GPFIFO entries.
+static int uvm_perf_migrate_spread_channels = 1;
+module_param(uvm_perf_migrate_spread_channels, int, S_IRUGO);
+
 // Global post-processed values of the module parameters
 static bool g_uvm_perf_migrate_cpu_preunmap_enable __read_mostly;
 static NvU64 g_uvm_perf_migrate_cpu_preunmap_size __read_mostly;
+static bool g_uvm_perf_migrate_spread_channels __read_mostly;
 
 static bool is_migration_single_block(uvm_va_range_managed_t *first_managed_range, NvU64 base, NvU64 length)
 {
@@ -451,8 +459,10 @@ static NV_STATUS uvm_va_range_migrate_multi_block(uvm_va_range_managed_t *manage
                                                   uvm_tracker_t *out_tracker)
 {
     size_t i;
+    NV_STATUS status = NV_OK;
     const size_t first_block_index = uvm_va_range_block_index(managed_range, start);
     const size_t last_block_index = uvm_va_range_block_index(managed_range, end);
+    uvm_va_block_context_t *va_block_context = service_context->block_context;
 
     UVM_ASSERT(start >= managed_range->va_range.node.start);
     UVM_ASSERT(end  <= managed_range->va_range.node.end);
@@ -465,15 +475,21 @@ static NV_STATUS uvm_va_range_migrate_multi_block(uvm_va_range_managed_t *manage
         uvm_va_block_retry_t va_block_retry;
         uvm_va_block_region_t region;
         uvm_va_block_t *va_block;
-        NV_STATUS status = uvm_va_range_block_create(managed_range, i, &va_block);
 
+        status = uvm_va_range_block_create(managed_range, i, &va_block);
         if (status != NV_OK)
-            return status;
+            break;
 
         region = uvm_va_block_region_from_start_end(va_block,
                                                     max(start, va_block->start),
                                                     min(end, va_block->end));
 
+        // The copies of each block are tracked in out_tracker (when provided)
+        // and do not depend on each other, so they can run concurrently on
+        // different channels.
+        if (g_uvm_perf_migrate_spread_channels)
+            va_block_context->make_resident.copy_channel_hint = (NvU32)(i - first_block_index);
+
         status = UVM_VA_BLOCK_LOCK_RETRY(va_block,
                                          &va_block_retry,
                                          uvm_va_block_migrate_locked(va_block,
@@ -484,10 +500,12 @@ static NV_STATUS uvm_va_range_migrate_multi_block(uvm_va_range_managed_t *manage
                                                                      mode,
                                                                      out_tracker));
         if (status != NV_OK)
-            return status;
+            break;
     }
 
-    return NV_OK;
+    va_block_context->make_resident.copy_channel_hint = 0;
+
+    return status;
 }
 
 static NV_STATUS uvm_va_range_migrate(uvm_va_range_managed_t *managed_range,
@@ -841,6 +859,7 @@ NV_STATUS uvm_migrate_init(void)
         return status;
 
     g_uvm_perf_migrate_cpu_preunmap_enable = uvm_perf_migrate_cpu_preunmap_enable != 0;
+    g_uvm_perf_migrate_spread_channels = uvm_perf_migrate_spread_channels != 0;
 
     BUILD_BUG_ON((UVM_VA_BLOCK_SIZE) & (UVM_VA_BLOCK_SIZE - 1));
 
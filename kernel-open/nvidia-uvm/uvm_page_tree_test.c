@@ -281,10 +281,12 @@ static bool assert_invalidate_range_specific(fake_tlb_invalidate_t *inval,
     return true;
 }
 
+// If allow_coalesced is true, the range may also be invalidated by a single
+// invalidate covering it, or by an invalidate all.
 static bool assert_invalidate_range(NvU64 base,
                                     NvU64 size,
                                     NvU64 page_size,
-                                    bool allow_inval_all,
+                                    bool allow_coalesced,
                                     NvU32 range_depth,
                                     NvU32 all_depth,
                                     bool expected_membar)
@@ -305,8 +307,19 @@ static bool assert_invalidate_range(NvU64 base,
             return assert_invalidate_range_specific(inval, base, size, page_size, range_depth, expected_membar);
     }
 
-    if (g_fake_invals_count == 1 && allow_inval_all)
+    if (g_fake_invals_count == 1 && allow_coalesced) {
+        fake_tlb_invalidate_t *inval = &g_fake_invals[0];
+
+        if (inval->size != -1 && inval->base <= base && base + size <= inval->base + inval->size)
+            return assert_invalidate_range_specific(inval,
+                                                    inval->base,
+                                                    inval->size,
+                                                    page_size,
+                                                    all_depth,
+                                                    expected_membar);
+
         return assert_last_invalidate_all(all_depth, expected_membar);
+    }
 
     UVM_TEST_PRINT("Couldn't find an invalidate for range [0x%llx, 0x%llx) in:\n", base, base + size);
     for (i = 0; i < g_fake_invals_count; ++i) {
@@ -1356,12 +1369,12 @@ static NV_STATUS test_tlb_batch_invalidates_case(uvm_page_tree_t *tree,
         for (j = 0; j < i; ++j) {
             NvU64 used_max_page_size = (j & 1) ? max_page_size : min_page_size;
             NvU32 expected_range_depth = tree->hal->page_table_depth(used_max_page_size);
-            bool allow_inval_all = (total_pages > gpu->parent->tlb_batch.max_pages) ||
+            bool allow_coalesced = (total_pages > gpu->parent->tlb_batch.max_pages) ||
                                    (i > UVM_TLB_BATCH_MAX_ENTRIES);
             TEST_CHECK_RET(assert_invalidate_range(base + (NvU64)j * 2 * size,
                                                    size,
                                                    min_page_size,
-                                                   allow_inval_all,
+                                                   allow_coalesced,
                                                    expected_range_depth,
                                                    expected_inval_all_depth,
                                                    false));
@@ -1375,6 +1388,46 @@ static NV_STATUS test_tlb_batch_invalidates_case(uvm_page_tree_t *tree,
     return status;
 }
 
+// Adjacent and overlapping ranges are merged into a single range invalidate
+static NV_STATUS test_tlb_batch_invalidates_adjacent(uvm_page_tree_t *tree, NvU64 page_size)
+{
+    NV_STATUS status = NV_OK;
+    uvm_push_t push;
+    uvm_tlb_batch_t batch;
+    NvU32 expected_depth = tree->hal->page_table_depth(page_size);
+    int i;
+
+    MEM_NV_CHECK_RET(uvm_push_begin_fake(tree->gpu, &push), NV_OK);
+
+    fake_tlb_invals_enable();
+
+    uvm_tlb_batch_begin(tree, &batch);
+
+    // More adjacent ranges than the batch can track
+    for (i = 0; i < 2 * UVM_TLB_BATCH_MAX_ENTRIES; ++i)
+        uvm_tlb_batch_invalidate(&batch, (NvU64)i * page_size, page_size, page_size, UVM_MEMBAR_NONE);
+
+    // Overlapping range
+    uvm_tlb_batch_invalidate(&batch, page_size, 2 * page_size, page_size, UVM_MEMBAR_NONE);
+
+    uvm_tlb_batch_end(&batch, &push, UVM_MEMBAR_NONE);
+
+    TEST_CHECK_GOTO(g_fake_invals_count == 1, done);
+    TEST_CHECK_GOTO(assert_invalidate_range(0,
+                                            2 * UVM_TLB_BATCH_MAX_ENTRIES * page_size,
+                                            page_size,
+                                            false,
+                                            expected_depth,
+                                            expected_depth,
+                                            false), done);
+
+done:
+    fake_tlb_invals_disable();
+    uvm_push_end_fake(&push);
+
+    return status;
+}
+
 static NV_STATUS test_tlb_batch_invalidates(uvm_gpu_t *gpu, const NvU64 *page_sizes, const NvU32 page_sizes_count)
 {
     NV_STATUS status = NV_OK;
@@ -1388,6 +1441,9 @@ static NV_STATUS test_tlb_batch_invalidates(uvm_gpu_t *gpu, const NvU64 *page_si
 
     MEM_NV_CHECK_RET(test_page_tree_init(gpu, &tree), NV_OK);
 
+    for (min_index = 0; min_index < page_sizes_count; ++min_index)
+        TEST_CHECK_GOTO(test_tlb_batch_invalidates_adjacent(&tree, page_sizes[min_index]) == NV_OK, done);
+
     for (min_index = 0; min_index < page_sizes_count; ++min_index) {
         for (max_index = min_index; max_index < page_sizes_count; ++max_index) {
             for (size_index = 0; size_index < ARRAY_SIZE(sizes_in_max_pages); ++size_index) {
@@ -94,6 +94,7 @@ void uvm_perf_heuristics_stop(uvm_va_space_t *va_space)
 
     // Prefetch heuristics don't need a stop operation for now
     uvm_perf_thrashing_stop(va_space);
+    uvm_perf_access_counters_stop(va_space);
 }
 
 void uvm_perf_heuristics_unload(uvm_va_space_t *va_space)
@@ -55,14 +55,38 @@ static unsigned uvm_perf_prefetch_threshold  = UVM_PREFETCH_THRESHOLD_DEFAULT;
 // logic
 static unsigned uvm_perf_prefetch_min_faults = UVM_PREFETCH_MIN_FAULTS_DEFAULT;
 
+// Enable/disable the stream prefetcher by default in new VA spaces. The stream
+// prefetcher detects sequential and strided streams of faulted VA blocks and
+// prefetches the VA blocks ahead of them. It can be toggled per VA space with
+// UVM_TEST_SET_PAGE_PREFETCH_POLICY.
+static unsigned uvm_perf_prefetch_stream = 0;
+
+#define UVM_PREFETCH_STREAM_DEPTH_MIN     1
+#define UVM_PREFETCH_STREAM_DEPTH_DEFAULT 2
+#define UVM_PREFETCH_STREAM_DEPTH_MAX     UVM_PERF_PREFETCH_STREAM_MAX_PENDING
+
+// Number of VA blocks prefetched ahead of a confirmed stream
+static unsigned uvm_perf_prefetch_stream_depth = UVM_PREFETCH_STREAM_DEPTH_DEFAULT;
+
+// Number of VA blocks that need to follow the same stride before the stream
+// is considered confirmed
+#define UVM_PREFETCH_STREAM_MIN_CONFIDENCE 2
+
+// Maximum distance, in VA blocks, between consecutive VA blocks of a stream
+#define UVM_PREFETCH_STREAM_MAX_STRIDE 16
+
 // Module parameters for the tunables
 module_param(uvm_perf_prefetch_enable, uint, S_IRUGO);
 module_param(uvm_perf_prefetch_threshold, uint, S_IRUGO);
 module_param(uvm_perf_prefetch_min_faults, uint, S_IRUGO);
+module_param(uvm_perf_prefetch_stream, uint, S_IRUGO);
+module_param(uvm_perf_prefetch_stream_depth, uint, S_IRUGO);
 
 static bool g_uvm_perf_prefetch_enable;
 static unsigned g_uvm_perf_prefetch_threshold;
 static unsigned g_uvm_perf_prefetch_min_faults;
+static bool g_uvm_perf_prefetch_stream;
+static unsigned g_uvm_perf_prefetch_stream_depth;
 
 void uvm_perf_prefetch_bitmap_tree_iter_init(const uvm_perf_prefetch_bitmap_tree_t *bitmap_tree,
                                              uvm_page_index_t page_index,
@@ -356,6 +380,116 @@ static bool should_apply_prefetch_logic(const uvm_va_policy_t *policy,
     return false;
 }
 
+static bool stream_prefetch_enabled(uvm_va_space_t *va_space)
+{
+    return va_space->test.page_prefetch_stream_enabled;
+}
+
+// Queue the VA blocks ahead of the stream that have not been prefetched yet.
+static void stream_queue_prefetches(uvm_perf_prefetch_streams_t *streams, uvm_perf_prefetch_stream_t *stream)
+{
+    NvU32 k;
+
+    for (k = stream->blocks_ahead + 1; k <= g_uvm_perf_prefetch_stream_depth; ++k) {
+        NvS64 block_index = (NvS64)stream->last_block_index + (NvS64)k * stream->stride;
+        uvm_perf_prefetch_stream_request_t *request;
+
+        if (block_index < 0 || block_index > (NvS64)(U64_MAX / UVM_VA_BLOCK_SIZE))
+            break;
+
+        if (streams->num_pending == UVM_PERF_PREFETCH_STREAM_MAX_PENDING)
+            break;
+
+        request = &streams->pending[streams->num_pending++];
+        request->address = (NvU64)block_index * UVM_VA_BLOCK_SIZE;
+        request->residency = stream->residency;
+
+        stream->blocks_ahead = k;
+    }
+}
+
+// Feed a fault-driven migration of the VA block to new_residency to the stream
+// detector. The fault either continues a known stream (possibly skipping VA
+// blocks that were prefetched and didn't fault), establishes the stride of a
+// nearby stream, or starts a new stream replacing the least recently used one.
+static void stream_detector_update(uvm_va_block_t *va_block, uvm_processor_id_t new_residency)
+{
+    uvm_va_space_t *va_space = uvm_va_block_get_va_space(va_block);
+    uvm_perf_prefetch_streams_t *streams = &va_space->prefetch_streams;
+    NvU64 block_index = UVM_ALIGN_DOWN(va_block->start, UVM_VA_BLOCK_SIZE) / UVM_VA_BLOCK_SIZE;
+    uvm_perf_prefetch_stream_t *stream = NULL;
+    uvm_perf_prefetch_stream_t *nearby = NULL;
+    uvm_perf_prefetch_stream_t *lru = &streams->streams[0];
+    NvU32 steps = 0;
+    NvU32 i;
+
+    uvm_spin_lock(&streams->lock);
+
+    ++streams->clock;
+
+    for (i = 0; i < UVM_PERF_PREFETCH_STREAM_COUNT; ++i) {
+        uvm_perf_prefetch_stream_t *current = &streams->streams[i];
+        NvS64 distance;
+
+        if (current->last_update < lru->last_update)
+            lru = current;
+
+        if (current->last_update == 0 || !uvm_id_equal(current->residency, new_residency))
+            continue;
+
+        distance = (NvS64)(block_index - current->last_block_index);
+
+        // More faults on the last VA block of the stream
+        if (distance == 0) {
+            current->last_update = streams->clock;
+            goto done;
+        }
+
+        if (current->stride != 0 && distance % current->stride == 0) {
+            NvS64 stride_steps = distance / current->stride;
+
+            if (stride_steps >= 1 && stride_steps <= current->blocks_ahead + 1) {
+                stream = current;
+                steps = stride_steps;
+                break;
+            }
+        }
+
+        if (distance >= -UVM_PREFETCH_STREAM_MAX_STRIDE &&
+            distance <= UVM_PREFETCH_STREAM_MAX_STRIDE &&
+            (!nearby || current->last_update > nearby->last_update))
+            nearby = current;
+    }
+
+    if (stream) {
+        stream->blocks_ahead = stream->blocks_ahead > steps ? stream->blocks_ahead - steps : 0;
+        stream->last_block_index = block_index;
+        stream->last_update = streams->clock;
+        UVM_PERF_SATURATING_INC(stream->confidence);
+
+        if (stream->confidence >= UVM_PREFETCH_STREAM_MIN_CONFIDENCE)
+            stream_queue_prefetches(streams, stream);
+    }
+    else if (nearby) {
+        nearby->stride = (NvS32)(block_index - nearby->last_block_index);
+        nearby->confidence = 1;
+        nearby->blocks_ahead = 0;
+        nearby->last_block_index = block_index;
+        nearby->last_update = streams->clock;
+    }
+    else {
+        lru->last_block_index = block_index;
+        lru->stride = 0;
+        lru->confidence = 0;
+        lru->blocks_ahead = 0;
+        lru->residency = new_residency;
+        lru->last_update = streams->clock;
+    }
+
+done:
+    uvm_spin_unlock(&streams->lock);
+}
+
 // Within a block we only allow prefetching to a single processor. Therefore,
 // if two processors are accessing non-overlapping regions within the same
 // block they won't benefit from prefetching.
@@ -380,6 +514,13 @@ static NvU32 uvm_perf_prefetch_prenotify_fault_migrations(uvm_va_block_t *va_blo
         va_block->prefetch_info.fault_migrations_to_last_proc = 0;
     }
 
+    // The stream prefetcher only looks ahead of migrations to GPUs, and only
+    // prefetches whole VA blocks, which HMM blocks may not map to.
+    if (UVM_ID_IS_GPU(new_residency) &&
+        !uvm_va_block_is_hmm(va_block) &&
+        stream_prefetch_enabled(uvm_va_block_get_va_space(va_block)))
+        stream_detector_update(va_block, new_residency);
+
     // Compute the expanded region that prefetching is allowed from.
     if (uvm_va_block_is_hmm(va_block)) {
         max_prefetch_region = uvm_hmm_get_prefetch_region(va_block,
@@ -542,6 +683,97 @@ void uvm_perf_prefetch_get_hint_va_block(uvm_va_block_t *va_block,
     }
 }
 
+static NV_STATUS stream_prefetch_block_locked(uvm_va_block_t *va_block,
+                                              uvm_va_block_retry_t *va_block_retry,
+                                              uvm_service_block_context_t *service_context,
+                                              uvm_processor_id_t residency)
+{
+    // Do not prefetch VA blocks with thrashing pages. Thrashing mitigation
+    // may be pinning or throttling them.
+    if (uvm_perf_thrashing_get_thrashing_pages(va_block))
+        return NV_OK;
+
+    return uvm_va_block_migrate_locked(va_block,
+                                       va_block_retry,
+                                       service_context,
+                                       uvm_va_block_region_from_block(va_block),
+                                       residency,
+                                       UVM_MIGRATE_MODE_MAKE_RESIDENT_AND_MAP,
+                                       NULL);
+}
+
+// Migrate the VA block containing address to residency, and map it there.
+static void stream_prefetch_block(uvm_va_space_t *va_space,
+                                  uvm_service_block_context_t *service_context,
+                                  NvU64 address,
+                                  uvm_processor_id_t residency)
+{
+    uvm_va_range_managed_t *managed_range = uvm_va_range_managed_find(va_space, address);
+    uvm_va_block_retry_t va_block_retry;
+    uvm_va_block_t *va_block;
+    const uvm_va_policy_t *policy;
+    NV_STATUS status;
+
+    // The stream may have run past the end of the allocation
+    if (!managed_range)
+        return;
+
+    // Do not prefetch out of the preferred location, as in
+    // should_apply_prefetch_logic()
+    policy = &managed_range->policy;
+    if (UVM_ID_IS_VALID(policy->preferred_location) && !uvm_id_equal(policy->preferred_location, residency))
+        return;
+
+    // The GPU VA space may have been unregistered since the request was queued
+    if (!uvm_processor_mask_test(&va_space->registered_gpu_va_spaces, residency))
+        return;
+
+    status = uvm_va_range_block_create(managed_range, uvm_va_range_block_index(managed_range, address), &va_block);
+    if (status != NV_OK)
+        return;
+
+    if (!uvm_range_group_all_migratable(va_space, va_block->start, va_block->end))
+        return;
+
+    // Prefetching is best effort
+    (void)UVM_VA_BLOCK_LOCK_RETRY(va_block,
+                                  &va_block_retry,
+                                  stream_prefetch_block_locked(va_block, &va_block_retry, service_context, residency));
+}
+
+void uvm_perf_prefetch_service_streams(uvm_va_space_t *va_space, uvm_service_block_context_t *service_context)
+{
+    uvm_perf_prefetch_streams_t *streams = &va_space->prefetch_streams;
+    uvm_perf_prefetch_stream_request_t requests[UVM_PERF_PREFETCH_STREAM_MAX_PENDING];
+    NvU32 num_requests;
+    NvU32 i;
+
+    uvm_assert_rwsem_locked(&va_space->lock);
+
+    // Racy check to skip taking the lock in the common case
+    if (READ_ONCE(streams->num_pending) == 0)
+        return;
+
+    uvm_spin_lock(&streams->lock);
+    num_requests = streams->num_pending;
+    memcpy(requests, streams->pending, num_requests * sizeof(requests[0]));
+    streams->num_pending = 0;
+    uvm_spin_unlock(&streams->lock);
+
+    // The migration path is shared with fault servicing, which checks the
+    // prefetch hint
+    service_context->prefetch_hint.residency = UVM_ID_INVALID;
+
+    for (i = 0; i < num_requests; ++i)
+        stream_prefetch_block(va_space, service_context, requests[i].address, requests[i].residency);
+}
+
+void uvm_perf_prefetch_init_va_space(uvm_va_space_t *va_space)
+{
+    uvm_spin_lock_init(&va_space->prefetch_streams.lock, UVM_LOCK_ORDER_LEAF);
+    va_space->test.page_prefetch_stream_enabled = g_uvm_perf_prefetch_stream;
+}
+
 NV_STATUS uvm_perf_prefetch_init(void)
 {
     g_uvm_perf_prefetch_enable = uvm_perf_prefetch_enable != 0;
@@ -572,6 +804,20 @@ NV_STATUS uvm_perf_prefetch_init(void)
         g_uvm_perf_prefetch_min_faults = UVM_PREFETCH_MIN_FAULTS_DEFAULT;
     }
 
+    g_uvm_perf_prefetch_stream = uvm_perf_prefetch_stream != 0;
+
+    if (uvm_perf_prefetch_stream_depth >= UVM_PREFETCH_STREAM_DEPTH_MIN &&
+        uvm_perf_prefetch_stream_depth <= UVM_PREFETCH_STREAM_DEPTH_MAX) {
+        g_uvm_perf_prefetch_stream_depth = uvm_perf_prefetch_stream_depth;
+    }
+    else {
+        UVM_INFO_PRINT("Invalid value %u for uvm_perf_prefetch_stream_depth. Using %u instead\n",
+                       uvm_perf_prefetch_stream_depth,
+                       UVM_PREFETCH_STREAM_DEPTH_DEFAULT);
+
+        g_uvm_perf_prefetch_stream_depth = UVM_PREFETCH_STREAM_DEPTH_DEFAULT;
+    }
+
     return NV_OK;
 }
 
@@ -586,8 +832,12 @@ NV_STATUS uvm_test_set_page_prefetch_policy(UVM_TEST_SET_PAGE_PREFETCH_POLICY_PA
 
     if (params->policy == UVM_TEST_PAGE_PREFETCH_POLICY_ENABLE)
         va_space->test.page_prefetch_enabled = true;
-    else
+    else if (params->policy == UVM_TEST_PAGE_PREFETCH_POLICY_DISABLE)
         va_space->test.page_prefetch_enabled = false;
+    else if (params->policy == UVM_TEST_PAGE_PREFETCH_POLICY_STREAM_ENABLE)
+        va_space->test.page_prefetch_stream_enabled = true;
+    else
+        va_space->test.page_prefetch_stream_enabled = false;
 
     uvm_va_space_up_write(va_space);
 
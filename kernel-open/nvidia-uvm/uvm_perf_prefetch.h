@@ -25,6 +25,7 @@
 #define __UVM_PERF_PREFETCH_H__
 
 #include "uvm_linux.h"
+#include "uvm_lock.h"
 #include "uvm_processors.h"
 #include "uvm_va_block_types.h"
 
@@ -58,9 +59,80 @@ typedef struct
     uvm_page_index_t node_idx;
 } uvm_perf_prefetch_bitmap_tree_iter_t;
 
+// Number of streams tracked per VA space by the stream prefetcher
+#define UVM_PERF_PREFETCH_STREAM_COUNT 8
+
+// Maximum number of VA blocks waiting to be prefetched per VA space
+#define UVM_PERF_PREFETCH_STREAM_MAX_PENDING 16
+
+// Sequence of faulted VA blocks separated by a constant stride, in VA block
+// units. Positive strides are forward streams and negative strides are
+// backward streams.
+typedef struct
+{
+    // Index (address / UVM_VA_BLOCK_SIZE) of the last faulted VA block in the
+    // stream
+    NvU64 last_block_index;
+
+    // Distance between consecutive VA blocks in the stream. 0 if the stream
+    // only has one VA block so far.
+    NvS32 stride;
+
+    // Number of consecutive VA blocks that followed the stride
+    NvU32 confidence;
+
+    // Number of VA blocks past last_block_index that have already been
+    // prefetched. Prefetched VA blocks are not expected to fault, so the next
+    // fault in the stream may be up to blocks_ahead + 1 strides away.
+    NvU32 blocks_ahead;
+
+    // Processor the VA blocks in the stream are migrated to
+    uvm_processor_id_t residency;
+
+    // Value of the detector clock when the stream was last updated. 0 if the
+    // entry is not in use. Used to replace the least recently used stream.
+    NvU64 last_update;
+} uvm_perf_prefetch_stream_t;
+
+typedef struct
+{
+    NvU64 address;
+
+    uvm_processor_id_t residency;
+} uvm_perf_prefetch_stream_request_t;
+
+// Per-VA space stream detector. Streams are trained from the fault-driven
+// migrations to GPUs, and the VA blocks ahead of confirmed streams are queued
+// in pending, to be migrated by uvm_perf_prefetch_service_streams once the
+// faulting VA block has been serviced.
+typedef struct
+{
+    // Protects all the fields below
+    uvm_spinlock_t lock;
+
+    uvm_perf_prefetch_stream_t streams[UVM_PERF_PREFETCH_STREAM_COUNT];
+
+    NvU64 clock;
+
+    uvm_perf_prefetch_stream_request_t pending[UVM_PERF_PREFETCH_STREAM_MAX_PENDING];
+
+    NvU32 num_pending;
+} uvm_perf_prefetch_streams_t;
+
 // Global initialization function (no clean up needed).
 NV_STATUS uvm_perf_prefetch_init(void);
 
+// Initialize the per-VA space prefetch state (no clean up needed).
+void uvm_perf_prefetch_init_va_space(uvm_va_space_t *va_space);
+
+// Migrate the VA blocks queued by the stream prefetcher, if any.
+// service_context must not be in use by the caller. Prefetching is best
+// effort, so errors are not reported.
+//
+// Locking: The caller must hold the va_space lock and the mm, if any, must be
+// retained and locked for at least read. No VA block lock may be held.
+void uvm_perf_prefetch_service_streams(uvm_va_space_t *va_space, uvm_service_block_context_t *service_context);
+
 // Returns whether prefetching is enabled in the VA space.
 // va_space cannot be NULL.
 bool uvm_perf_prefetch_enabled(uvm_va_space_t *va_space);
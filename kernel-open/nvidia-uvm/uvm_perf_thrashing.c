@@ -140,6 +140,56 @@ typedef struct
     struct list_head             va_block_list_entry;
 } pinned_page_t;
 
+typedef enum
+{
+    RANGE_THRASHING_PATTERN_NONE = 0,
+
+    // Thrashing pages are (almost) only read. Read accesses anywhere in the
+    // range read-duplicate the page on the accessing processor.
+    RANGE_THRASHING_PATTERN_SHARED_READ,
+
+    // A single processor writes to the thrashing pages while the rest read
+    // them. Pages are pinned on the producer and mapped remotely by the
+    // consumers.
+    RANGE_THRASHING_PATTERN_PRODUCER_CONSUMER,
+
+    // Several processors write to the thrashing pages. Pages are pinned on a
+    // location that all of them can access.
+    RANGE_THRASHING_PATTERN_PING_PONG,
+} range_thrashing_pattern_t;
+
+// Per-managed range thrashing model. Thrashing detected in any VA block of the
+// range is accumulated here and, once enough samples have been collected, the
+// whole range is classified. From then on, faults on VA blocks of the range
+// apply the mitigation for the pattern right away instead of going through
+// per-page detection in every block. This state is protected by the per-VA
+// space ranges.lock.
+typedef struct
+{
+    range_thrashing_pattern_t                pattern;
+
+    // Location on which pages are pinned for the PRODUCER_CONSUMER and
+    // PING_PONG patterns
+    uvm_processor_id_t                 pin_residency;
+
+    // Processors that have been thrashing on the range. They are mapped
+    // remotely when pages are pinned.
+    uvm_processor_mask_t                  processors;
+
+    // Processors that wrote to thrashing pages in the current sampling window
+    uvm_processor_mask_t                     writers;
+
+    // Number of accesses to thrashing pages sampled in the current window, and
+    // how many of them were read-only
+    NvU32                                num_samples;
+
+    NvU32                           num_read_samples;
+
+    // Last time stamp when thrashing was sampled on the range. The pattern is
+    // dropped if no thrashing is sampled for an epoch.
+    NvU64                            last_time_stamp;
+} range_thrashing_info_t;
+
 // Per-VA space data structures and policy configuration
 typedef struct
 {
@@ -172,6 +222,15 @@ typedef struct
         bool                    in_va_space_teardown;
     } pinned_pages;
 
+    struct
+    {
+        // Protects the creation and the contents of the range_thrashing_info_t
+        // of all managed ranges in the VA space. The callers only hold the VA
+        // space lock in read mode and the lock of one of the VA blocks in the
+        // range.
+        uvm_spinlock_t                          lock;
+    } ranges;
+
     struct
     {
         // Whether thrashing mitigation is enabled on this VA space
@@ -196,6 +255,8 @@ typedef struct
 
         unsigned                          max_resets;
 
+        unsigned                       range_samples;
+
         NvU64                                 pin_ns;
 
         NvS8                              lapse_stat;
@@ -220,6 +281,14 @@ typedef struct
 
     // Number of times a page was pinned on a different processor while thrashing
     atomic64_t num_pin_remote;
+
+    // Number of times a page was read-duplicated because its range was
+    // classified as shared-read
+    atomic64_t num_range_read_dup;
+
+    // Number of times a page was pinned because its range was classified as
+    // producer-consumer or ping-pong, before any thrashing was detected on it
+    atomic64_t num_range_pin;
 } processor_thrashing_stats_t;
 
 // Pre-allocated thrashing stats structure for the CPU. This is only valid if
@@ -315,6 +384,18 @@ static unsigned uvm_perf_thrashing_pin = UVM_PERF_THRASHING_PIN_DEFAULT;
 
 static unsigned uvm_perf_thrashing_max_resets = UVM_PERF_THRASHING_MAX_RESETS_DEFAULT;
 
+// Number of accesses to thrashing pages of a managed range after which the
+// range is classified as a whole (shared-read, producer-consumer or
+// ping-pong), so that the rest of its VA blocks apply the mitigation without
+// having to detect thrashing first. 0 disables range-level classification.
+#define UVM_PERF_THRASHING_RANGE_SAMPLES_DEFAULT 0
+
+static unsigned uvm_perf_thrashing_range_samples = UVM_PERF_THRASHING_RANGE_SAMPLES_DEFAULT;
+
+// A range is considered shared-read if at most 1/UVM_PERF_THRASHING_RANGE_READ_RATIO
+// of the sampled accesses are writes
+#define UVM_PERF_THRASHING_RANGE_READ_RATIO 16
+
 // Module parameters for the tunables
 module_param(uvm_perf_thrashing_enable,        uint, S_IRUGO);
 module_param(uvm_perf_thrashing_threshold,     uint, S_IRUGO);
@@ -325,6 +406,7 @@ module_param(uvm_perf_thrashing_nap,           uint, S_IRUGO);
 module_param(uvm_perf_thrashing_epoch,         uint, S_IRUGO);
 module_param(uvm_perf_thrashing_pin,           uint, S_IRUGO);
 module_param(uvm_perf_thrashing_max_resets,    uint, S_IRUGO);
+module_param(uvm_perf_thrashing_range_samples, uint, S_IRUGO);
 
 // See map_remote_on_atomic_fault uvm_va_block.c
 unsigned uvm_perf_map_remote_on_native_atomics_fault = 0;
@@ -341,6 +423,7 @@ static NvU64 g_uvm_perf_thrashing_nap;
 static NvU64 g_uvm_perf_thrashing_epoch;
 static NvU64 g_uvm_perf_thrashing_pin;
 static unsigned g_uvm_perf_thrashing_max_resets;
+static unsigned g_uvm_perf_thrashing_range_samples;
 
 // Helper macros to initialize thrashing parameters from module parameters
 //
@@ -418,12 +501,17 @@ static void thrashing_block_destroy_cb(uvm_va_space_t *va_space,
 static void thrashing_block_munmap_cb(uvm_va_space_t *va_space,
                                       uvm_perf_event_t event_id,
                                       uvm_perf_event_data_t *event_data);
+static void thrashing_range_destroy_cb(uvm_va_space_t *va_space,
+                                       uvm_perf_event_t event_id,
+                                       uvm_perf_event_data_t *event_data);
 
 static uvm_perf_module_event_callback_desc_t g_callbacks_thrashing[] = {
     { UVM_PERF_EVENT_BLOCK_DESTROY, thrashing_block_destroy_cb },
     { UVM_PERF_EVENT_MODULE_UNLOAD, thrashing_block_destroy_cb },
     { UVM_PERF_EVENT_BLOCK_SHRINK , thrashing_block_destroy_cb },
     { UVM_PERF_EVENT_BLOCK_MUNMAP , thrashing_block_munmap_cb  },
+    { UVM_PERF_EVENT_RANGE_DESTROY, thrashing_range_destroy_cb },
+    { UVM_PERF_EVENT_RANGE_SHRINK , thrashing_range_destroy_cb },
     { UVM_PERF_EVENT_MIGRATION,     thrashing_event_cb         },
     { UVM_PERF_EVENT_REVOCATION,    thrashing_event_cb         }
 };
@@ -441,6 +529,8 @@ static int nv_procfs_read_thrashing_stats(struct seq_file *s, void *v)
     UVM_SEQ_OR_DBG_PRINT(s, "throttle      %llu\n", (NvU64)atomic64_read(&processor_stats->num_throttle));
     UVM_SEQ_OR_DBG_PRINT(s, "pin_local     %llu\n", (NvU64)atomic64_read(&processor_stats->num_pin_local));
     UVM_SEQ_OR_DBG_PRINT(s, "pin_remote    %llu\n", (NvU64)atomic64_read(&processor_stats->num_pin_remote));
+    UVM_SEQ_OR_DBG_PRINT(s, "range_rdup    %llu\n", (NvU64)atomic64_read(&processor_stats->num_range_read_dup));
+    UVM_SEQ_OR_DBG_PRINT(s, "range_pin     %llu\n", (NvU64)atomic64_read(&processor_stats->num_range_pin));
 
     uvm_up_read(&g_uvm_global.pm.lock);
 
@@ -604,6 +694,8 @@ static void va_space_thrashing_info_init_params(va_space_thrashing_info_t *va_sp
     }
 
     va_space_thrashing->params.max_resets    = g_uvm_perf_thrashing_max_resets;
+
+    va_space_thrashing->params.range_samples = g_uvm_perf_thrashing_range_samples;
 }
 
 // Create the thrashing detection struct for the given VA space
@@ -698,6 +790,50 @@ void uvm_perf_thrashing_info_destroy(uvm_va_block_t *va_block)
     }
 }
 
+// Allocate the per-page tracking structure of the block
+static NV_STATUS thrashing_pages_alloc(uvm_va_block_t *va_block, block_thrashing_info_t *block_thrashing)
+{
+    uvm_page_index_t page_index;
+    NvU16 num_block_pages = uvm_va_block_size(va_block) / PAGE_SIZE;
+
+    UVM_ASSERT(!block_thrashing->pages);
+
+    block_thrashing->pages = uvm_kvmalloc_zero(sizeof(*block_thrashing->pages) * num_block_pages);
+    if (!block_thrashing->pages)
+        return NV_ERR_NO_MEMORY;
+
+    for (page_index = 0; page_index < num_block_pages; ++page_index) {
+        block_thrashing->pages[page_index].pinned_residency_id = UVM_ID_INVALID;
+        block_thrashing->pages[page_index].do_not_throttle_processor_id = UVM_ID_INVALID;
+    }
+
+    return NV_OK;
+}
+
+// Get the range thrashing model of the given managed range if it exists
+//
+// The pointer may be read without holding ranges.lock, but the contents of the
+// model may only be accessed with the lock held.
+static range_thrashing_info_t *range_thrashing_info_get_or_null(uvm_va_range_managed_t *managed_range)
+{
+    return uvm_perf_module_type_data(managed_range->perf_modules_data, UVM_PERF_MODULE_TYPE_THRASHING);
+}
+
+// Destroy the range thrashing model of the given managed range
+//
+// VA space lock needs to be held in write mode
+static void range_thrashing_info_destroy(uvm_va_range_managed_t *managed_range)
+{
+    range_thrashing_info_t *range_thrashing = range_thrashing_info_get_or_null(managed_range);
+
+    uvm_assert_rwsem_locked_write(&managed_range->va_range.va_space->lock);
+
+    if (range_thrashing) {
+        uvm_perf_module_type_unset_data(managed_range->perf_modules_data, UVM_PERF_MODULE_TYPE_THRASHING);
+        uvm_kvfree(range_thrashing);
+    }
+}
+
 void thrashing_block_destroy_cb(uvm_va_space_t *va_space, uvm_perf_event_t event_id, uvm_perf_event_data_t *event_data)
 {
     uvm_va_block_t *va_block;
@@ -708,19 +844,49 @@ void thrashing_block_destroy_cb(uvm_va_space_t *va_space, uvm_perf_event_t event
                event_id == UVM_PERF_EVENT_BLOCK_SHRINK ||
                event_id == UVM_PERF_EVENT_MODULE_UNLOAD);
 
-    if (event_id == UVM_PERF_EVENT_BLOCK_DESTROY)
+    if (event_id == UVM_PERF_EVENT_BLOCK_DESTROY) {
         va_block = event_data->block_destroy.block;
-    else if (event_id == UVM_PERF_EVENT_BLOCK_SHRINK)
+    }
+    else if (event_id == UVM_PERF_EVENT_BLOCK_SHRINK) {
         va_block = event_data->block_shrink.block;
-    else
+    }
+    else {
         va_block = event_data->module_unload.block;
 
+        if (event_data->module_unload.range)
+            range_thrashing_info_destroy(event_data->module_unload.range);
+    }
+
     if (!va_block)
         return;
 
     uvm_perf_thrashing_info_destroy(va_block);
 }
 
+void thrashing_range_destroy_cb(uvm_va_space_t *va_space, uvm_perf_event_t event_id, uvm_perf_event_data_t *event_data)
+{
+    uvm_va_range_t *va_range;
+
+    UVM_ASSERT(g_uvm_perf_thrashing_enable);
+
+    UVM_ASSERT(event_id == UVM_PERF_EVENT_RANGE_DESTROY || event_id == UVM_PERF_EVENT_RANGE_SHRINK);
+
+    if (event_id == UVM_PERF_EVENT_RANGE_DESTROY) {
+        range_thrashing_info_destroy(uvm_va_range_to_managed(event_data->range_destroy.range));
+        return;
+    }
+
+    // RANGE_SHRINK is notified with the new range split off the end of the
+    // range that shrank, which immediately precedes it in the tree. The
+    // classification of the shrunk range is stale. It will be rebuilt from
+    // the thrashing seen on what is left of it.
+    va_range = uvm_va_range_find(va_space, event_data->range_shrink.range->node.start - 1);
+    UVM_ASSERT(va_range);
+    UVM_ASSERT(va_range->type == UVM_VA_RANGE_TYPE_MANAGED);
+
+    range_thrashing_info_destroy(uvm_va_range_to_managed(va_range));
+}
+
 void thrashing_block_munmap_cb(uvm_va_space_t *va_space, uvm_perf_event_t event_id, uvm_perf_event_data_t *event_data)
 {
     uvm_va_block_t *va_block = event_data->block_munmap.block;
@@ -1336,23 +1502,13 @@ void thrashing_event_cb(uvm_va_space_t *va_space, uvm_perf_event_t event_id, uvm
 
     if (!block_thrashing->pages) {
         // Don't create the per-page tracking structure unless there is some potential thrashing within the block
-        NvU16 num_block_pages;
-
         if (block_thrashing->last_time_stamp == 0 ||
             uvm_id_equal(block_thrashing->last_processor, processor_id) ||
             time_stamp - block_thrashing->last_time_stamp > va_space_thrashing->params.lapse_ns)
             goto done;
 
-        num_block_pages = uvm_va_block_size(va_block) / PAGE_SIZE;
-
-        block_thrashing->pages = uvm_kvmalloc_zero(sizeof(*block_thrashing->pages) * num_block_pages);
-        if (!block_thrashing->pages)
+        if (thrashing_pages_alloc(va_block, block_thrashing) != NV_OK)
             goto done;
-
-        for (page_index = 0; page_index < num_block_pages; ++page_index) {
-            block_thrashing->pages[page_index].pinned_residency_id = UVM_ID_INVALID;
-            block_thrashing->pages[page_index].do_not_throttle_processor_id = UVM_ID_INVALID;
-        }
     }
 
     region = uvm_va_block_region_from_start_size(va_block, address, bytes);
@@ -1643,6 +1799,283 @@ static void adjust_thrashing_lapse(va_space_thrashing_info_t *ti, NvU64 lapse)
     ti->params.lapse_stat /= 2;
 }
 
+static void range_thrashing_reset(range_thrashing_info_t *range_thrashing)
+{
+    range_thrashing->pattern          = RANGE_THRASHING_PATTERN_NONE;
+    range_thrashing->pin_residency    = UVM_ID_INVALID;
+    range_thrashing->num_samples      = 0;
+    range_thrashing->num_read_samples = 0;
+    uvm_processor_mask_zero(&range_thrashing->processors);
+    uvm_processor_mask_zero(&range_thrashing->writers);
+}
+
+// Select the location on which the pages of the range are pinned. A single
+// writer is preferred so that the producer keeps writing to local memory.
+// Otherwise, pick a location with memory that all the thrashing processors can
+// access, favoring the thrashing processors themselves.
+static uvm_processor_id_t range_thrashing_pin_residency(uvm_va_space_t *va_space,
+                                                        range_thrashing_info_t *range_thrashing,
+                                                        uvm_processor_mask_t *common_locations)
+{
+    bool is_first = true;
+    uvm_processor_id_t id;
+
+    if (uvm_processor_mask_get_count(&range_thrashing->writers) == 1) {
+        uvm_processor_id_t writer = uvm_processor_mask_find_first_id(&range_thrashing->writers);
+
+        if (uvm_processor_has_memory(writer) &&
+            uvm_processor_mask_subset(&range_thrashing->processors, &va_space->accessible_from[uvm_id_value(writer)]))
+            return writer;
+    }
+
+    uvm_processor_mask_zero(common_locations);
+
+    for_each_id_in_mask(id, &range_thrashing->processors) {
+        if (is_first)
+            uvm_processor_mask_copy(common_locations, &va_space->can_access[uvm_id_value(id)]);
+        else
+            uvm_processor_mask_and(common_locations, common_locations, &va_space->can_access[uvm_id_value(id)]);
+
+        is_first = false;
+    }
+
+    for_each_id_in_mask(id, common_locations) {
+        if (uvm_processor_mask_test(&range_thrashing->processors, id) && uvm_processor_has_memory(id))
+            return id;
+    }
+
+    for_each_id_in_mask(id, common_locations) {
+        if (uvm_processor_has_memory(id))
+            return id;
+    }
+
+    return UVM_ID_INVALID;
+}
+
+// Classify the range using the samples collected in the current window, and
+// start a new window.
+static void range_thrashing_classify(uvm_va_space_t *va_space,
+                                     range_thrashing_info_t *range_thrashing,
+                                     uvm_processor_mask_t *common_locations)
+{
+    NvU32 num_write_samples = range_thrashing->num_samples - range_thrashing->num_read_samples;
+
+    // Thrashing requires at least two processors
+    if (uvm_processor_mask_get_count(&range_thrashing->processors) > 1) {
+        if (num_write_samples * UVM_PERF_THRASHING_RANGE_READ_RATIO <= range_thrashing->num_samples) {
+            range_thrashing->pattern = RANGE_THRASHING_PATTERN_SHARED_READ;
+            range_thrashing->pin_residency = UVM_ID_INVALID;
+        }
+        else {
+            range_thrashing->pin_residency = range_thrashing_pin_residency(va_space, range_thrashing, common_locations);
+            if (UVM_ID_IS_INVALID(range_thrashing->pin_residency))
+                range_thrashing->pattern = RANGE_THRASHING_PATTERN_NONE;
+            else if (uvm_processor_mask_get_count(&range_thrashing->writers) == 1)
+                range_thrashing->pattern = RANGE_THRASHING_PATTERN_PRODUCER_CONSUMER;
+            else
+                range_thrashing->pattern = RANGE_THRASHING_PATTERN_PING_PONG;
+        }
+    }
+
+    range_thrashing->num_samples      = 0;
+    range_thrashing->num_read_samples = 0;
+    uvm_processor_mask_zero(&range_thrashing->writers);
+}
+
+// Only faults are accounted and mitigated at range level. Access counter
+// notifications are serviced as PREFETCH accesses, which are not evidence of
+// the access pattern.
+static bool range_thrashing_is_fault(NvU32 access_type_mask)
+{
+    return uvm_fault_access_type_mask_highest(access_type_mask) != UVM_FAULT_ACCESS_TYPE_PREFETCH;
+}
+
+// Account an access to a thrashing page in the model of the range that
+// contains the VA block. The model is created on the first sample.
+static void range_thrashing_sample(va_space_thrashing_info_t *va_space_thrashing,
+                                   uvm_va_block_t *va_block,
+                                   page_thrashing_info_t *page_thrashing,
+                                   uvm_processor_id_t requester,
+                                   NvU32 access_type_mask,
+                                   NvU64 time_stamp,
+                                   uvm_processor_mask_t *common_locations)
+{
+    uvm_va_range_managed_t *managed_range;
+    range_thrashing_info_t *range_thrashing;
+
+    // TODO: Bug 5138823: [uvm] Add support for thrashing detection and
+    // mitigation for pageable memory
+    if (va_space_thrashing->params.range_samples == 0 ||
+        uvm_va_block_is_hmm(va_block) ||
+        !range_thrashing_is_fault(access_type_mask))
+        return;
+
+    managed_range = va_block->managed_range;
+
+    range_thrashing = range_thrashing_info_get_or_null(managed_range);
+    if (!range_thrashing) {
+        range_thrashing_info_t *new_range_thrashing = uvm_kvmalloc_zero(sizeof(*new_range_thrashing));
+
+        // If we don't have enough memory, the range is just not classified
+        if (!new_range_thrashing)
+            return;
+
+        range_thrashing_reset(new_range_thrashing);
+
+        uvm_spin_lock(&va_space_thrashing->ranges.lock);
+
+        range_thrashing = range_thrashing_info_get_or_null(managed_range);
+        if (!range_thrashing) {
+            uvm_perf_module_type_set_data(managed_range->perf_modules_data,
+                                          new_range_thrashing,
+                                          UVM_PERF_MODULE_TYPE_THRASHING);
+            range_thrashing = new_range_thrashing;
+            new_range_thrashing = NULL;
+        }
+
+        uvm_spin_unlock(&va_space_thrashing->ranges.lock);
+
+        // Another VA block of the range won the race
+        uvm_kvfree(new_range_thrashing);
+    }
+
+    uvm_spin_lock(&va_space_thrashing->ranges.lock);
+
+    if (range_thrashing->last_time_stamp != 0 &&
+        time_stamp - range_thrashing->last_time_stamp > va_space_thrashing->params.epoch_ns)
+        range_thrashing_reset(range_thrashing);
+
+    range_thrashing->last_time_stamp = time_stamp;
+
+    uvm_processor_mask_or(&range_thrashing->processors, &range_thrashing->processors, &page_thrashing->processors);
+
+    if (uvm_fault_access_type_mask_highest(access_type_mask) <= UVM_FAULT_ACCESS_TYPE_READ)
+        ++range_thrashing->num_read_samples;
+    else
+        uvm_processor_mask_set(&range_thrashing->writers, requester);
+
+    if (++range_thrashing->num_samples >= va_space_thrashing->params.range_samples)
+        range_thrashing_classify(va_space_thrashing->va_space, range_thrashing, common_locations);
+
+    uvm_spin_unlock(&va_space_thrashing->ranges.lock);
+}
+
+// Get the hint for a page on which no thrashing has been detected yet, using
+// the classification of the range that contains the VA block. For ranges
+// classified as SHARED_READ, read accesses are read-duplicated. For
+// PRODUCER_CONSUMER and PING_PONG ranges, the page is pinned on the range's
+// pin residency right away and the thrashing processors map it remotely.
+static uvm_perf_thrashing_hint_t thrashing_get_range_hint(va_space_thrashing_info_t *va_space_thrashing,
+                                                          uvm_va_block_t *va_block,
+                                                          uvm_va_block_context_t *va_block_context,
+                                                          uvm_page_index_t page_index,
+                                                          uvm_processor_id_t requester,
+                                                          NvU32 access_type_mask)
+{
+    uvm_perf_thrashing_hint_t hint;
+    uvm_va_space_t *va_space = va_space_thrashing->va_space;
+    range_thrashing_info_t *range_thrashing;
+    range_thrashing_pattern_t pattern;
+    uvm_processor_id_t pin_residency;
+    uvm_processor_mask_t *range_processors = &va_block_context->fast_access_mask;
+    const uvm_va_policy_t *policy;
+    block_thrashing_info_t *block_thrashing;
+    page_thrashing_info_t *page_thrashing;
+    NvU64 time_stamp;
+
+    hint.type = UVM_PERF_THRASHING_HINT_TYPE_NONE;
+
+    if (uvm_va_block_is_hmm(va_block) || !range_thrashing_is_fault(access_type_mask))
+        return hint;
+
+    range_thrashing = range_thrashing_info_get_or_null(va_block->managed_range);
+    if (!range_thrashing)
+        return hint;
+
+    time_stamp = NV_GETTIME();
+
+    uvm_spin_lock(&va_space_thrashing->ranges.lock);
+
+    if (time_stamp - range_thrashing->last_time_stamp > va_space_thrashing->params.epoch_ns)
+        range_thrashing_reset(range_thrashing);
+
+    pattern = range_thrashing->pattern;
+    pin_residency = range_thrashing->pin_residency;
+    uvm_processor_mask_copy(range_processors, &range_thrashing->processors);
+
+    uvm_spin_unlock(&va_space_thrashing->ranges.lock);
+
+    if (pattern == RANGE_THRASHING_PATTERN_NONE)
+        return hint;
+
+    policy = uvm_va_policy_get(va_block, uvm_va_block_cpu_page_address(va_block, page_index));
+
+    if (pattern == RANGE_THRASHING_PATTERN_SHARED_READ) {
+        // Explicit user policies take precedence over the range heuristics
+        if (policy->read_duplication == UVM_READ_DUPLICATION_DISABLED ||
+            UVM_ID_IS_VALID(policy->preferred_location) ||
+            uvm_fault_access_type_mask_highest(access_type_mask) > UVM_FAULT_ACCESS_TYPE_READ)
+            return hint;
+
+        PROCESSOR_THRASHING_STATS_INC(requester, num_range_read_dup);
+
+        hint.type = UVM_PERF_THRASHING_HINT_TYPE_READ_DUPLICATE;
+        return hint;
+    }
+
+    if ((UVM_ID_IS_VALID(policy->preferred_location) && !uvm_id_equal(policy->preferred_location, pin_residency)) ||
+        !uvm_processor_mask_test(&va_space->accessible_from[uvm_id_value(pin_residency)], requester))
+        return hint;
+
+    // Processors that joined the range after it was classified may not be able
+    // to access the pin residency. They keep going through regular detection.
+    uvm_processor_mask_and(range_processors, range_processors, &va_space->accessible_from[uvm_id_value(pin_residency)]);
+
+    block_thrashing = thrashing_info_get_create(va_block);
+    if (!block_thrashing)
+        return hint;
+
+    if (!block_thrashing->pages && thrashing_pages_alloc(va_block, block_thrashing) != NV_OK)
+        return hint;
+
+    page_thrashing = &block_thrashing->pages[page_index];
+    UVM_ASSERT(!page_thrashing->pinned);
+    UVM_ASSERT(uvm_processor_mask_empty(&page_thrashing->throttled_processors));
+
+    if (!thrashing_processors_can_access(va_space, page_thrashing, pin_residency))
+        return hint;
+
+    // Seed the per-page state as if thrashing had been detected on the page so
+    // that the regular pinning and unpinning paths take over from here.
+    uvm_processor_mask_or(&page_thrashing->processors, &page_thrashing->processors, range_processors);
+    uvm_processor_mask_set(&page_thrashing->processors, requester);
+    page_thrashing->num_thrashing_events = va_space_thrashing->params.threshold;
+    page_thrashing->has_migration_events = true;
+    page_thrashing_set_time_stamp(page_thrashing, time_stamp);
+    block_thrashing->last_thrashing_time_stamp = time_stamp;
+
+    thrashing_detected(va_block, block_thrashing, page_thrashing, page_index, requester);
+
+    if (thrashing_pin_page(va_space_thrashing,
+                           va_block,
+                           va_block_context,
+                           block_thrashing,
+                           page_thrashing,
+                           page_index,
+                           time_stamp,
+                           pin_residency,
+                           requester) != NV_OK)
+        return hint;
+
+    PROCESSOR_THRASHING_STATS_INC(requester, num_range_pin);
+
+    hint.type = UVM_PERF_THRASHING_HINT_TYPE_PIN;
+    hint.pin.residency = pin_residency;
+    uvm_processor_mask_copy(&hint.pin.processors, &page_thrashing->processors);
+
+    return hint;
+}
+
 // Function called on fault that tells the fault handler if any operation
 // should be performed to minimize thrashing. The logic is as follows:
 //
@@ -1661,10 +2094,16 @@ static void adjust_thrashing_lapse(va_space_thrashing_info_t *ti, NvU64 lapse)
 //   thrashing due to revocation events (mainly due to system-wide atomics). In
 //   that case we keep the page pinned while applying the same algorithm as in
 //   Phase1.
+//
+// Accesses to thrashing pages are also sampled into a per-managed range model.
+// Once the range is classified, pages of the range on which no thrashing has
+// been detected yet get the mitigation for the range pattern right away. See
+// thrashing_get_range_hint.
 uvm_perf_thrashing_hint_t uvm_perf_thrashing_get_hint(uvm_va_block_t *va_block,
                                                       uvm_va_block_context_t *va_block_context,
                                                       NvU64 address,
-                                                      uvm_processor_id_t requester)
+                                                      uvm_processor_id_t requester,
+                                                      NvU32 access_type_mask)
 {
     uvm_va_space_t *va_space = uvm_va_block_get_va_space(va_block);
     va_space_thrashing_info_t *va_space_thrashing = va_space_thrashing_info_get(va_space);
@@ -1680,16 +2119,16 @@ uvm_perf_thrashing_hint_t uvm_perf_thrashing_get_hint(uvm_va_block_t *va_block,
     if (!va_space_thrashing->params.enable)
         return hint;
 
-    // If we don't have enough memory to store thrashing information, we assume
-    // no thrashing
-    block_thrashing = thrashing_info_get(va_block);
-    if (!block_thrashing)
-        return hint;
-
     // If the per-page tracking structure has not been created yet, we assume
-    // no thrashing
-    if (!block_thrashing->pages)
-        return hint;
+    // no thrashing on the block, but the range may have been classified
+    block_thrashing = thrashing_info_get(va_block);
+    if (!block_thrashing || !block_thrashing->pages)
+        return thrashing_get_range_hint(va_space_thrashing,
+                                        va_block,
+                                        va_block_context,
+                                        page_index,
+                                        requester,
+                                        access_type_mask);
 
     time_stamp = NV_GETTIME();
 
@@ -1726,8 +2165,16 @@ uvm_perf_thrashing_hint_t uvm_perf_thrashing_get_hint(uvm_va_block_t *va_block,
     page_thrashing = &block_thrashing->pages[page_index];
 
     // Not enough thrashing events yet
-    if (page_thrashing->num_thrashing_events < va_space_thrashing->params.threshold)
-        goto done;
+    if (page_thrashing->num_thrashing_events < va_space_thrashing->params.threshold) {
+        UVM_ASSERT(!page_thrashing->pinned);
+
+        return thrashing_get_range_hint(va_space_thrashing,
+                                        va_block,
+                                        va_block_context,
+                                        page_index,
+                                        requester,
+                                        access_type_mask);
+    }
 
     // If the requesting processor is throttled, check the throttling end time
     // stamp
@@ -1758,6 +2205,14 @@ uvm_perf_thrashing_hint_t uvm_perf_thrashing_get_hint(uvm_va_block_t *va_block,
     // Set the requesting processor in the thrashing processors mask
     uvm_processor_mask_set(&page_thrashing->processors, requester);
 
+    range_thrashing_sample(va_space_thrashing,
+                           va_block,
+                           page_thrashing,
+                           requester,
+                           access_type_mask,
+                           time_stamp,
+                           &va_block_context->scratch_processor_mask);
+
     UVM_ASSERT(page_thrashing->has_migration_events || page_thrashing->has_revocation_events);
 
     // Update throttling heuristics
@@ -1978,6 +2433,8 @@ NV_STATUS uvm_perf_thrashing_load(uvm_va_space_t *va_space)
     INIT_LIST_HEAD(&va_space_thrashing->pinned_pages.list);
     INIT_DELAYED_WORK(&va_space_thrashing->pinned_pages.dwork, thrashing_unpin_pages_entry);
 
+    uvm_spin_lock_init(&va_space_thrashing->ranges.lock, UVM_LOCK_ORDER_LEAF);
+
     return NV_OK;
 }
 
@@ -2062,6 +2519,8 @@ NV_STATUS uvm_perf_thrashing_init(void)
 
     INIT_THRASHING_PARAMETER(uvm_perf_thrashing_max_resets, UVM_PERF_THRASHING_MAX_RESETS_DEFAULT);
 
+    INIT_THRASHING_PARAMETER(uvm_perf_thrashing_range_samples, UVM_PERF_THRASHING_RANGE_SAMPLES_DEFAULT);
+
     g_va_block_thrashing_info_cache = NV_KMEM_CACHE_CREATE("uvm_block_thrashing_info_t", block_thrashing_info_t);
     if (!g_va_block_thrashing_info_cache) {
         status = NV_ERR_NO_MEMORY;
@@ -2194,6 +2653,8 @@ NV_STATUS uvm_test_set_page_thrashing_policy(UVM_TEST_SET_PAGE_THRASHING_POLICY_
                     goto done_unlock_va_space;
                 }
             }
+
+            range_thrashing_info_destroy(managed_range);
         }
 
         status = uvm_hmm_clear_thrashing_policy(va_space);
@@ -43,9 +43,10 @@ typedef enum
     // sleeping or handing other faults)
     UVM_PERF_THRASHING_HINT_TYPE_THROTTLE = 2,
 
-    // TODO: Bug 1877578: Implement heuristics-driven read-duplication
-    // Add a thrashing hint type to read-duplicate a page when it is being
-    // accessed read-only from different processors
+    // Read-duplicate the page on the calling processor. Returned for read
+    // accesses to pages of ranges that are being accessed read-only from
+    // different processors.
+    UVM_PERF_THRASHING_HINT_TYPE_READ_DUPLICATE = 3,
 } uvm_perf_thrashing_hint_type_t;
 
 typedef struct
@@ -73,11 +74,14 @@ typedef struct
     };
 } uvm_perf_thrashing_hint_t;
 
-// Obtain a hint to prevent thrashing on the page with given address
+// Obtain a hint to prevent thrashing on the page with given address.
+// access_type_mask is the mask of uvm_fault_access_type_t bits with which the
+// requester is accessing the page.
 uvm_perf_thrashing_hint_t uvm_perf_thrashing_get_hint(uvm_va_block_t *va_block,
                                                       uvm_va_block_context_t *va_block_context,
                                                       NvU64 address,
-                                                      uvm_processor_id_t requester);
+                                                      uvm_processor_id_t requester,
+                                                      NvU32 access_type_mask);
 
 // Obtain a pointer to a mask with the processors that are thrashing on the
 // given page. This function assumes that thrashing has been just reported on
@@ -102,8 +102,12 @@
 // (root_chunks.alloc_list[n]). The list used depends on the state of the chunk
 // (see uvm_pmm_alloc_list_t). A root chunk is moved to the tail of the used
 // list (UVM_PMM_ALLOC_LIST_USED) whenever any of its subchunks is allocated
-// (unpinned) by a VA block (see uvm_pmm_gpu_unpin_allocated()). When a root
-// chunk is selected for eviction, it has the eviction flag set
+// (unpinned) by a VA block (see uvm_pmm_gpu_unpin_allocated()). Accesses
+// observed by the VA block code after that only set a referenced bit in the root
+// chunk (see uvm_pmm_gpu_mark_root_chunk_accessed()), and the used list is
+// scanned CLOCK-style on eviction, giving referenced chunks a second chance by
+// rotating them to the tail. When a root chunk is selected for eviction, it has
+// the eviction flag set
 // (see pick_root_chunk_to_evict()). This flag affects many of the PMM
 // operations on all of the subchunks of the root chunk being evicted. See usage
 // of (root_)chunk_is_in_eviction(), in particular in chunk_free_locked() and
@@ -167,6 +171,8 @@
 #include "uvm_api.h"
 #include "uvm_gpu.h"
 #include "uvm_pmm_gpu.h"
+#include "uvm_procfs.h"
+#include "uvm_push.h"
 #include "uvm_mem.h"
 #include "uvm_mmu.h"
 #include "uvm_global.h"
@@ -193,6 +199,37 @@ MODULE_PARM_DESC(uvm_global_oversubscription, "Enable (1) or disable (0) global
 static unsigned uvm_perf_pma_batch_nonpinned_order = UVM_PERF_PMA_BATCH_NONPINNED_ORDER_DEFAULT;
 module_param(uvm_perf_pma_batch_nonpinned_order, uint, S_IRUGO);
 
+// Watermarks of the background reclaimer, in number of free root chunks in
+// PMA. When an allocation leaves fewer than the low watermark free root chunks,
+// a per-GPU background thread evicts root chunks until the high watermark is
+// reached, so that most allocations don't have to wait for a synchronous
+// eviction. A low watermark of 0 disables the reclaimer. The high watermark
+// defaults to twice the low watermark if it's not larger than it.
+static unsigned uvm_perf_pmm_reclaim_low_watermark = 0;
+module_param(uvm_perf_pmm_reclaim_low_watermark, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_perf_pmm_reclaim_low_watermark,
+                 "Number of free 2MB root chunks below which vidmem is reclaimed in the background. 0 disables it.");
+
+static unsigned uvm_perf_pmm_reclaim_high_watermark = 0;
+module_param(uvm_perf_pmm_reclaim_high_watermark, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_perf_pmm_reclaim_high_watermark,
+                 "Number of free 2MB root chunks at which background vidmem reclaim stops.");
+
+#define UVM_PERF_PMM_ZERO_BATCH_DEFAULT 8
+#define UVM_PERF_PMM_ZERO_BATCH_MAX     64
+
+// Free root chunks that are not known to be zero can be zeroed in the
+// background, so that allocations of new memory don't have to wait for an
+// inline memset. Zeroing is done in pushes of up to uvm_perf_pmm_zero_batch
+// root chunks.
+static unsigned uvm_perf_pmm_zero_free_chunks = 0;
+module_param(uvm_perf_pmm_zero_free_chunks, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_perf_pmm_zero_free_chunks, "Zero free vidmem root chunks in the background (1) or not (0).");
+
+static unsigned uvm_perf_pmm_zero_batch = UVM_PERF_PMM_ZERO_BATCH_DEFAULT;
+module_param(uvm_perf_pmm_zero_batch, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_perf_pmm_zero_batch, "Maximum number of root chunks zeroed in the background by a single push.");
+
 // Helper type for refcounting cache
 typedef struct
 {
@@ -323,6 +360,7 @@ static struct list_head *find_free_list(uvm_pmm_gpu_t *pmm,
 static bool check_chunk(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk);
 static struct list_head *find_free_list_chunk(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk);
 static void chunk_free_locked(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk);
+static void zero_kick(uvm_pmm_gpu_t *pmm);
 
 static size_t root_chunk_index(uvm_pmm_gpu_t *pmm, uvm_gpu_root_chunk_t *root_chunk)
 {
@@ -710,6 +748,8 @@ void uvm_pmm_gpu_free(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk, uvm_tracker_t
     }
 
     free_chunk(pmm, chunk);
+
+    zero_kick(pmm);
 }
 
 static NvU32 num_subchunks(uvm_gpu_chunk_t *parent)
@@ -1452,6 +1492,91 @@ void uvm_pmm_gpu_mark_root_chunk_discarded(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *
     root_chunk_update_eviction_list(pmm, chunk, UVM_PMM_ALLOC_LIST_DISCARDED);
 }
 
+void uvm_pmm_gpu_mark_root_chunk_accessed(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk)
+{
+    uvm_gpu_root_chunk_t *root_chunk = root_chunk_from_chunk(pmm, chunk);
+
+    UVM_ASSERT(uvm_gpu_chunk_is_user(chunk));
+
+    WRITE_ONCE(root_chunk->last_access_time, NV_GETTIME());
+
+    // Avoid dirtying the cache line of hot chunks repeatedly
+    if (!READ_ONCE(root_chunk->referenced))
+        WRITE_ONCE(root_chunk->referenced, true);
+}
+
+static NvU32 eviction_histogram_bucket(NvU64 time_ns)
+{
+    NvU64 time_ms = time_ns / (1000 * 1000);
+
+    if (time_ms == 0)
+        return 0;
+
+    return min((NvU32)ilog2(time_ms) + 1, (NvU32)UVM_PMM_EVICTION_HISTOGRAM_BUCKETS - 1);
+}
+
+void uvm_pmm_gpu_record_refault(uvm_pmm_gpu_t *pmm, NvU64 evicted_time_ns)
+{
+    NvU64 now = NV_GETTIME();
+    NvU64 elapsed = now > evicted_time_ns ? now - evicted_time_ns : 0;
+
+    uvm_spin_lock(&pmm->list_lock);
+
+    ++pmm->eviction_stats.num_refaults;
+    ++pmm->eviction_stats.refault_time_histogram[eviction_histogram_bucket(elapsed)];
+
+    uvm_spin_unlock(&pmm->list_lock);
+}
+
+void uvm_pmm_gpu_print_eviction_stats(uvm_pmm_gpu_t *pmm, struct seq_file *s)
+{
+    NvU64 victim_age_histogram[UVM_PMM_EVICTION_HISTOGRAM_BUCKETS];
+    NvU64 refault_time_histogram[UVM_PMM_EVICTION_HISTOGRAM_BUCKETS];
+    NvU64 num_evictions;
+    NvU64 num_second_chances;
+    NvU64 num_refaults;
+    NvU64 num_reclaim_runs;
+    NvU64 num_root_chunks_reclaimed;
+    NvU64 num_root_chunks_zeroed;
+    NvU32 i;
+
+    uvm_spin_lock(&pmm->list_lock);
+
+    num_evictions = pmm->eviction_stats.num_evictions;
+    num_second_chances = pmm->eviction_stats.num_second_chances;
+    num_refaults = pmm->eviction_stats.num_refaults;
+    memcpy(victim_age_histogram, pmm->eviction_stats.victim_age_histogram, sizeof(victim_age_histogram));
+    memcpy(refault_time_histogram, pmm->eviction_stats.refault_time_histogram, sizeof(refault_time_histogram));
+    num_reclaim_runs = pmm->reclaim.num_runs;
+    num_root_chunks_reclaimed = pmm->reclaim.num_root_chunks_reclaimed;
+    num_root_chunks_zeroed = pmm->zero.num_root_chunks_zeroed;
+
+    uvm_spin_unlock(&pmm->list_lock);
+
+    UVM_SEQ_OR_DBG_PRINT(s, "eviction_policy              clock\n");
+    UVM_SEQ_OR_DBG_PRINT(s, "num_evictions                %llu\n", num_evictions);
+    UVM_SEQ_OR_DBG_PRINT(s, "num_second_chances           %llu\n", num_second_chances);
+    UVM_SEQ_OR_DBG_PRINT(s, "num_refaults                 %llu\n", num_refaults);
+    UVM_SEQ_OR_DBG_PRINT(s, "refault_rate                 %llu%%\n",
+                         num_evictions ? (num_refaults * 100) / num_evictions : 0);
+    UVM_SEQ_OR_DBG_PRINT(s, "reclaim_watermarks           %u / %u\n",
+                         pmm->reclaim.low_watermark,
+                         pmm->reclaim.high_watermark);
+    UVM_SEQ_OR_DBG_PRINT(s, "num_reclaim_runs             %llu\n", num_reclaim_runs);
+    UVM_SEQ_OR_DBG_PRINT(s, "num_root_chunks_reclaimed    %llu\n", num_root_chunks_reclaimed);
+    UVM_SEQ_OR_DBG_PRINT(s, "num_root_chunks_zeroed       %llu\n", num_root_chunks_zeroed);
+
+    UVM_SEQ_OR_DBG_PRINT(s, "victim_age_ms / refault_after_eviction_ms:\n");
+    UVM_SEQ_OR_DBG_PRINT(s, "  < 1             %llu / %llu\n", victim_age_histogram[0], refault_time_histogram[0]);
+    for (i = 1; i < UVM_PMM_EVICTION_HISTOGRAM_BUCKETS; i++) {
+        UVM_SEQ_OR_DBG_PRINT(s,
+                             "  >= %-12u  %llu / %llu\n",
+                             1u << (i - 1),
+                             victim_age_histogram[i],
+                             refault_time_histogram[i]);
+    }
+}
+
 static uvm_pmm_alloc_list_t get_alloc_list(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk)
 {
     uvm_pmm_alloc_list_t alloc_list;
@@ -1469,6 +1594,41 @@ static uvm_pmm_alloc_list_t get_alloc_list(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *
     return UVM_PMM_ALLOC_LIST_COUNT;
 }
 
+// Maximum number of referenced root chunks rotated by a single CLOCK scan of
+// the used list. This bounds the time spent under the list lock when most of
+// the chunks are hot, in which case the head of the list is picked once the
+// budget is exhausted.
+#define UVM_PMM_EVICTION_CLOCK_MAX_SCAN 64
+
+// Pick a root chunk from the used list with a CLOCK (second chance) scan: the
+// head of the list is picked unless it has been referenced since the last scan,
+// in which case its reference is cleared and it is rotated to the tail.
+static uvm_gpu_chunk_t *get_used_chunk_clock(uvm_pmm_gpu_t *pmm)
+{
+    struct list_head *used_list = &pmm->root_chunks.alloc_list[UVM_PMM_ALLOC_LIST_USED];
+    NvU32 scanned;
+
+    uvm_assert_spinlock_locked(&pmm->list_lock);
+
+    for (scanned = 0; scanned < UVM_PMM_EVICTION_CLOCK_MAX_SCAN; scanned++) {
+        uvm_gpu_chunk_t *chunk = list_first_chunk(used_list);
+        uvm_gpu_root_chunk_t *root_chunk;
+
+        if (!chunk)
+            return NULL;
+
+        root_chunk = root_chunk_from_chunk(pmm, chunk);
+        if (!READ_ONCE(root_chunk->referenced))
+            return chunk;
+
+        WRITE_ONCE(root_chunk->referenced, false);
+        list_move_tail(&chunk->list, used_list);
+        ++pmm->eviction_stats.num_second_chances;
+    }
+
+    return list_first_chunk(used_list);
+}
+
 static uvm_gpu_chunk_t *get_first_allocated_chunk(uvm_pmm_gpu_t *pmm)
 {
     uvm_pmm_alloc_list_t alloc_list;
@@ -1476,7 +1636,13 @@ static uvm_gpu_chunk_t *get_first_allocated_chunk(uvm_pmm_gpu_t *pmm)
     uvm_assert_spinlock_locked(&pmm->list_lock);
 
     for (alloc_list = 0; alloc_list < UVM_PMM_ALLOC_LIST_COUNT; alloc_list++) {
-        uvm_gpu_chunk_t *chunk = list_first_chunk(&pmm->root_chunks.alloc_list[alloc_list]);
+        uvm_gpu_chunk_t *chunk;
+
+        if (alloc_list == UVM_PMM_ALLOC_LIST_USED)
+            chunk = get_used_chunk_clock(pmm);
+        else
+            chunk = list_first_chunk(&pmm->root_chunks.alloc_list[alloc_list]);
+
         if (chunk)
             return chunk;
     }
@@ -1508,10 +1674,18 @@ static uvm_gpu_root_chunk_t *pick_root_chunk_to_evict(uvm_pmm_gpu_t *pmm)
             UVM_ASSERT(chunk->is_zero);
     }
 
-    // TODO: Bug 1765193: Move the chunks to the tail of the used list whenever
-    // they get mapped.
-    if (!chunk)
+    if (!chunk) {
         chunk = get_first_allocated_chunk(pmm);
+        if (chunk) {
+            uvm_gpu_root_chunk_t *root_chunk = root_chunk_from_chunk(pmm, chunk);
+            NvU64 now = NV_GETTIME();
+            NvU64 last_access_time = READ_ONCE(root_chunk->last_access_time);
+            NvU64 age = now > last_access_time ? now - last_access_time : 0;
+
+            ++pmm->eviction_stats.num_evictions;
+            ++pmm->eviction_stats.victim_age_histogram[eviction_histogram_bucket(age)];
+        }
+    }
 
     if (chunk)
         chunk_start_eviction(pmm, chunk);
@@ -1690,6 +1864,19 @@ out:
     return chunk;
 }
 
+// Wake up the background reclaimer if the number of free root chunks in PMA
+// dropped below the low watermark.
+static void reclaim_kick(uvm_pmm_gpu_t *pmm)
+{
+    if (pmm->reclaim.low_watermark == 0)
+        return;
+
+    if (READ_ONCE(pmm->pma_stats->numFreePages2m) >= pmm->reclaim.low_watermark)
+        return;
+
+    nv_kthread_q_schedule_q_item(&pmm->reclaim.q, &pmm->reclaim.q_item);
+}
+
 static NV_STATUS alloc_or_evict_root_chunk(uvm_pmm_gpu_t *pmm,
                                            uvm_pmm_gpu_memory_type_t type,
                                            uvm_pmm_alloc_flags_t flags,
@@ -1699,6 +1886,8 @@ static NV_STATUS alloc_or_evict_root_chunk(uvm_pmm_gpu_t *pmm,
     uvm_gpu_chunk_t *chunk;
 
     status = alloc_root_chunk(pmm, type, flags, &chunk);
+    reclaim_kick(pmm);
+    zero_kick(pmm);
     if (status != NV_OK) {
         if (flags & UVM_PMM_ALLOC_FLAGS_EVICT)
             status = pick_and_evict_root_chunk_retry(pmm, type, PMM_CONTEXT_DEFAULT, chunk_out);
@@ -1720,6 +1909,8 @@ static NV_STATUS alloc_or_evict_root_chunk_unlocked(uvm_pmm_gpu_t *pmm,
     uvm_gpu_chunk_t *chunk;
 
     status = alloc_root_chunk(pmm, type, flags, &chunk);
+    reclaim_kick(pmm);
+    zero_kick(pmm);
     if (status != NV_OK) {
         if (flags & UVM_PMM_ALLOC_FLAGS_EVICT) {
             uvm_mutex_lock(&pmm->lock);
@@ -1912,6 +2103,9 @@ static void init_root_chunk(uvm_pmm_gpu_t *pmm,
     chunk->state = initial_state;
     chunk->is_zero = is_zero;
 
+    root_chunk->last_access_time = NV_GETTIME();
+    root_chunk->referenced = false;
+
     if (initial_state == UVM_PMM_GPU_CHUNK_STATE_TEMP_PINNED)
         ++pmm->root_chunks.pinned_count;
 
@@ -3564,6 +3758,246 @@ static void process_lazy_free_entry(void *args)
     UVM_ENTRY_VOID(process_lazy_free(args));
 }
 
+// Evict root chunks until PMA has at least the high watermark of free root
+// chunks, there is nothing left to evict, or the PMM is being torn down. This
+// uses the same victim selection as the synchronous eviction path, but the
+// evicted root chunks are returned to PMA rather than handed to an allocation.
+static void reclaim_root_chunks(uvm_pmm_gpu_t *pmm)
+{
+    NvU64 num_reclaimed = 0;
+
+    while (!READ_ONCE(pmm->reclaim.stopping) &&
+           READ_ONCE(pmm->pma_stats->numFreePages2m) < pmm->reclaim.high_watermark) {
+        uvm_gpu_root_chunk_t *root_chunk;
+        NV_STATUS status;
+
+        uvm_mutex_lock(&pmm->lock);
+
+        root_chunk = pick_root_chunk_to_evict(pmm);
+        if (!root_chunk) {
+            uvm_mutex_unlock(&pmm->lock);
+            break;
+        }
+
+        // On failure evict_root_chunk() already put the root chunk back on
+        // the lists or returned it to PMA, so the reclaimer can just stop
+        // and let the foreground path handle any subsequent allocations.
+        status = evict_root_chunk(pmm, root_chunk, PMM_CONTEXT_DEFAULT);
+        if (status != NV_OK) {
+            uvm_mutex_unlock(&pmm->lock);
+            break;
+        }
+
+        free_root_chunk(pmm, root_chunk, FREE_ROOT_CHUNK_MODE_DEFAULT);
+
+        uvm_mutex_unlock(&pmm->lock);
+
+        ++num_reclaimed;
+    }
+
+    uvm_spin_lock(&pmm->list_lock);
+    ++pmm->reclaim.num_runs;
+    pmm->reclaim.num_root_chunks_reclaimed += num_reclaimed;
+    uvm_spin_unlock(&pmm->list_lock);
+}
+
+static void reclaim_root_chunks_entry(void *args)
+{
+    UVM_ENTRY_VOID(reclaim_root_chunks(args));
+}
+
+static NV_STATUS reclaim_init(uvm_pmm_gpu_t *pmm)
+{
+    NV_STATUS status;
+    NvU32 low_watermark = uvm_perf_pmm_reclaim_low_watermark;
+    NvU32 high_watermark = uvm_perf_pmm_reclaim_high_watermark;
+
+    // The reclaimer relies on the PMA statistics and on being able to evict
+    // root chunks, so it's only enabled with vidmem and oversubscription.
+    if (low_watermark == 0 || !pmm->pma_stats || !gpu_supports_pma_eviction(uvm_pmm_to_gpu(pmm)))
+        return NV_OK;
+
+    if (high_watermark <= low_watermark)
+        high_watermark = low_watermark * 2;
+
+    nv_kthread_q_item_init(&pmm->reclaim.q_item, reclaim_root_chunks_entry, pmm);
+    status = errno_to_nv_status(nv_kthread_q_init(&pmm->reclaim.q, "vidmem reclaim"));
+    if (status != NV_OK)
+        return status;
+
+    pmm->reclaim.high_watermark = high_watermark;
+    pmm->reclaim.low_watermark = low_watermark;
+
+    return NV_OK;
+}
+
+static void reclaim_deinit(uvm_pmm_gpu_t *pmm)
+{
+    if (pmm->reclaim.low_watermark == 0)
+        return;
+
+    WRITE_ONCE(pmm->reclaim.stopping, true);
+    nv_kthread_q_stop(&pmm->reclaim.q);
+    pmm->reclaim.low_watermark = 0;
+}
+
+static void zero_kick(uvm_pmm_gpu_t *pmm)
+{
+    uvm_gpu_t *gpu = uvm_pmm_to_gpu(pmm);
+
+    // The channel manager is created after PMM
+    if (!uvm_perf_pmm_zero_free_chunks || READ_ONCE(pmm->zero.stopping) || !gpu->channel_manager)
+        return;
+
+    nv_kthread_q_schedule_q_item(&gpu->parent->lazy_free_q, &pmm->zero.q_item);
+}
+
+// Claim up to max_chunks free user root chunks that are not known to be zero.
+// The claimed root chunks are removed from the free lists and temporarily
+// pinned, like in free_next_available_root_chunk().
+static NvU32 claim_root_chunks_to_zero(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t **chunks, NvU32 max_chunks)
+{
+    NvU32 num_chunks = 0;
+
+    uvm_spin_lock(&pmm->list_lock);
+
+    while (num_chunks < max_chunks) {
+        uvm_gpu_chunk_t *chunk = find_free_chunk_locked(pmm,
+                                                        UVM_PMM_GPU_MEMORY_TYPE_USER,
+                                                        UVM_CHUNK_SIZE_MAX,
+                                                        UVM_PMM_LIST_NO_ZERO);
+        if (!chunk)
+            break;
+
+        UVM_ASSERT(chunk->state == UVM_PMM_GPU_CHUNK_STATE_FREE);
+        UVM_ASSERT(!chunk->is_zero);
+
+        list_del_init(&chunk->list);
+        chunk_pin(pmm, chunk);
+        chunks[num_chunks++] = chunk;
+    }
+
+    uvm_spin_unlock(&pmm->list_lock);
+
+    return num_chunks;
+}
+
+// Zero a batch of claimed root chunks with a single push, and return them to
+// the free lists. The memsets are added to the trackers of the root chunks, so
+// allocations of the chunks wait for them in pmm_gpu_alloc() like for any other
+// pending operation. Returns whether the root chunks are now zero.
+static bool zero_root_chunks_batch(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t **chunks, NvU32 num_chunks)
+{
+    uvm_gpu_t *gpu = uvm_pmm_to_gpu(pmm);
+    uvm_tracker_t tracker = UVM_TRACKER_INIT();
+    uvm_push_t push;
+    NV_STATUS status = NV_OK;
+    bool zeroed = false;
+    NvU32 i;
+
+    // The chunks may still be accessed by operations issued before they were
+    // freed
+    for (i = 0; i < num_chunks && status == NV_OK; i++) {
+        uvm_gpu_root_chunk_t *root_chunk = root_chunk_from_chunk(pmm, chunks[i]);
+
+        root_chunk_lock(pmm, root_chunk);
+        uvm_tracker_remove_completed(&root_chunk->tracker);
+        status = uvm_tracker_add_tracker_safe(&tracker, &root_chunk->tracker);
+        root_chunk_unlock(pmm, root_chunk);
+    }
+
+    if (status == NV_OK) {
+        status = uvm_push_begin_acquire(gpu->channel_manager,
+                                        UVM_CHANNEL_TYPE_GPU_INTERNAL,
+                                        &tracker,
+                                        &push,
+                                        "Zero %u free root chunks",
+                                        num_chunks);
+    }
+
+    uvm_tracker_deinit(&tracker);
+
+    if (status == NV_OK) {
+        for (i = 0; i < num_chunks; i++) {
+            uvm_gpu_phys_address_t phys_addr = uvm_gpu_phys_address(UVM_APERTURE_VID, chunks[i]->address);
+            uvm_gpu_address_t memset_addr = uvm_gpu_address_copy(gpu, phys_addr);
+
+            // Pipeline the memsets since they never overlap with each other,
+            // and push a single membar at the end for all of them. See
+            // block_zero_new_gpu_chunk() for why the membar is needed.
+            uvm_push_set_flag(&push, UVM_PUSH_FLAG_CE_NEXT_PIPELINED);
+            uvm_push_set_flag(&push, UVM_PUSH_FLAG_NEXT_MEMBAR_NONE);
+            gpu->parent->ce_hal->memset_8(&push, memset_addr, 0, UVM_CHUNK_SIZE_MAX);
+        }
+
+        uvm_push_end(&push);
+        zeroed = true;
+
+        for (i = 0; i < num_chunks && status == NV_OK; i++) {
+            uvm_gpu_root_chunk_t *root_chunk = root_chunk_from_chunk(pmm, chunks[i]);
+
+            root_chunk_lock(pmm, root_chunk);
+            status = uvm_tracker_add_push_safe(&root_chunk->tracker, &push);
+            root_chunk_unlock(pmm, root_chunk);
+        }
+
+        // The memset can't be tracked by all the root chunks, so wait for it
+        // before the chunks can be reallocated.
+        if (status != NV_OK)
+            zeroed = uvm_push_wait(&push) == NV_OK;
+    }
+
+    uvm_spin_lock(&pmm->list_lock);
+
+    for (i = 0; i < num_chunks; i++) {
+        chunks[i]->is_zero = zeroed;
+        chunk_unpin(pmm, chunks[i], UVM_PMM_GPU_CHUNK_STATE_FREE);
+        chunk_update_lists_locked(pmm, chunks[i]);
+    }
+
+    if (zeroed)
+        pmm->zero.num_root_chunks_zeroed += num_chunks;
+
+    uvm_spin_unlock(&pmm->list_lock);
+
+    return zeroed;
+}
+
+static void zero_free_root_chunks(uvm_pmm_gpu_t *pmm)
+{
+    uvm_gpu_chunk_t *chunks[UVM_PERF_PMM_ZERO_BATCH_MAX];
+
+    while (!READ_ONCE(pmm->zero.stopping)) {
+        NvU32 num_chunks = claim_root_chunks_to_zero(pmm, chunks, uvm_perf_pmm_zero_batch);
+
+        if (num_chunks == 0)
+            break;
+
+        // Leave the chunks to be zeroed inline if zeroing failed, e.g. due to
+        // a global error.
+        if (!zero_root_chunks_batch(pmm, chunks, num_chunks))
+            break;
+    }
+}
+
+static void zero_free_root_chunks_entry(void *args)
+{
+    UVM_ENTRY_VOID(zero_free_root_chunks(args));
+}
+
+void uvm_pmm_gpu_stop_background_work(uvm_pmm_gpu_t *pmm)
+{
+    uvm_gpu_t *gpu = uvm_pmm_to_gpu(pmm);
+
+    if (!pmm->initialized)
+        return;
+
+    reclaim_deinit(pmm);
+
+    WRITE_ONCE(pmm->zero.stopping, true);
+    nv_kthread_q_flush(&gpu->parent->lazy_free_q);
+}
+
 NV_STATUS uvm_pmm_gpu_init(uvm_pmm_gpu_t *pmm)
 {
     uvm_gpu_t *gpu = uvm_pmm_to_gpu(pmm);
@@ -3582,6 +4016,13 @@ NV_STATUS uvm_pmm_gpu_init(uvm_pmm_gpu_t *pmm)
 
     uvm_assert_mutex_locked(&g_uvm_global.global_lock);
 
+    if (uvm_perf_pmm_zero_batch == 0 || uvm_perf_pmm_zero_batch > UVM_PERF_PMM_ZERO_BATCH_MAX) {
+        UVM_INFO_PRINT("Invalid value %u for uvm_perf_pmm_zero_batch, using %u instead\n",
+                       uvm_perf_pmm_zero_batch,
+                       UVM_PERF_PMM_ZERO_BATCH_DEFAULT);
+        uvm_perf_pmm_zero_batch = UVM_PERF_PMM_ZERO_BATCH_DEFAULT;
+    }
+
     for (i = 0; i < ARRAY_SIZE(pmm->free_list); i++) {
         for (j = 0; j < ARRAY_SIZE(pmm->free_list[i]); j++) {
             for (k = 0; k < ARRAY_SIZE(pmm->free_list[i][j]); k++)
@@ -3594,6 +4035,7 @@ NV_STATUS uvm_pmm_gpu_init(uvm_pmm_gpu_t *pmm)
 
     INIT_LIST_HEAD(&pmm->root_chunks.va_block_lazy_free);
     nv_kthread_q_item_init(&pmm->root_chunks.va_block_lazy_free_q_item, process_lazy_free_entry, pmm);
+    nv_kthread_q_item_init(&pmm->zero.q_item, zero_free_root_chunks_entry, pmm);
     pmm->root_chunks.pinned_count = 0;
     pmm->root_chunks.in_eviction_count = 0;
 
@@ -3671,6 +4113,10 @@ NV_STATUS uvm_pmm_gpu_init(uvm_pmm_gpu_t *pmm)
             if (status != NV_OK)
                 goto cleanup;
         }
+
+        status = reclaim_init(pmm);
+        if (status != NV_OK)
+            goto cleanup;
     }
 
     return NV_OK;
@@ -3708,6 +4154,8 @@ void uvm_pmm_gpu_deinit(uvm_pmm_gpu_t *pmm)
 
     gpu = uvm_pmm_to_gpu(pmm);
 
+    reclaim_deinit(pmm);
+
     nv_kthread_q_flush(&gpu->parent->lazy_free_q);
     UVM_ASSERT(list_empty(&pmm->root_chunks.va_block_lazy_free));
     UVM_ASSERT(uvm_pmm_gpu_check_orphan_pages(pmm));
@@ -202,6 +202,9 @@ typedef enum
     UVM_PMM_ALLOC_LIST_COUNT
 } uvm_pmm_alloc_list_t;
 
+// Number of log2 millisecond buckets in the PMM eviction histograms
+#define UVM_PMM_EVICTION_HISTOGRAM_BUCKETS 16
+
 // Maximum chunk sizes per type of allocation in single GPU.
 // The worst case today is 2 allocation sizes for page tables (256, 4K) and
 // 3 page sizes used by uvm_mem_t (4K, 64K, 2M) for a total of 4 unique sizes.
@@ -372,6 +375,13 @@ typedef struct uvm_gpu_root_chunk_struct
     //
     // Protected by the corresponding root chunk bit lock.
     uvm_tracker_t tracker;
+
+    // Eviction recency state, refreshed by uvm_pmm_gpu_mark_root_chunk_accessed()
+    // and consumed by the CLOCK scan in pick_root_chunk_to_evict().
+    //
+    // Updated without locking, so both fields are approximate.
+    NvU64 last_access_time;
+    bool referenced;
 } uvm_gpu_root_chunk_t;
 
 typedef struct uvm_pmm_gpu_struct
@@ -424,6 +434,66 @@ typedef struct uvm_pmm_gpu_struct
         long pinned_count;
     } root_chunks;
 
+    // Eviction statistics exported through procfs.
+    //
+    // Protected by 'list_lock'.
+    struct
+    {
+        // Number of allocated root chunks picked for eviction
+        NvU64 num_evictions;
+
+        // Number of referenced root chunks skipped and rotated to the tail of
+        // the used list by the CLOCK scan
+        NvU64 num_second_chances;
+
+        // Time since the last access of the picked root chunks, in
+        // milliseconds. Bucket i counts victims in [2^(i-1), 2^i) ms, bucket 0
+        // victims accessed less than 1 ms before being picked.
+        NvU64 victim_age_histogram[UVM_PMM_EVICTION_HISTOGRAM_BUCKETS];
+
+        // Number of times pages evicted from this GPU were migrated back to it.
+        // Bucketed like victim_age_histogram, by the time since eviction.
+        NvU64 num_refaults;
+        NvU64 refault_time_histogram[UVM_PMM_EVICTION_HISTOGRAM_BUCKETS];
+    } eviction_stats;
+
+    // Background reclaimer evicting root chunks ahead of demand, so that PMA
+    // keeps between low_watermark and high_watermark free root chunks. See
+    // uvm_perf_pmm_reclaim_low_watermark.
+    struct
+    {
+        // Watermarks in number of free root chunks. A low_watermark of 0 means
+        // the reclaimer is disabled.
+        NvU32 low_watermark;
+        NvU32 high_watermark;
+
+        // Queue and item used to run the reclaimer in the background
+        nv_kthread_q_t q;
+        nv_kthread_q_item_t q_item;
+
+        // Set during PMM teardown to make a running reclaimer exit early
+        bool stopping;
+
+        // Statistics exported through procfs. Protected by 'list_lock'.
+        NvU64 num_runs;
+        NvU64 num_root_chunks_reclaimed;
+    } reclaim;
+
+    // Background zeroing of free root chunks, which moves them from the
+    // UVM_PMM_LIST_NO_ZERO to the UVM_PMM_LIST_ZERO free lists, so that new
+    // allocations don't need to be zeroed inline. Runs on the parent GPU's
+    // lazy_free_q. See uvm_perf_pmm_zero_free_chunks.
+    struct
+    {
+        nv_kthread_q_item_t q_item;
+
+        // Set before the channel manager used for zeroing is destroyed
+        bool stopping;
+
+        // Statistics exported through procfs. Protected by 'list_lock'.
+        NvU64 num_root_chunks_zeroed;
+    } zero;
+
     // Lock protecting PMA allocation, freeing and eviction
     uvm_rw_semaphore_t pma_lock;
 
@@ -457,6 +527,11 @@ NV_STATUS uvm_pmm_gpu_init(uvm_pmm_gpu_t *pmm);
 // Deinitialize the PMM on GPU
 void uvm_pmm_gpu_deinit(uvm_pmm_gpu_t *pmm);
 
+// Stop the PMM background work that pushes to the GPU channels, i.e. vidmem
+// reclaim and zeroing of free chunks. Must be called before the channel manager
+// of the GPU is destroyed.
+void uvm_pmm_gpu_stop_background_work(uvm_pmm_gpu_t *pmm);
+
 static uvm_chunk_size_t uvm_gpu_chunk_get_size(uvm_gpu_chunk_t *chunk)
 {
     return ((uvm_chunk_size_t)1) << chunk->log2_size;
@@ -619,6 +694,20 @@ void uvm_pmm_gpu_mark_root_chunk_unused(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chu
 // Mark an allocated chunk as discarded
 void uvm_pmm_gpu_mark_root_chunk_discarded(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk);
 
+// Mark the root chunk of a user chunk as recently accessed so that the CLOCK
+// eviction scan gives it a second chance. Called by the VA block code when the
+// chunk backs pages targeted by GPU faults, access counters or migrations.
+//
+// This is lockless and can be called with any chunk state.
+void uvm_pmm_gpu_mark_root_chunk_accessed(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk);
+
+// Record that pages evicted from the GPU evicted_time_ns ago were migrated back
+// to it.
+void uvm_pmm_gpu_record_refault(uvm_pmm_gpu_t *pmm, NvU64 evicted_time_ns);
+
+// Print the eviction statistics of the PMM
+void uvm_pmm_gpu_print_eviction_stats(uvm_pmm_gpu_t *pmm, struct seq_file *s);
+
 static bool uvm_gpu_chunk_same_root(uvm_gpu_chunk_t *chunk1, uvm_gpu_chunk_t *chunk2)
 {
     return UVM_ALIGN_DOWN(chunk1->address, UVM_CHUNK_SIZE_MAX) == UVM_ALIGN_DOWN(chunk2->address, UVM_CHUNK_SIZE_MAX);
@@ -449,11 +449,16 @@ static struct page *uvm_cpu_chunk_alloc_page(uvm_chunk_size_t alloc_size,
 
     // For allocation sizes higher than PAGE_SIZE, use __GFP_NORETRY in order
     // to avoid higher allocation latency from the kernel compacting memory to
-    // satisfy the request.
+    // satisfy the request, unless the caller asked for compaction. Costly
+    // order allocations never invoke the OOM killer, so they still fail
+    // gracefully in that case.
     // Use __GFP_NOWARN to avoid printing allocation failure to the kernel log.
     // High order allocation failures are handled gracefully by the caller.
-    if (alloc_size > PAGE_SIZE)
-        kernel_alloc_flags |= __GFP_COMP | __GFP_NORETRY | __GFP_NOWARN;
+    if (alloc_size > PAGE_SIZE) {
+        kernel_alloc_flags |= __GFP_COMP | __GFP_NOWARN;
+        if (!(alloc_flags & UVM_CPU_CHUNK_ALLOC_FLAGS_COMPACT))
+            kernel_alloc_flags |= __GFP_NORETRY;
+    }
 
     if (alloc_flags & UVM_CPU_CHUNK_ALLOC_FLAGS_ZERO)
         kernel_alloc_flags |= __GFP_ZERO;
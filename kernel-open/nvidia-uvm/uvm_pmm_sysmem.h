@@ -55,6 +55,12 @@ typedef enum
 
     // Allow chunk allocations from ZONE_MOVABLE.
     UVM_CPU_CHUNK_ALLOC_FLAGS_ALLOW_MOVABLE = (1 << 3),
+
+    // Let the kernel reclaim and compact memory to satisfy allocations larger
+    // than PAGE_SIZE instead of failing fast. Used when a whole 2M block is
+    // being populated, since a physically contiguous chunk allows the block to
+    // be mapped and copied with large pages.
+    UVM_CPU_CHUNK_ALLOC_FLAGS_COMPACT = (1 << 4),
 } uvm_cpu_chunk_alloc_flags_t;
 
 typedef enum
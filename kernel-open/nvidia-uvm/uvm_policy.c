@@ -105,6 +105,21 @@ uvm_api_range_type_t uvm_api_range_type_check(uvm_va_space_t *va_space, struct m
     return UVM_API_RANGE_TYPE_MANAGED;
 }
 
+// Policy changes need the VA space lock in write mode to split VA ranges and
+// to update their policies, which blocks fault servicing on all GPUs for the
+// whole VA space. Work that only acts on VA blocks, like establishing the new
+// accessed-by mappings or waiting for the GPU work issued by the change, is
+// done under the VA block locks, the same way fault servicing does it, and
+// doesn't need exclusive access. Downgrade the lock before doing it so that
+// faults can be serviced in the meantime. Holding the lock in read mode still
+// keeps the VA ranges and the GPUs referenced by the tracker around.
+static void va_space_downgrade_after_policy_update(uvm_va_space_t *va_space)
+{
+    uvm_assert_rwsem_locked_write(&va_space->lock);
+
+    uvm_va_space_downgrade_write(va_space);
+}
+
 static NV_STATUS split_as_needed(uvm_va_space_t *va_space,
                                  NvU64 addr,
                                  uvm_va_policy_is_split_needed_t split_needed_cb,
@@ -380,13 +395,13 @@ NV_STATUS uvm_api_set_preferred_location(const UVM_SET_PREFERRED_LOCATION_PARAMS
                                     &local_tracker);
 
 done:
-    tracker_status = uvm_tracker_wait_deinit(&local_tracker);
-
+    // See va_space_downgrade_after_policy_update()
     if (has_va_space_write_lock)
-        uvm_va_space_up_write(va_space);
-    else
-        uvm_va_space_up_read(va_space);
+        va_space_downgrade_after_policy_update(va_space);
 
+    tracker_status = uvm_tracker_wait_deinit(&local_tracker);
+
+    uvm_va_space_up_read(va_space);
     uvm_va_space_mm_or_current_release_unlock(va_space, mm);
 
     return status == NV_OK ? tracker_status : status;
@@ -431,9 +446,10 @@ NV_STATUS uvm_api_unset_preferred_location(const UVM_UNSET_PREFERRED_LOCATION_PA
                                     &local_tracker);
 
 done:
+    va_space_downgrade_after_policy_update(va_space);
     tracker_status = uvm_tracker_wait_deinit(&local_tracker);
 
-    uvm_va_space_up_write(va_space);
+    uvm_va_space_up_read(va_space);
     uvm_va_space_mm_or_current_release_unlock(va_space, mm);
     return status == NV_OK ? tracker_status : status;
 }
@@ -514,6 +530,38 @@ static bool accessed_by_is_split_needed(const uvm_va_policy_t *policy, void *dat
     return (uvm_processor_mask_test(&policy->accessed_by, params->processor_id) != params->set_bit);
 }
 
+// Establish the mappings for processor_id on all VA blocks in
+// [base, last_address], after it has been added to the accessed_by mask of the
+// managed ranges covering it. See va_space_downgrade_after_policy_update().
+static NV_STATUS accessed_by_map(uvm_va_space_t *va_space,
+                                 struct mm_struct *mm,
+                                 NvU64 base,
+                                 NvU64 last_address,
+                                 uvm_processor_id_t processor_id)
+{
+    uvm_va_range_managed_t *managed_range;
+    uvm_va_block_context_t *va_block_context;
+    NV_STATUS status = NV_OK;
+
+    uvm_assert_rwsem_locked_read(&va_space->lock);
+
+    // The VA space block context can only be used with the VA space lock held
+    // in write mode.
+    va_block_context = uvm_va_block_context_alloc(mm);
+    if (!va_block_context)
+        return NV_ERR_NO_MEMORY;
+
+    uvm_for_each_va_range_managed_in_contig(managed_range, va_space, base, last_address) {
+        status = uvm_va_range_map_accessed_by(managed_range, processor_id, va_block_context);
+        if (status != NV_OK)
+            break;
+    }
+
+    uvm_va_block_context_free(va_block_context);
+
+    return status;
+}
+
 static NV_STATUS accessed_by_set(uvm_va_space_t *va_space,
                                  NvU64 base,
                                  NvU64 length,
@@ -585,14 +633,12 @@ static NV_STATUS accessed_by_set(uvm_va_space_t *va_space,
                 UVM_ASSERT(uvm_processor_mask_test(&managed_range->policy.accessed_by,
                                                    processor_id) == set_bit);
 
-            if (set_bit) {
-                status = uvm_va_range_set_accessed_by(managed_range, processor_id, mm, &local_tracker);
-                if (status != NV_OK)
-                    goto done;
-            }
-            else {
+            // The mappings for a set bit are established by accessed_by_map()
+            // once the VA space lock has been downgraded.
+            if (set_bit)
+                uvm_va_range_set_accessed_by(managed_range, processor_id);
+            else
                 uvm_va_range_unset_accessed_by(managed_range, processor_id, &local_tracker);
-            }
         }
 
         UVM_ASSERT(managed_range_last);
@@ -611,9 +657,14 @@ static NV_STATUS accessed_by_set(uvm_va_space_t *va_space,
     }
 
 done:
+    va_space_downgrade_after_policy_update(va_space);
+
+    if (status == NV_OK && set_bit && type == UVM_API_RANGE_TYPE_MANAGED)
+        status = accessed_by_map(va_space, mm, base, last_address, processor_id);
+
     tracker_status = uvm_tracker_wait_deinit(&local_tracker);
 
-    uvm_va_space_up_write(va_space);
+    uvm_va_space_up_read(va_space);
     uvm_va_space_mm_or_current_release_unlock(va_space, mm);
 
     return status == NV_OK ? tracker_status : status;
@@ -51,6 +51,8 @@ static void uvm_pte_batch_flush_ptes_inline(uvm_pte_batch_t *batch)
     batch->inlining = false;
     inline_data_addr = uvm_push_inline_data_end(&batch->inline_data);
 
+    batch->bytes_inline += ptes_size;
+
     uvm_push_set_flag(batch->push, UVM_PUSH_FLAG_NEXT_MEMBAR_NONE);
     uvm_push_set_flag(batch->push, UVM_PUSH_FLAG_CE_NEXT_PIPELINED);
     gpu->parent->ce_hal->memcopy(batch->push,
@@ -81,6 +83,8 @@ static void uvm_pte_batch_flush_ptes(uvm_pte_batch_t *batch)
     if (batch->pte_count == 0)
         return;
 
+    batch->bytes_written += batch->pte_count * batch->pte_entry_size;
+
     if (batch->inlining)
         uvm_pte_batch_flush_ptes_inline(batch);
     else
@@ -89,6 +93,72 @@ static void uvm_pte_batch_flush_ptes(uvm_pte_batch_t *batch)
     batch->pte_count = 0;
 }
 
+static void uvm_pte_batch_flush_clear(uvm_pte_batch_t *batch)
+{
+    uvm_gpu_t *gpu = uvm_push_get_gpu(batch->push);
+    NvU64 size = (NvU64)batch->clear.entry_size * batch->clear.entry_count;
+
+    if (batch->clear.entry_count == 0)
+        return;
+
+    // Writes are always flushed before a clear is queued up, and a pending
+    // clear is flushed before any write is queued up.
+    UVM_ASSERT(batch->pte_count == 0);
+    UVM_ASSERT(!batch->inlining);
+
+    uvm_push_set_flag(batch->push, UVM_PUSH_FLAG_CE_NEXT_PIPELINED);
+    uvm_push_set_flag(batch->push, UVM_PUSH_FLAG_NEXT_MEMBAR_NONE);
+    gpu->parent->ce_hal->memset_8(batch->push,
+                                  uvm_mmu_gpu_address(gpu, batch->clear.first_pte),
+                                  batch->clear.pte_bits,
+                                  size);
+
+    batch->bytes_written += size;
+    batch->clear.entry_count = 0;
+}
+
+// Returns whether entry_count PTEs of entry_size starting at first_pte set to
+// pte_bits can be added to the end of the pending clear
+static bool uvm_pte_batch_clear_extends(uvm_pte_batch_t *batch,
+                                        uvm_gpu_phys_address_t first_pte,
+                                        NvU64 pte_bits,
+                                        NvU32 entry_size)
+{
+    uvm_gpu_phys_address_t clear_end = batch->clear.first_pte;
+
+    if (batch->clear.entry_count == 0)
+        return false;
+
+    clear_end.address += (NvU64)batch->clear.entry_size * batch->clear.entry_count;
+
+    return batch->clear.entry_size == entry_size &&
+           batch->clear.pte_bits == pte_bits &&
+           uvm_gpu_phys_address_eq(first_pte, clear_end);
+}
+
+static void uvm_pte_batch_queue_clear(uvm_pte_batch_t *batch,
+                                      uvm_gpu_phys_address_t first_pte,
+                                      NvU64 pte_bits,
+                                      NvU32 entry_size,
+                                      NvU32 entry_count)
+{
+    // The clears are pushed after the queued up writes, which need to be
+    // flushed first in case they overlap.
+    uvm_pte_batch_flush_ptes(batch);
+
+    if (uvm_pte_batch_clear_extends(batch, first_pte, pte_bits, entry_size)) {
+        batch->clear.entry_count += entry_count;
+        return;
+    }
+
+    uvm_pte_batch_flush_clear(batch);
+
+    batch->clear.first_pte = first_pte;
+    batch->clear.pte_bits = pte_bits;
+    batch->clear.entry_size = entry_size;
+    batch->clear.entry_count = entry_count;
+}
+
 static void uvm_pte_batch_write_consecutive_inline(uvm_pte_batch_t *batch, NvU64 pte_bits)
 {
     size_t extra_size = batch->pte_entry_size - sizeof(pte_bits);
@@ -129,21 +199,33 @@ static void pte_batch_begin_inline(uvm_pte_batch_t *batch)
         uvm_pte_batch_write_consecutive_inline(batch, batch->pte_bits_queue[i]);
 }
 
-void uvm_pte_batch_write_ptes(uvm_pte_batch_t *batch, uvm_gpu_phys_address_t first_pte, NvU64 *pte_bits, NvU32 entry_size, NvU32 entry_count)
+// Returns the number of consecutive PTEs at the beginning of pte_bits with the
+// same value as the first one
+static NvU32 uniform_pte_count(const NvU64 *pte_bits, NvU32 entry_count)
 {
-    NvU32 max_entries = UVM_PUSH_INLINE_DATA_MAX_SIZE / entry_size;
+    NvU32 i;
 
-    // Updating PTEs in sysmem requires a sysmembar after writing them and
-    // before any TLB invalidates.
-    // PTEs should never be in a location using UVM_APERTURE_SYS_NON_COHERENT.
-    UVM_ASSERT(first_pte.aperture != UVM_APERTURE_SYS_NON_COHERENT);
-    if (first_pte.aperture == UVM_APERTURE_SYS)
-        batch->membar = UVM_MEMBAR_SYS;
+    for (i = 1; i < entry_count; ++i) {
+        if (pte_bits[i] != pte_bits[0])
+            break;
+    }
+
+    return i;
+}
+
+static void uvm_pte_batch_write_ptes_inline(uvm_pte_batch_t *batch,
+                                            uvm_gpu_phys_address_t first_pte,
+                                            NvU64 *pte_bits,
+                                            NvU32 entry_size,
+                                            NvU32 entry_count)
+{
+    NvU32 max_entries = UVM_PUSH_INLINE_DATA_MAX_SIZE / entry_size;
 
     while (entry_count > 0) {
         NvU32 entries_this_time;
 
         uvm_pte_batch_flush_ptes(batch);
+        uvm_pte_batch_flush_clear(batch);
         pte_batch_begin_inline(batch);
 
         entries_this_time = min(max_entries, entry_count);
@@ -159,6 +241,51 @@ void uvm_pte_batch_write_ptes(uvm_pte_batch_t *batch, uvm_gpu_phys_address_t fir
     }
 }
 
+void uvm_pte_batch_write_ptes(uvm_pte_batch_t *batch, uvm_gpu_phys_address_t first_pte, NvU64 *pte_bits, NvU32 entry_size, NvU32 entry_count)
+{
+    NvU32 inline_count = 0;
+
+    // Updating PTEs in sysmem requires a sysmembar after writing them and
+    // before any TLB invalidates.
+    // PTEs should never be in a location using UVM_APERTURE_SYS_NON_COHERENT.
+    UVM_ASSERT(first_pte.aperture != UVM_APERTURE_SYS_NON_COHERENT);
+    if (first_pte.aperture == UVM_APERTURE_SYS)
+        batch->membar = UVM_MEMBAR_SYS;
+
+    // Only 8-byte PTEs can be written with memset_8
+    if (entry_size != sizeof(*pte_bits)) {
+        uvm_pte_batch_write_ptes_inline(batch, first_pte, pte_bits, entry_size, entry_count);
+        return;
+    }
+
+    // Split the buffer in runs of uniform PTEs, which are memset, and the rest,
+    // which are written inline
+    while (inline_count < entry_count) {
+        NvU32 uniform_count = uniform_pte_count(pte_bits + inline_count, entry_count - inline_count);
+        uvm_gpu_phys_address_t uniform_pte;
+
+        if (uniform_count < UVM_PTE_BATCH_MIN_MEMSET_PTES) {
+            inline_count += uniform_count;
+            continue;
+        }
+
+        if (inline_count > 0)
+            uvm_pte_batch_write_ptes_inline(batch, first_pte, pte_bits, entry_size, inline_count);
+
+        uniform_pte = first_pte;
+        uniform_pte.address += (NvU64)inline_count * entry_size;
+        uvm_pte_batch_queue_clear(batch, uniform_pte, pte_bits[inline_count], entry_size, uniform_count);
+
+        pte_bits += inline_count + uniform_count;
+        first_pte.address = uniform_pte.address + (NvU64)uniform_count * entry_size;
+        entry_count -= inline_count + uniform_count;
+        inline_count = 0;
+    }
+
+    if (entry_count > 0)
+        uvm_pte_batch_write_ptes_inline(batch, first_pte, pte_bits, entry_size, entry_count);
+}
+
 void uvm_pte_batch_write_pte(uvm_pte_batch_t *batch, uvm_gpu_phys_address_t pte, NvU64 pte_bits, NvU32 pte_size)
 {
     uvm_gpu_phys_address_t consecutive_pte_address = batch->pte_first_address;
@@ -172,6 +299,17 @@ void uvm_pte_batch_write_pte(uvm_pte_batch_t *batch, uvm_gpu_phys_address_t pte,
     if (pte.aperture == UVM_APERTURE_SYS)
         batch->membar = UVM_MEMBAR_SYS;
 
+    // Sparse writes of the same value, like clearing PTEs one at a time, extend
+    // the pending clear
+    if (batch->pte_count == 0 &&
+        pte_size == sizeof(pte_bits) &&
+        uvm_pte_batch_clear_extends(batch, pte, pte_bits, pte_size)) {
+        ++batch->clear.entry_count;
+        return;
+    }
+
+    uvm_pte_batch_flush_clear(batch);
+
     // Note that pte_count and pte_entry_size can be zero for the first PTE.
     // That's ok as the first PTE will never need a flush.
     if ((batch->pte_count + 1) * batch->pte_entry_size > UVM_PUSH_INLINE_DATA_MAX_SIZE)
@@ -197,17 +335,7 @@ void uvm_pte_batch_write_pte(uvm_pte_batch_t *batch, uvm_gpu_phys_address_t pte,
 
 void uvm_pte_batch_clear_ptes(uvm_pte_batch_t *batch, uvm_gpu_phys_address_t first_pte, NvU64 empty_pte_bits, NvU32 entry_size, NvU32 entry_count)
 {
-    uvm_gpu_t *gpu = uvm_push_get_gpu(batch->push);
-
-    // TODO: Bug 1767241: Allow small clears to batch
-    uvm_pte_batch_flush_ptes(batch);
-
-    uvm_push_set_flag(batch->push, UVM_PUSH_FLAG_CE_NEXT_PIPELINED);
-    uvm_push_set_flag(batch->push, UVM_PUSH_FLAG_NEXT_MEMBAR_NONE);
-    gpu->parent->ce_hal->memset_8(batch->push,
-                                  uvm_mmu_gpu_address(gpu, first_pte),
-                                  empty_pte_bits,
-                                  entry_size * entry_count);
+    uvm_pte_batch_queue_clear(batch, first_pte, empty_pte_bits, entry_size, entry_count);
 
     // PTEs should never be in a location using UVM_APERTURE_SYS_NON_COHERENT.
     UVM_ASSERT(first_pte.aperture != UVM_APERTURE_SYS_NON_COHERENT);
@@ -217,6 +345,16 @@ void uvm_pte_batch_clear_ptes(uvm_pte_batch_t *batch, uvm_gpu_phys_address_t fir
 
 void uvm_pte_batch_end(uvm_pte_batch_t *batch)
 {
+    uvm_gpu_t *gpu = uvm_push_get_gpu(batch->push);
+
     uvm_pte_batch_flush_ptes(batch);
+    uvm_pte_batch_flush_clear(batch);
     uvm_hal_wfi_membar(batch->push, batch->membar);
+
+    if (batch->bytes_written == 0)
+        return;
+
+    atomic64_inc(&gpu->parent->stats.pte_batch.num_batches);
+    atomic64_add(batch->bytes_written, &gpu->parent->stats.pte_batch.bytes_written);
+    atomic64_add(batch->bytes_inline, &gpu->parent->stats.pte_batch.bytes_inline);
 }
@@ -42,6 +42,12 @@
 //       change as inline memcopy would have lower latency.
 #define UVM_PTE_BATCH_MAX_PTES 4
 
+// Min number of consecutive identical PTEs in a uvm_pte_batch_write_ptes()
+// buffer for them to be written with a memset instead of inline data. A memset
+// takes a fixed amount of pushbuffer space, while inline data takes the size of
+// the PTEs.
+#define UVM_PTE_BATCH_MIN_MEMSET_PTES 8
+
 struct uvm_pte_batch_struct
 {
     uvm_push_t *push;
@@ -54,6 +60,23 @@ struct uvm_pte_batch_struct
     NvU64 pte_bits_queue[UVM_PTE_BATCH_MAX_PTES];
     NvU32 pte_count;
 
+    // Pending memset of consecutive PTEs to the same value. Clears and single
+    // PTE writes of the same value that are adjacent to it extend it, so that
+    // long or sparse runs of uniform PTEs are pushed as a single memset.
+    struct
+    {
+        uvm_gpu_phys_address_t first_pte;
+        NvU64 pte_bits;
+        NvU32 entry_size;
+        NvU32 entry_count;
+    } clear;
+
+    // Bytes of PTEs written by the batch, and how many of them were pushed as
+    // inline data. They are added to the GPU's pte_batch stats when the batch
+    // ends.
+    NvU64 bytes_written;
+    NvU64 bytes_inline;
+
     // A membar to be applied after all the PTE writes.
     // Starts out as UVM_MEMBAR_GPU and is promoted to UVM_MEMBAR_SYS if any of
     // the written PTEs are in sysmem.
@@ -73,6 +96,9 @@ void uvm_pte_batch_begin(uvm_push_t *push, uvm_pte_batch_t *batch);
 void uvm_pte_batch_end(uvm_pte_batch_t *batch);
 
 // Queue up a write of PTEs from a buffer
+//
+// Runs of at least UVM_PTE_BATCH_MIN_MEMSET_PTES identical 8-byte PTEs in the
+// buffer are written with a memset.
 void uvm_pte_batch_write_ptes(uvm_pte_batch_t *batch,
         uvm_gpu_phys_address_t first_pte, NvU64 *pte_bits, NvU32 entry_size, NvU32 entry_count);
 
@@ -81,6 +107,8 @@ void uvm_pte_batch_write_pte(uvm_pte_batch_t *batch,
         uvm_gpu_phys_address_t pte, NvU64 pte_bits, NvU32 entry_size);
 
 // Queue up a clear of PTEs
+//
+// The clear is coalesced with adjacent clears to the same value.
 void uvm_pte_batch_clear_ptes(uvm_pte_batch_t *batch,
         uvm_gpu_phys_address_t first_pte, NvU64 pte_bits, NvU32 entry_size, NvU32 entry_count);
 
@@ -138,6 +138,7 @@ void uvm_push_acquire_tracker(uvm_push_t *push, uvm_tracker_t *tracker)
 static NV_STATUS push_reserve_channel(uvm_channel_manager_t *manager,
                                       uvm_channel_type_t channel_type,
                                       uvm_gpu_t *dst_gpu,
+                                      NvU32 channel_hint,
                                       uvm_channel_t **channel)
 {
     NV_STATUS status;
@@ -146,9 +147,9 @@ static NV_STATUS push_reserve_channel(uvm_channel_manager_t *manager,
     // TODO: Bug 1764953: use the dependencies in the tracker to pick a channel
     //       in a smarter way.
     if (dst_gpu == NULL)
-        status = uvm_channel_reserve_type(manager, channel_type, channel);
+        status = uvm_channel_reserve_type_with_hint(manager, channel_type, channel_hint, channel);
     else
-        status = uvm_channel_reserve_gpu_to_gpu(manager, dst_gpu, channel);
+        status = uvm_channel_reserve_gpu_to_gpu_with_hint(manager, dst_gpu, channel_hint, channel);
 
     if (status == NV_OK)
         UVM_ASSERT(*channel);
@@ -238,10 +239,11 @@ static NV_STATUS push_begin_acquire_with_info(uvm_channel_t *channel,
     return NV_OK;
 }
 
-__attribute__ ((format(printf, 9, 10)))
+__attribute__ ((format(printf, 10, 11)))
 NV_STATUS __uvm_push_begin_acquire_with_info(uvm_channel_manager_t *manager,
                                              uvm_channel_type_t type,
                                              uvm_gpu_t *dst_gpu,
+                                             NvU32 channel_hint,
                                              uvm_tracker_t *tracker,
                                              uvm_push_t *push,
                                              const char *filename,
@@ -262,7 +264,7 @@ NV_STATUS __uvm_push_begin_acquire_with_info(uvm_channel_manager_t *manager,
     if (status != NV_OK)
         return status;
 
-    status = push_reserve_channel(manager, type, dst_gpu, &channel);
+    status = push_reserve_channel(manager, type, dst_gpu, channel_hint, &channel);
     if (status != NV_OK)
         return status;
 
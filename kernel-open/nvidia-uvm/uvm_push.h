@@ -191,10 +191,11 @@ bool uvm_push_info_is_tracking_descriptions(void);
 bool uvm_push_info_is_tracking_acquires(void);
 
 // Internal helper for the uvm_push_begin* family of macros
-__attribute__ ((format(printf, 9, 10)))
+__attribute__ ((format(printf, 10, 11)))
 NV_STATUS __uvm_push_begin_acquire_with_info(uvm_channel_manager_t *manager,
                                              uvm_channel_type_t type,
                                              uvm_gpu_t *dst_gpu,
+                                             NvU32 channel_hint,
                                              uvm_tracker_t *tracker,
                                              uvm_push_t *push,
                                              const char *filename,
@@ -230,8 +231,8 @@ NV_STATUS __uvm_push_begin_on_reserved_channel_with_info(uvm_channel_t *channel,
 //
 // Locking: on success acquires the concurrent push semaphore until
 //          uvm_push_end()
-#define uvm_push_begin(manager, type, push, format, ...)                      \
-    __uvm_push_begin_acquire_with_info((manager), (type), NULL, NULL, (push), \
+#define uvm_push_begin(manager, type, push, format, ...)                         \
+    __uvm_push_begin_acquire_with_info((manager), (type), NULL, 0, NULL, (push), \
         __FILE__, __FUNCTION__, __LINE__, (format), ##__VA_ARGS__)
 
 // Begin a push on a channel of channel_type type with dependencies in the
@@ -244,21 +245,39 @@ NV_STATUS __uvm_push_begin_on_reserved_channel_with_info(uvm_channel_t *channel,
 //
 // Locking: on success acquires the concurrent push semaphore until
 //          uvm_push_end()
-#define uvm_push_begin_acquire(manager, type, tracker, push, format, ...)          \
-    __uvm_push_begin_acquire_with_info((manager), (type), NULL, (tracker), (push), \
+#define uvm_push_begin_acquire(manager, type, tracker, push, format, ...)             \
+    __uvm_push_begin_acquire_with_info((manager), (type), NULL, 0, (tracker), (push), \
         __FILE__, __FUNCTION__, __LINE__, (format), ##__VA_ARGS__)
 
 // Specialization of uvm_push_begin that is optimized for pushes that
 // transfer data from manager->gpu to dst_gpu.
 // dst_gpu must be NULL or a GPU other than manager->gpu
-#define uvm_push_begin_gpu_to_gpu(manager, dst_gpu, push, format, ...)                                  \
-    __uvm_push_begin_acquire_with_info((manager), UVM_CHANNEL_TYPE_GPU_TO_GPU, (dst_gpu), NULL, (push), \
+#define uvm_push_begin_gpu_to_gpu(manager, dst_gpu, push, format, ...)                                     \
+    __uvm_push_begin_acquire_with_info((manager), UVM_CHANNEL_TYPE_GPU_TO_GPU, (dst_gpu), 0, NULL, (push), \
         __FILE__, __FUNCTION__, __LINE__, (format), ##__VA_ARGS__)
 
 // Same as uvm_push_begin_gpu_to_gpu except it also acquires the input tracker
 // for the caller
-#define uvm_push_begin_acquire_gpu_to_gpu(manager, dst_gpu, tracker, push, format, ...)                      \
-    __uvm_push_begin_acquire_with_info((manager), UVM_CHANNEL_TYPE_GPU_TO_GPU, (dst_gpu), (tracker), (push), \
+#define uvm_push_begin_acquire_gpu_to_gpu(manager, dst_gpu, tracker, push, format, ...)                         \
+    __uvm_push_begin_acquire_with_info((manager), UVM_CHANNEL_TYPE_GPU_TO_GPU, (dst_gpu), 0, (tracker), (push), \
+        __FILE__, __FUNCTION__, __LINE__, (format), ##__VA_ARGS__)
+
+// Same as uvm_push_begin_acquire and uvm_push_begin_acquire_gpu_to_gpu, except
+// that the channel is picked starting at the channel with index
+// (channel_hint % num_channels) in the pool selected for the push. Callers
+// issuing many independent pushes can use different hints to spread them
+// across the channels of the pool. See uvm_channel_reserve_type_with_hint().
+#define uvm_push_begin_acquire_with_hint(manager, type, channel_hint, tracker, push, format, ...)  \
+    __uvm_push_begin_acquire_with_info((manager), (type), NULL, (channel_hint), (tracker), (push), \
+        __FILE__, __FUNCTION__, __LINE__, (format), ##__VA_ARGS__)
+
+#define uvm_push_begin_acquire_gpu_to_gpu_with_hint(manager, dst_gpu, channel_hint, tracker, push, format, ...) \
+    __uvm_push_begin_acquire_with_info((manager),                                                             \
+                                       UVM_CHANNEL_TYPE_GPU_TO_GPU,                                           \
+                                       (dst_gpu),                                                             \
+                                       (channel_hint),                                                        \
+                                       (tracker),                                                             \
+                                       (push),                                                                \
         __FILE__, __FUNCTION__, __LINE__, (format), ##__VA_ARGS__)
 
 // Begin a push on a specific channel
@@ -239,6 +239,7 @@ static uvm_pushbuffer_chunk_t *pick_chunk(uvm_pushbuffer_t *pushbuffer)
 static bool try_claim_chunk(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push, uvm_pushbuffer_chunk_t **chunk_out)
 {
     uvm_pushbuffer_chunk_t *chunk;
+    NvU32 busy_chunks;
 
     uvm_spin_lock(&pushbuffer->lock);
 
@@ -246,6 +247,14 @@ static bool try_claim_chunk(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push, uvm_
     if (!chunk)
         goto done;
 
+    // Sample the number of chunks not available for new pushes, excluding the
+    // one being claimed. The statistics are only visible in debug procfs.
+    if (uvm_procfs_is_debug_enabled()) {
+        busy_chunks = UVM_PUSHBUFFER_CHUNKS - bitmap_weight(pushbuffer->available_chunks, UVM_PUSHBUFFER_CHUNKS);
+        atomic64_inc(&pushbuffer->stats.occupancy_histogram[
+                     uvm_channel_occupancy_histogram_bucket(busy_chunks, UVM_PUSHBUFFER_CHUNKS)]);
+    }
+
     chunk->current_push = push;
     clear_chunk(pushbuffer, chunk, pushbuffer->idle_chunks);
     clear_chunk(pushbuffer, chunk, pushbuffer->available_chunks);
@@ -288,10 +297,16 @@ static NV_STATUS claim_chunk(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push, uvm
     NV_STATUS status = NV_OK;
     uvm_channel_manager_t *channel_manager = pushbuffer->channel_manager;
     uvm_spin_loop_t spin;
+    NvU64 wait_start_ns;
+    NvU64 wait_ns;
 
-    if (try_claim_chunk(pushbuffer, push, chunk_out))
+    if (try_claim_chunk(pushbuffer, push, chunk_out)) {
+        if (uvm_procfs_is_debug_enabled())
+            atomic64_inc(&pushbuffer->stats.num_claims);
         return NV_OK;
+    }
 
+    wait_start_ns = NV_GETTIME();
     uvm_channel_manager_update_progress(channel_manager);
 
     uvm_spin_loop_init(&spin);
@@ -301,7 +316,19 @@ static NV_STATUS claim_chunk(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push, uvm
         uvm_channel_manager_update_progress(channel_manager);
     }
 
-    return status;
+    if (status != NV_OK)
+        return status;
+
+    if (!uvm_procfs_is_debug_enabled())
+        return NV_OK;
+
+    wait_ns = NV_GETTIME() - wait_start_ns;
+    atomic64_inc(&pushbuffer->stats.num_claims);
+    atomic64_inc(&pushbuffer->stats.num_stalls);
+    atomic64_add(wait_ns, &pushbuffer->stats.stall_ns);
+    atomic64_inc(&pushbuffer->stats.stall_histogram[uvm_channel_wait_histogram_bucket(wait_ns)]);
+
+    return NV_OK;
 }
 
 NV_STATUS uvm_pushbuffer_begin_push(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push)
@@ -645,6 +672,8 @@ bool uvm_pushbuffer_has_space(uvm_pushbuffer_t *pushbuffer)
 void uvm_pushbuffer_print_common(uvm_pushbuffer_t *pushbuffer, struct seq_file *s)
 {
     NvU32 i;
+    NvU64 num_stalls;
+    NvU64 stall_ns;
 
     UVM_SEQ_OR_DBG_PRINT(s, "Pushbuffer for GPU %s\n", uvm_gpu_name(pushbuffer->channel_manager->gpu));
     UVM_SEQ_OR_DBG_PRINT(s, " has space: %d\n", uvm_pushbuffer_has_space(pushbuffer));
@@ -664,6 +693,18 @@ void uvm_pushbuffer_print_common(uvm_pushbuffer_t *pushbuffer, struct seq_file *
     }
 
     uvm_spin_unlock(&pushbuffer->lock);
+
+    num_stalls = atomic64_read(&pushbuffer->stats.num_stalls);
+    stall_ns = atomic64_read(&pushbuffer->stats.stall_ns);
+
+    UVM_SEQ_OR_DBG_PRINT(s, " claims %llu\n", (NvU64)atomic64_read(&pushbuffer->stats.num_claims));
+    UVM_SEQ_OR_DBG_PRINT(s, " claim stalls %llu\n", num_stalls);
+    UVM_SEQ_OR_DBG_PRINT(s, " stall time us %llu\n", stall_ns / 1000);
+    UVM_SEQ_OR_DBG_PRINT(s, " avg stall us %llu\n", num_stalls ? stall_ns / 1000 / num_stalls : 0);
+    UVM_SEQ_OR_DBG_PRINT(s, " stall histogram:\n");
+    uvm_channel_print_wait_histogram(pushbuffer->stats.stall_histogram, s);
+    UVM_SEQ_OR_DBG_PRINT(s, " chunk occupancy histogram:\n");
+    uvm_channel_print_occupancy_histogram(pushbuffer->stats.occupancy_histogram, s);
 }
 
 void uvm_pushbuffer_print(uvm_pushbuffer_t *pushbuffer)
@@ -155,6 +155,13 @@
 // uvm_push_end().
 #define UVM_PUSH_MAX_CONCURRENT_PUSHES UVM_PUSHBUFFER_CHUNKS
 
+// Number of log2 microsecond buckets in the histograms of time spent waiting
+// for channel GPFIFO entries and pushbuffer chunks when beginning a push
+#define UVM_PUSH_WAIT_HISTOGRAM_BUCKETS 12
+
+// Number of quartile buckets in the GPFIFO and pushbuffer occupancy histograms
+#define UVM_PUSH_OCCUPANCY_HISTOGRAM_BUCKETS 4
+
 // Push space needed for static part for the WLC schedule, as initialized in
 // 'setup_wlc_schedule':
 // * CE decrypt (of WLC PB): 56B
@@ -238,6 +245,24 @@ struct uvm_pushbuffer_struct
     // are supported.
     uvm_semaphore_t concurrent_pushes_sema;
 
+    // Chunk claim statistics, printed in the pushbuffer procfs file. Only
+    // collected when debug procfs is enabled.
+    struct
+    {
+        // Number of chunks claimed for pushes
+        atomic64_t num_claims;
+
+        // Claims that found no available chunk and had to wait for pending
+        // pushes to complete, the total time spent waiting, and its
+        // distribution
+        atomic64_t num_stalls;
+        atomic64_t stall_ns;
+        atomic64_t stall_histogram[UVM_PUSH_WAIT_HISTOGRAM_BUCKETS];
+
+        // Number of chunks in use by other pushes, sampled on each claim
+        atomic64_t occupancy_histogram[UVM_PUSH_OCCUPANCY_HISTOGRAM_BUCKETS];
+    } stats;
+
     struct
     {
         struct proc_dir_entry *info_file;
@@ -0,0 +1,249 @@
+/*******************************************************************************
+    Copyright (c) 2026 NVIDIA Corporation
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to
+    deal in the Software without restriction, including without limitation the
+    rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+    sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+        The above copyright notice and this permission notice shall be
+        included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*******************************************************************************/
+
+#include "uvm_sort.h"
+#include "uvm_gpu.h"
+#include "uvm_kvmalloc.h"
+
+// Batches with up to this many elements are insertion sorted. Below this size
+// the radix sort passes are dominated by the histogram setup.
+#define UVM_SORT_KEY_INSERTION_SORT_MAX 16
+
+NV_STATUS uvm_sort_key_context_init(uvm_sort_key_context_t *context, NvU32 max_entries, int node)
+{
+    context->entries = uvm_kvmalloc_node(max_entries * sizeof(*context->entries), node);
+    context->scratch = uvm_kvmalloc_node(max_entries * sizeof(*context->scratch), node);
+    if (!context->entries || !context->scratch) {
+        uvm_sort_key_context_deinit(context);
+        return NV_ERR_NO_MEMORY;
+    }
+
+    context->max_entries = max_entries;
+
+    return NV_OK;
+}
+
+void uvm_sort_key_context_deinit(uvm_sort_key_context_t *context)
+{
+    uvm_kvfree(context->entries);
+    uvm_kvfree(context->scratch);
+    context->entries = NULL;
+    context->scratch = NULL;
+    context->max_entries = 0;
+}
+
+void uvm_sort_key_begin(uvm_sort_key_context_t *context, NvU32 low_bits)
+{
+    UVM_ASSERT(low_bits < 64);
+
+    context->num_groups = 0;
+    context->last_group = 0;
+    context->overflow = false;
+    context->min_address = ~0ULL;
+    context->max_address = 0;
+    context->address_or = 0;
+    context->low_bits = low_bits;
+}
+
+// Returns the index of the {va_space, gpu} pair in context->groups, or
+// context->num_groups if it is not there.
+static NvU32 find_group(uvm_sort_key_context_t *context, uvm_va_space_t *va_space, uvm_gpu_t *gpu)
+{
+    NvU32 i;
+
+    if (context->num_groups > 0 &&
+        context->groups[context->last_group].va_space == va_space &&
+        context->groups[context->last_group].gpu == gpu)
+        return context->last_group;
+
+    for (i = 0; i < context->num_groups; ++i) {
+        if (context->groups[i].va_space == va_space && context->groups[i].gpu == gpu) {
+            context->last_group = i;
+            break;
+        }
+    }
+
+    return i;
+}
+
+void uvm_sort_key_add(uvm_sort_key_context_t *context, uvm_va_space_t *va_space, uvm_gpu_t *gpu, NvU64 address)
+{
+    NvU32 group;
+
+    if (context->overflow)
+        return;
+
+    group = find_group(context, va_space, gpu);
+    if (group == context->num_groups) {
+        if (group == UVM_SORT_KEY_MAX_GROUPS) {
+            context->overflow = true;
+            return;
+        }
+
+        context->groups[group].va_space = va_space;
+        context->groups[group].gpu = gpu;
+        context->last_group = group;
+        ++context->num_groups;
+    }
+
+    context->min_address = min(context->min_address, address);
+    context->max_address = max(context->max_address, address);
+    context->address_or |= address;
+}
+
+// Sort comparator for {va_space, gpu} pairs. It must match the ordering of the
+// comparison sorts that uvm_sort_key replaces: by va_space pointer and then by
+// GPU id, with NULL GPUs first.
+static int cmp_sort_key_group(const void *_a, const void *_b)
+{
+    const uvm_sort_key_group_t *a = (const uvm_sort_key_group_t *)_a;
+    const uvm_sort_key_group_t *b = (const uvm_sort_key_group_t *)_b;
+    NvU32 id_a = a->gpu ? uvm_id_value(a->gpu->id) : 0;
+    NvU32 id_b = b->gpu ? uvm_id_value(b->gpu->id) : 0;
+    int result;
+
+    result = UVM_CMP_DEFAULT(a->va_space, b->va_space);
+    if (result != 0)
+        return result;
+
+    return UVM_CMP_DEFAULT(id_a, id_b);
+}
+
+bool uvm_sort_key_finalize(uvm_sort_key_context_t *context)
+{
+    NvU32 group_bits;
+
+    if (context->overflow)
+        return false;
+
+    if (context->num_groups == 0)
+        return true;
+
+    sort(context->groups, context->num_groups, sizeof(context->groups[0]), cmp_sort_key_group, NULL);
+    context->last_group = 0;
+
+    // All addresses, and hence their distances to the smallest one, are
+    // multiples of the lowest bit set in any of them.
+    context->address_shift = context->address_or ? __ffs64(context->address_or) : 0;
+    context->address_bits = fls64((context->max_address - context->min_address) >> context->address_shift);
+
+    group_bits = fls(context->num_groups - 1);
+
+    return group_bits + context->address_bits + context->low_bits <= 64;
+}
+
+NvU64 uvm_sort_key_pack(uvm_sort_key_context_t *context,
+                        uvm_va_space_t *va_space,
+                        uvm_gpu_t *gpu,
+                        NvU64 address,
+                        NvU32 low)
+{
+    NvU64 group = find_group(context, va_space, gpu);
+    NvU64 key;
+
+    UVM_ASSERT(group < context->num_groups);
+    UVM_ASSERT(address >= context->min_address);
+    UVM_ASSERT(address <= context->max_address);
+    UVM_ASSERT(((NvU64)low >> context->low_bits) == 0);
+
+    key = (address - context->min_address) >> context->address_shift;
+    key = (key << context->low_bits) | low;
+
+    // With a single group the address and low fields may take the whole key
+    if (context->num_groups > 1)
+        key |= group << (context->address_bits + context->low_bits);
+
+    return key;
+}
+
+static void insertion_sort_entries(uvm_sort_key_entry_t *entries, NvU32 num_entries)
+{
+    NvU32 i;
+
+    for (i = 1; i < num_entries; ++i) {
+        uvm_sort_key_entry_t entry = entries[i];
+        NvU32 j = i;
+
+        while (j > 0 && entries[j - 1].key > entry.key) {
+            entries[j] = entries[j - 1];
+            --j;
+        }
+
+        entries[j] = entry;
+    }
+}
+
+void uvm_sort_key_entries(uvm_sort_key_context_t *context, NvU32 num_entries)
+{
+    uvm_sort_key_entry_t *src = context->entries;
+    uvm_sort_key_entry_t *dst = context->scratch;
+    NvU64 keys_and = ~0ULL;
+    NvU64 keys_or = 0;
+    NvU32 shift;
+    NvU32 i;
+
+    UVM_ASSERT(num_entries <= context->max_entries);
+
+    if (num_entries <= UVM_SORT_KEY_INSERTION_SORT_MAX) {
+        insertion_sort_entries(src, num_entries);
+        return;
+    }
+
+    for (i = 0; i < num_entries; ++i) {
+        keys_and &= src[i].key;
+        keys_or |= src[i].key;
+    }
+
+    // LSD radix sort. Each pass is a stable counting sort on one digit.
+    for (shift = 0; shift < 64; shift += UVM_SORT_KEY_RADIX_BITS) {
+        NvU32 *counts = context->counts;
+        NvU32 digit;
+        NvU32 sum = 0;
+
+        // Skip the digits in which all the keys agree, since the pass would
+        // not reorder anything. Packed keys are narrow, so most passes are
+        // skipped.
+        if ((((keys_and ^ keys_or) >> shift) & (UVM_SORT_KEY_RADIX - 1)) == 0)
+            continue;
+
+        memset(counts, 0, sizeof(context->counts));
+
+        for (i = 0; i < num_entries; ++i)
+            ++counts[(src[i].key >> shift) & (UVM_SORT_KEY_RADIX - 1)];
+
+        for (digit = 0; digit < UVM_SORT_KEY_RADIX; ++digit) {
+            NvU32 count = counts[digit];
+
+            counts[digit] = sum;
+            sum += count;
+        }
+
+        for (i = 0; i < num_entries; ++i)
+            dst[counts[(src[i].key >> shift) & (UVM_SORT_KEY_RADIX - 1)]++] = src[i];
+
+        swap(src, dst);
+    }
+
+    if (src != context->entries)
+        memcpy(context->entries, src, num_entries * sizeof(*src));
+}
@@ -0,0 +1,148 @@
+/*******************************************************************************
+    Copyright (c) 2026 NVIDIA Corporation
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to
+    deal in the Software without restriction, including without limitation the
+    rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+    sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+        The above copyright notice and this permission notice shall be
+        included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*******************************************************************************/
+
+#ifndef __UVM_SORT_H__
+#define __UVM_SORT_H__
+
+#include "uvm_common.h"
+#include "uvm_forward_decl.h"
+#include "uvm_hal_types.h"
+
+// Maximum number of distinct {va_space, gpu} pairs that can be packed into the
+// keys of a single sort. Batches referencing more pairs must fall back to a
+// comparison sort.
+#define UVM_SORT_KEY_MAX_GROUPS 32
+
+#define UVM_SORT_KEY_RADIX_BITS 8
+#define UVM_SORT_KEY_RADIX      (1 << UVM_SORT_KEY_RADIX_BITS)
+
+typedef struct
+{
+    uvm_va_space_t *va_space;
+    uvm_gpu_t *gpu;
+} uvm_sort_key_group_t;
+
+// Element of the arrays sorted by uvm_sort_key_entries. ptr is opaque to the
+// sort and is carried along with its key.
+typedef struct
+{
+    NvU64 key;
+    void *ptr;
+} uvm_sort_key_entry_t;
+
+// Fault and access counter batches are sorted by {va_space, GPU id, address,
+// low field} tuples. Instead of a comparison sort with a multi-key comparator,
+// each tuple is packed into a 64-bit key whose unsigned ordering matches the
+// tuple ordering, and the keys are radix sorted in linear time:
+//
+// 1) uvm_sort_key_begin
+// 2) uvm_sort_key_add for every element
+// 3) uvm_sort_key_finalize. If it returns false the tuples in the batch don't
+//    fit in 64 bits and the caller must use a comparison sort instead.
+// 4) Fill context->entries with the keys returned by uvm_sort_key_pack
+// 5) uvm_sort_key_entries
+//
+// The {va_space, gpu} pair is replaced by its rank among the distinct pairs in
+// the batch and the address is stored relative to the smallest address in the
+// batch, shifted by the largest alignment common to all addresses. This keeps
+// the keys narrow enough for the common case of a handful of VA spaces.
+//
+// The context is too large to be placed on the stack and it is not thread
+// safe. It is meant to be embedded in the batch contexts, which are protected
+// by the corresponding service locks.
+typedef struct
+{
+    // Arrays of max_entries elements. The entries to be sorted are stored in
+    // entries, and scratch is used as the radix sort destination buffer.
+    uvm_sort_key_entry_t *entries;
+    uvm_sort_key_entry_t *scratch;
+    NvU32 max_entries;
+
+    NvU32 counts[UVM_SORT_KEY_RADIX];
+
+    // Distinct {va_space, gpu} pairs seen in the batch. After
+    // uvm_sort_key_finalize they are sorted so the index of a pair is its rank.
+    uvm_sort_key_group_t groups[UVM_SORT_KEY_MAX_GROUPS];
+
+    NvU32 num_groups;
+
+    // Index of the last pair looked up. Batches are mostly made of long runs
+    // of elements with the same pair.
+    NvU32 last_group;
+
+    // Set when the batch references more than UVM_SORT_KEY_MAX_GROUPS pairs
+    bool overflow;
+
+    NvU64 min_address;
+    NvU64 max_address;
+    NvU64 address_or;
+
+    NvU32 address_shift;
+    NvU32 address_bits;
+    NvU32 low_bits;
+} uvm_sort_key_context_t;
+
+NV_STATUS uvm_sort_key_context_init(uvm_sort_key_context_t *context, NvU32 max_entries, int node);
+void uvm_sort_key_context_deinit(uvm_sort_key_context_t *context);
+
+// Start packing a new batch. low_bits is the width of the low field passed to
+// uvm_sort_key_pack, which is compared after the address.
+void uvm_sort_key_begin(uvm_sort_key_context_t *context, NvU32 low_bits);
+
+// Account for an element in the batch. gpu may be NULL.
+void uvm_sort_key_add(uvm_sort_key_context_t *context, uvm_va_space_t *va_space, uvm_gpu_t *gpu, NvU64 address);
+
+// Compute the key layout for the batch. Returns false if the batch cannot be
+// sorted with packed keys.
+bool uvm_sort_key_finalize(uvm_sort_key_context_t *context);
+
+// Pack the key of an element previously passed to uvm_sort_key_add. low must
+// fit in the low_bits given to uvm_sort_key_begin.
+NvU64 uvm_sort_key_pack(uvm_sort_key_context_t *context,
+                        uvm_va_space_t *va_space,
+                        uvm_gpu_t *gpu,
+                        NvU64 address,
+                        NvU32 low);
+
+// Pack an {instance_ptr, ve_id} pair into a key whose ordering matches
+// uvm_gpu_phys_addr_cmp followed by the ve_id comparison. Returns false if the
+// pair doesn't fit in 64 bits.
+static bool uvm_sort_key_instance_ptr(uvm_gpu_phys_address_t instance_ptr, NvU32 ve_id, NvU64 *key)
+{
+    // Instance pointers are 4K-aligned. 4 bits for the aperture, 52 for the
+    // address and 8 for the ve_id.
+    BUILD_BUG_ON(UVM_APERTURE_MAX > 16);
+
+    if (!IS_ALIGNED(instance_ptr.address, UVM_PAGE_SIZE_4K) || ve_id > 0xff)
+        return false;
+
+    *key = ((NvU64)instance_ptr.aperture << 60) | ((instance_ptr.address >> 12) << 8) | ve_id;
+
+    return true;
+}
+
+// Stable sort of the first num_entries elements of context->entries in
+// ascending key order.
+void uvm_sort_key_entries(uvm_sort_key_context_t *context, NvU32 num_entries);
+
+#endif // __UVM_SORT_H__
@@ -0,0 +1,183 @@
+/*******************************************************************************
+    Copyright (c) 2026 NVIDIA Corporation
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to
+    deal in the Software without restriction, including without limitation the
+    rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+    sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+        The above copyright notice and this permission notice shall be
+        included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*******************************************************************************/
+
+#include "uvm_common.h"
+#include "uvm_sort.h"
+#include "uvm_kvmalloc.h"
+#include "uvm_test.h"
+#include "uvm_test_ioctl.h"
+#include "uvm_test_rng.h"
+
+#define SORT_TEST_MAX_ENTRIES (1024 * 1024)
+
+// Fault-like tuple. The VA space pointers are fake and never dereferenced.
+typedef struct
+{
+    uvm_va_space_t *va_space;
+    NvU64 address;
+    uvm_fault_access_type_t access_type;
+} sort_test_entry_t;
+
+// Same ordering as cmp_sort_fault_entry_by_va_space_gpu_address_access_type
+static int cmp_sort_test_entry(const void *_a, const void *_b)
+{
+    const sort_test_entry_t *a = *(const sort_test_entry_t **)_a;
+    const sort_test_entry_t *b = *(const sort_test_entry_t **)_b;
+    int result;
+
+    result = UVM_CMP_DEFAULT(a->va_space, b->va_space);
+    if (result != 0)
+        return result;
+
+    result = UVM_CMP_DEFAULT(a->address, b->address);
+    if (result != 0)
+        return result;
+
+    return UVM_CMP_DEFAULT(b->access_type, a->access_type);
+}
+
+static bool sort_test_entries_by_keys(uvm_sort_key_context_t *sort_context,
+                                      sort_test_entry_t **ordered,
+                                      NvU32 num_entries)
+{
+    NvU32 i;
+
+    uvm_sort_key_begin(sort_context, order_base_2(UVM_FAULT_ACCESS_TYPE_COUNT));
+
+    for (i = 0; i < num_entries; ++i)
+        uvm_sort_key_add(sort_context, ordered[i]->va_space, NULL, ordered[i]->address);
+
+    if (!uvm_sort_key_finalize(sort_context))
+        return false;
+
+    for (i = 0; i < num_entries; ++i) {
+        sort_context->entries[i].key = uvm_sort_key_pack(sort_context,
+                                                         ordered[i]->va_space,
+                                                         NULL,
+                                                         ordered[i]->address,
+                                                         UVM_FAULT_ACCESS_TYPE_COUNT - 1 - ordered[i]->access_type);
+        sort_context->entries[i].ptr = ordered[i];
+    }
+
+    uvm_sort_key_entries(sort_context, num_entries);
+
+    for (i = 0; i < num_entries; ++i)
+        ordered[i] = sort_context->entries[i].ptr;
+
+    return true;
+}
+
+NV_STATUS uvm_test_sort_keys_perf(UVM_TEST_SORT_KEYS_PERF_PARAMS *params, struct file *filp)
+{
+    NV_STATUS status = NV_OK;
+    uvm_test_rng_t rng;
+    sort_test_entry_t *entries = NULL;
+    sort_test_entry_t **radix_ordered = NULL;
+    sort_test_entry_t **comparison_ordered = NULL;
+    uvm_sort_key_context_t *sort_context = NULL;
+    NvU64 radix_sort_ns = 0;
+    NvU64 comparison_sort_ns = 0;
+    bool fits = false;
+    NvU32 iter;
+    NvU32 i;
+
+    if (params->num_entries == 0 ||
+        params->num_entries > SORT_TEST_MAX_ENTRIES ||
+        params->num_va_spaces == 0 ||
+        params->iterations == 0)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    entries = uvm_kvmalloc(params->num_entries * sizeof(*entries));
+    radix_ordered = uvm_kvmalloc(params->num_entries * sizeof(*radix_ordered));
+    comparison_ordered = uvm_kvmalloc(params->num_entries * sizeof(*comparison_ordered));
+    sort_context = uvm_kvmalloc_zero(sizeof(*sort_context));
+    if (!entries || !radix_ordered || !comparison_ordered || !sort_context) {
+        status = NV_ERR_NO_MEMORY;
+        goto done;
+    }
+
+    status = uvm_sort_key_context_init(sort_context, params->num_entries, NUMA_NO_NODE);
+    if (status != NV_OK)
+        goto done;
+
+    uvm_test_rng_init(&rng, params->seed);
+
+    // 4K-aligned addresses within a 48-bit VA space, like the ones reported
+    // in GPU faults
+    for (i = 0; i < params->num_entries; ++i) {
+        NvUPtr va_space = ((NvUPtr)uvm_test_rng_range_32(&rng, 0, params->num_va_spaces - 1) + 1) * PAGE_SIZE;
+
+        entries[i].va_space = (uvm_va_space_t *)va_space;
+        entries[i].address = uvm_test_rng_range_64(&rng, 0, (1ULL << 48) - 1) & ~(UVM_PAGE_SIZE_4K - 1);
+        entries[i].access_type = uvm_test_rng_range_32(&rng, 0, UVM_FAULT_ACCESS_TYPE_COUNT - 1);
+    }
+
+    for (iter = 0; iter < params->iterations; ++iter) {
+        NvU64 start;
+
+        for (i = 0; i < params->num_entries; ++i) {
+            radix_ordered[i] = &entries[i];
+            comparison_ordered[i] = &entries[i];
+        }
+
+        start = NV_GETTIME();
+        fits = sort_test_entries_by_keys(sort_context, radix_ordered, params->num_entries);
+        radix_sort_ns += NV_GETTIME() - start;
+
+        start = NV_GETTIME();
+        sort(comparison_ordered, params->num_entries, sizeof(*comparison_ordered), cmp_sort_test_entry, NULL);
+        comparison_sort_ns += NV_GETTIME() - start;
+
+        if (fits) {
+            // Entries that compare equal may be in different order, so compare
+            // the tuples rather than the pointers
+            for (i = 0; i < params->num_entries; ++i)
+                TEST_CHECK_GOTO(cmp_sort_test_entry(&radix_ordered[i], &comparison_ordered[i]) == 0, done);
+        }
+        else {
+            TEST_CHECK_GOTO(params->num_va_spaces > UVM_SORT_KEY_MAX_GROUPS, done);
+        }
+
+        if (fatal_signal_pending(current)) {
+            status = NV_ERR_SIGNAL_PENDING;
+            goto done;
+        }
+
+        // Let other threads run
+        schedule();
+    }
+
+    params->radix_sort_ns = fits ? radix_sort_ns / params->iterations : 0;
+    params->comparison_sort_ns = comparison_sort_ns / params->iterations;
+
+done:
+    if (sort_context)
+        uvm_sort_key_context_deinit(sort_context);
+
+    uvm_kvfree(sort_context);
+    uvm_kvfree(comparison_ordered);
+    uvm_kvfree(radix_ordered);
+    uvm_kvfree(entries);
+
+    return status;
+}
@@ -828,6 +828,11 @@ typedef enum
 {
     UVM_TEST_PAGE_PREFETCH_POLICY_ENABLE = 0,
     UVM_TEST_PAGE_PREFETCH_POLICY_DISABLE,
+
+    // Enable/disable the cross-VA block stream prefetcher. It only takes
+    // effect while page prefetching is enabled.
+    UVM_TEST_PAGE_PREFETCH_POLICY_STREAM_ENABLE,
+    UVM_TEST_PAGE_PREFETCH_POLICY_STREAM_DISABLE,
     UVM_TEST_PAGE_PREFETCH_POLICY_MAX
 } UVM_TEST_PAGE_PREFETCH_POLICY;
 
@@ -1629,6 +1634,27 @@ typedef struct
     NV_STATUS                       rmStatus;                   // Out
 } UVM_TEST_SET_NON_REPLAYABLE_DELAY_PARAMS;
 
+// Sort num_entries randomly generated {va_space, address, access type} tuples
+// with the packed key radix sort used to preprocess fault and access counter
+// batches, and with the comparison sort it replaces, checking that both
+// produce the same order. Each sort is run iterations times and the average
+// time per sort, including key packing, is returned.
+//
+// The tuples are spread across num_va_spaces fake VA spaces. If num_va_spaces
+// is larger than the number of VA spaces that can be packed into the keys,
+// only the fallback detection is tested and radix_sort_ns is 0.
+#define UVM_TEST_SORT_KEYS_PERF                          UVM_TEST_IOCTL_BASE(115)
+typedef struct
+{
+    NvU32                           num_entries;                                        // In
+    NvU32                           num_va_spaces;                                      // In
+    NvU32                           iterations;                                         // In
+    NvU32                           seed;                                               // In
+    NvU64                           radix_sort_ns                    NV_ALIGN_BYTES(8); // Out
+    NvU64                           comparison_sort_ns               NV_ALIGN_BYTES(8); // Out
+    NV_STATUS                       rmStatus;                                           // Out
+} UVM_TEST_SORT_KEYS_PERF_PARAMS;
+
 #ifdef __cplusplus
 }
 #endif
@@ -77,6 +77,22 @@ static void tlb_batch_flush_invalidate_per_va(uvm_tlb_batch_t *batch, uvm_push_t
     }
 }
 
+static void tlb_batch_flush_invalidate_span(uvm_tlb_batch_t *batch, uvm_push_t *push)
+{
+    uvm_page_tree_t *tree = batch->tree;
+    NvU32 page_table_depth = tree->hal->page_table_depth(batch->biggest_page_size);
+
+    // All the queued up ranges are aligned to their smallest page size, so the
+    // span is aligned to the smallest page size across all of them.
+    tree->gpu->parent->host_hal->tlb_invalidate_va(push,
+                                                   uvm_page_tree_pdb_address(tree),
+                                                   page_table_depth,
+                                                   batch->span_start,
+                                                   batch->span_end - batch->span_start,
+                                                   batch->smallest_page_size,
+                                                   batch->membar);
+}
+
 static void tlb_batch_flush_invalidate_all(uvm_tlb_batch_t *batch, uvm_push_t *push)
 {
     uvm_page_tree_t *tree = batch->tree;
@@ -86,7 +102,7 @@ static void tlb_batch_flush_invalidate_all(uvm_tlb_batch_t *batch, uvm_push_t *p
     gpu->parent->host_hal->tlb_invalidate_all(push, uvm_page_tree_pdb_address(tree), page_table_depth, batch->membar);
 }
 
-static bool tlb_batch_should_invalidate_all(uvm_tlb_batch_t *batch)
+static bool tlb_batch_should_coalesce(uvm_tlb_batch_t *batch)
 {
     if (batch->count > UVM_TLB_BATCH_MAX_ENTRIES)
         return true;
@@ -94,6 +110,13 @@ static bool tlb_batch_should_invalidate_all(uvm_tlb_batch_t *batch)
     return batch->total_ranges > batch->tree->gpu->parent->tlb_batch.max_ranges;
 }
 
+static bool tlb_batch_should_invalidate_all(uvm_tlb_batch_t *batch)
+{
+    NvU64 span_pages = (batch->span_end - batch->span_start) / batch->smallest_page_size;
+
+    return span_pages > UVM_TLB_BATCH_MAX_SPAN_PAGES;
+}
+
 void uvm_tlb_batch_end(uvm_tlb_batch_t *batch, uvm_push_t *push, uvm_membar_t tlb_membar)
 {
     if (batch->count == 0)
@@ -101,10 +124,35 @@ void uvm_tlb_batch_end(uvm_tlb_batch_t *batch, uvm_push_t *push, uvm_membar_t tl
 
     batch->membar = uvm_membar_max(tlb_membar, batch->membar);
 
-    if (tlb_batch_should_invalidate_all(batch))
-        tlb_batch_flush_invalidate_all(batch, push);
-    else
+    if (!tlb_batch_should_coalesce(batch))
         tlb_batch_flush_invalidate_per_va(batch, push);
+    else if (!tlb_batch_should_invalidate_all(batch))
+        tlb_batch_flush_invalidate_span(batch, push);
+    else
+        tlb_batch_flush_invalidate_all(batch, push);
+}
+
+// Merge [start, start + size) into a queued up range if they overlap or are
+// adjacent. Returns true if the range was merged.
+static bool tlb_batch_try_merge(uvm_tlb_batch_t *batch, NvU64 start, NvU64 size, NvU64 page_sizes)
+{
+    NvU32 i;
+
+    for (i = 0; i < batch->count; ++i) {
+        uvm_tlb_batch_range_t *entry = &batch->ranges[i];
+        NvU64 entry_end = entry->start + entry->size;
+
+        if (start > entry_end || start + size < entry->start)
+            continue;
+
+        entry->start = min(entry->start, start);
+        entry->size = max(entry_end, start + size) - entry->start;
+        entry->page_sizes |= page_sizes;
+
+        return true;
+    }
+
+    return false;
 }
 
 void uvm_tlb_batch_invalidate(uvm_tlb_batch_t *batch, NvU64 start, NvU64 size, NvU64 page_sizes, uvm_membar_t tlb_membar)
@@ -113,13 +161,29 @@ void uvm_tlb_batch_invalidate(uvm_tlb_batch_t *batch, NvU64 start, NvU64 size, N
 
     batch->membar = uvm_membar_max(tlb_membar, batch->membar);
 
+    batch->biggest_page_size = max(batch->biggest_page_size, biggest_page_size(page_sizes));
+
+    if (batch->count == 0) {
+        batch->smallest_page_size = smallest_page_size(page_sizes);
+        batch->span_start = start;
+        batch->span_end = start + size;
+    }
+    else {
+        batch->smallest_page_size = min(batch->smallest_page_size, smallest_page_size(page_sizes));
+        batch->span_start = min(batch->span_start, start);
+        batch->span_end = max(batch->span_end, start + size);
+
+        // Invalidates of adjacent PTE ranges, for example the subregions of a
+        // VA block, can be issued as a single range invalidate.
+        if (!tlb_batch_should_coalesce(batch) && tlb_batch_try_merge(batch, start, size, page_sizes))
+            return;
+    }
+
     ++batch->count;
 
     batch->total_ranges++;
 
-    batch->biggest_page_size = max(batch->biggest_page_size, biggest_page_size(page_sizes));
-
-    if (tlb_batch_should_invalidate_all(batch))
+    if (tlb_batch_should_coalesce(batch))
         return;
 
     new_entry = &batch->ranges[batch->count - 1];
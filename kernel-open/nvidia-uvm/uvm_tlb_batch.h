@@ -35,6 +35,14 @@
 //       implemented, verify whether it makes sense.
 #define UVM_TLB_BATCH_MAX_ENTRIES 4
 
+// Max number of pages, in units of the smallest page size in the batch, that a
+// single targeted invalidate covering all the queued up ranges can span when
+// the ranges don't fit in the batch. Bigger spans fall back to invalidate all.
+// A covering invalidate only drops the TLB entries in the span, while
+// invalidate all drops the entries of the whole VA space, which all need to be
+// refilled afterwards.
+#define UVM_TLB_BATCH_MAX_SPAN_PAGES (1 << 16)
+
 typedef struct
 {
     NvU64 start;
@@ -52,13 +60,21 @@ struct uvm_tlb_batch_struct
     // Each range can be invalidated using a single Host method on supported GPUs
     NvU32 total_ranges;
 
-    // Queued up ranges to invalidate
+    // Queued up ranges to invalidate. Ranges which overlap or are adjacent to
+    // a queued up range are merged into it.
     uvm_tlb_batch_range_t ranges[UVM_TLB_BATCH_MAX_ENTRIES];
     NvU32 count;
 
     // Biggest page size across all queued up invalidates
     NvU64 biggest_page_size;
 
+    // Smallest page size across all queued up invalidates
+    NvU64 smallest_page_size;
+
+    // [span_start, span_end) covers all the queued up invalidates
+    NvU64 span_start;
+    NvU64 span_end;
+
     // Max membar across all queued up invalidates
     uvm_membar_t membar;
 };
@@ -80,7 +96,10 @@ void uvm_tlb_batch_invalidate(uvm_tlb_batch_t *batch, NvU64 start, NvU64 size, N
 // End a TLB invalidate batch
 //
 // This will push the required TLB invalidate to invalidate all the queued up
-// ranges.
+// ranges. If they don't fit in a per-range invalidate each, they are coalesced
+// into a single targeted invalidate covering all of them, or into an
+// invalidate all if the covering invalidate would span more than
+// UVM_TLB_BATCH_MAX_SPAN_PAGES pages.
 //
 // The tlb_membar argument has the same behavior as in uvm_tlb_batch_invalidate.
 // This allows callers which use the same membar for all calls to
@@ -43,6 +43,19 @@
 // over and over again in an attempt to overflow the refcount.
 #define MAX_PAGE_COUNT (1 << 20)
 
+#define UVM_TOOLS_EVENT_RING_SIZE_MAX 1024
+
+// Number of entries of the per-CPU event rings of tools event queues. When
+// non-zero, event producers don't take the queue lock. Instead, each CPU
+// appends timestamped events to its own single-producer ring, and a consumer
+// merges the rings in timestamp order into the user-visible queue, which
+// keeps its format and synchronization protocol. 0 (the default) makes
+// producers write to the user-visible queue directly.
+static unsigned uvm_tools_event_ring_size = 0;
+module_param(uvm_tools_event_ring_size, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_tools_event_ring_size,
+                 "Number of entries of the per-CPU tools event rings. 0 disables them.");
+
 typedef struct
 {
     NvU32 get_ahead;
@@ -51,12 +64,44 @@ typedef struct
     NvU32 put_behind;
 } uvm_tools_queue_snapshot_t;
 
+// Header of each entry in a per-CPU event ring. The event entry itself follows
+// the header.
+typedef struct
+{
+    NvU64 timestamp;
+    NvU8 event_type;
+} uvm_tools_ring_slot_t;
+
+// Single-producer, single-consumer ring of events recorded on a CPU
+typedef struct
+{
+    // Written only by the owning CPU, with preemption disabled
+    NvU32 put;
+
+    // Written only by the consumer, with the queue lock held
+    NvU32 get ____cacheline_aligned_in_smp;
+
+    void *slots;
+} ____cacheline_aligned_in_smp uvm_tools_cpu_ring_t;
+
 typedef struct
 {
     uvm_spinlock_t lock;
     NvU64 subscribed_queues;
     struct list_head queue_nodes[UvmEventNumTypesAll];
 
+    // Per-CPU event rings indexed by CPU id, or NULL if the rings are
+    // disabled. See uvm_tools_event_ring_size.
+    uvm_tools_cpu_ring_t *cpu_rings;
+    void *cpu_ring_slots;
+    NvU32 cpu_ring_size;
+    size_t cpu_ring_slot_size;
+    size_t entry_size;
+
+    // Set while a merge of the per-CPU rings is scheduled but hasn't started
+    atomic_t drain_pending;
+    nv_kthread_q_item_t drain_q_item;
+
     struct page **queue_buffer_pages;
     void *queue_buffer;
     NvU32 queue_buffer_count;
@@ -393,27 +438,12 @@ static void destroy_event_tracker(uvm_tools_event_tracker_t *event_tracker)
 
         if (event_tracker->is_queue) {
             uvm_tools_queue_t *queue = &event_tracker->queue;
-            NvU64 buffer_size;
-
-            buffer_size = queue->queue_buffer_count * event_tracker->entry_size;
 
             remove_event_tracker(va_space,
                                  queue->queue_nodes,
                                  UvmEventNumTypesAll,
                                  queue->subscribed_queues,
                                  &queue->subscribed_queues);
-
-            if (queue->queue_buffer != NULL) {
-                unmap_user_pages(queue->queue_buffer_pages,
-                                 queue->queue_buffer,
-                                 buffer_size);
-            }
-
-            if (queue->control != NULL) {
-                unmap_user_pages(queue->control_buffer_pages,
-                                 queue->control,
-                                 sizeof(UvmToolsEventControlData));
-            }
         }
         else {
             uvm_tools_counter_t *counters = &event_tracker->counter;
@@ -439,28 +469,49 @@ static void destroy_event_tracker(uvm_tools_event_tracker_t *event_tracker)
         uvm_up_write(&va_space->perf_events.lock);
         uvm_up_write(&g_tools_va_space_list_lock);
 
+        if (event_tracker->is_queue) {
+            uvm_tools_queue_t *queue = &event_tracker->queue;
+            NvU64 buffer_size;
+
+            buffer_size = queue->queue_buffer_count * event_tracker->entry_size;
+
+            // The queue is no longer reachable by producers, but a merge of its
+            // per-CPU rings may still be pending. The queue lock can't be held
+            // while flushing, since the other tools work items take the VA
+            // space tools lock.
+            if (queue->cpu_rings) {
+                nv_kthread_q_flush(&g_tools_queue);
+                uvm_kvfree(queue->cpu_ring_slots);
+                uvm_kvfree(queue->cpu_rings);
+            }
+
+            if (queue->queue_buffer != NULL) {
+                unmap_user_pages(queue->queue_buffer_pages,
+                                 queue->queue_buffer,
+                                 buffer_size);
+            }
+
+            if (queue->control != NULL) {
+                unmap_user_pages(queue->control_buffer_pages,
+                                 queue->control,
+                                 sizeof(UvmToolsEventControlData));
+            }
+        }
+
         fput(event_tracker->uvm_file);
     }
 
     kmem_cache_free(g_tools_event_tracker_cache, event_tracker);
 }
 
-static void enqueue_event(const void *entry, size_t entry_size, NvU8 eventType, uvm_tools_queue_t *queue)
+static void enqueue_event_locked(const void *entry, size_t entry_size, NvU8 eventType, uvm_tools_queue_t *queue)
 {
     UvmToolsEventControlData *ctrl = queue->control;
     uvm_tools_queue_snapshot_t sn;
     NvU32 queue_size = queue->queue_buffer_count;
     NvU32 queue_mask = queue_size - 1;
 
-    // Prevent processor speculation prior to accessing user-mapped memory to
-    // avoid leaking information from side-channel attacks. There are many
-    // possible paths leading to this point and it would be difficult and error-
-    // prone to audit all of them to determine whether user mode could guide
-    // this access to kernel memory under speculative execution, so to be on the
-    // safe side we'll just always block speculation.
-    nv_speculation_barrier();
-
-    uvm_spin_lock(&queue->lock);
+    uvm_assert_spinlock_locked(&queue->lock);
 
     // ctrl is mapped into user space with read and write permissions,
     // so its values cannot be trusted.
@@ -471,7 +522,7 @@ static void enqueue_event(const void *entry, size_t entry_size, NvU8 eventType,
     // one free element means that the queue is full
     if (((queue_size + sn.get_behind - sn.put_behind) & queue_mask) == 1) {
         atomic64_inc((atomic64_t *)&ctrl->dropped + eventType);
-        goto unlock;
+        return;
     }
 
     memcpy((char *)queue->queue_buffer + sn.put_behind * entry_size, entry, entry_size);
@@ -493,8 +544,121 @@ static void enqueue_event(const void *entry, size_t entry_size, NvU8 eventType,
         queue->wakeup_get = sn.get_ahead;
         wake_up_all(&queue->wait_queue);
     }
+}
+
+static uvm_tools_ring_slot_t *cpu_ring_slot(uvm_tools_queue_t *queue, uvm_tools_cpu_ring_t *ring, NvU32 index)
+{
+    size_t offset = (index & (queue->cpu_ring_size - 1)) * queue->cpu_ring_slot_size;
+
+    return (uvm_tools_ring_slot_t *)((char *)ring->slots + offset);
+}
+
+// Move all the events in the per-CPU rings of the queue to the user-visible
+// queue. Events are merged in timestamp order across rings, and each ring is
+// already in timestamp order.
+static void cpu_rings_drain_locked(uvm_tools_queue_t *queue)
+{
+    uvm_assert_spinlock_locked(&queue->lock);
+
+    while (true) {
+        uvm_tools_cpu_ring_t *oldest_ring = NULL;
+        uvm_tools_ring_slot_t *oldest_slot = NULL;
+        int cpu;
+
+        for_each_possible_cpu(cpu) {
+            uvm_tools_cpu_ring_t *ring = &queue->cpu_rings[cpu];
+            uvm_tools_ring_slot_t *slot;
+
+            // Pairs with smp_store_release() in cpu_ring_enqueue_event()
+            if (ring->get == smp_load_acquire(&ring->put))
+                continue;
+
+            slot = cpu_ring_slot(queue, ring, ring->get);
+            if (!oldest_slot || slot->timestamp < oldest_slot->timestamp) {
+                oldest_ring = ring;
+                oldest_slot = slot;
+            }
+        }
+
+        if (!oldest_ring)
+            break;
+
+        enqueue_event_locked(oldest_slot + 1, queue->entry_size, oldest_slot->event_type, queue);
+
+        // Pairs with smp_load_acquire() in cpu_ring_enqueue_event()
+        smp_store_release(&oldest_ring->get, oldest_ring->get + 1);
+    }
+}
+
+static void cpu_rings_drain(uvm_tools_queue_t *queue)
+{
+    atomic_set(&queue->drain_pending, 0);
+
+    // Pairs with smp_mb() in cpu_ring_enqueue_event(). Either this drain sees
+    // the events published before the producer checked drain_pending, or the
+    // producer sees drain_pending cleared and schedules a new drain.
+    smp_mb__after_atomic();
+
+    uvm_spin_lock(&queue->lock);
+    cpu_rings_drain_locked(queue);
+    uvm_spin_unlock(&queue->lock);
+}
+
+static void cpu_rings_drain_entry(void *args)
+{
+    UVM_ENTRY_VOID(cpu_rings_drain(args));
+}
+
+static void cpu_ring_enqueue_event(const void *entry, size_t entry_size, NvU8 eventType, uvm_tools_queue_t *queue)
+{
+    uvm_tools_cpu_ring_t *ring;
+    uvm_tools_ring_slot_t *slot;
+    NvU32 put;
+
+    UVM_ASSERT(entry_size == queue->entry_size);
+
+    // Disabling preemption makes the current thread the only producer of the
+    // ring of this CPU. Events are never recorded from interrupt context.
+    ring = &queue->cpu_rings[get_cpu()];
+
+    put = ring->put;
+    if (put - smp_load_acquire(&ring->get) == queue->cpu_ring_size) {
+        put_cpu();
+        atomic64_inc((atomic64_t *)&queue->control->dropped + eventType);
+        return;
+    }
+
+    slot = cpu_ring_slot(queue, ring, put);
+    slot->timestamp = NV_GETTIME();
+    slot->event_type = eventType;
+    memcpy(slot + 1, entry, entry_size);
+
+    smp_store_release(&ring->put, put + 1);
+
+    put_cpu();
+
+    smp_mb();
+    if (!atomic_read(&queue->drain_pending) && !atomic_xchg(&queue->drain_pending, 1))
+        nv_kthread_q_schedule_q_item(&g_tools_queue, &queue->drain_q_item);
+}
+
+static void enqueue_event(const void *entry, size_t entry_size, NvU8 eventType, uvm_tools_queue_t *queue)
+{
+    // Prevent processor speculation prior to accessing user-mapped memory to
+    // avoid leaking information from side-channel attacks. There are many
+    // possible paths leading to this point and it would be difficult and error-
+    // prone to audit all of them to determine whether user mode could guide
+    // this access to kernel memory under speculative execution, so to be on the
+    // safe side we'll just always block speculation.
+    nv_speculation_barrier();
+
+    if (queue->cpu_rings) {
+        cpu_ring_enqueue_event(entry, entry_size, eventType, queue);
+        return;
+    }
 
-unlock:
+    uvm_spin_lock(&queue->lock);
+    enqueue_event_locked(entry, entry_size, eventType, queue);
     uvm_spin_unlock(&queue->lock);
 }
 
@@ -705,6 +869,9 @@ static unsigned uvm_tools_poll(struct file *filp, poll_table *wait)
 
     uvm_spin_lock(&event_tracker->queue.lock);
 
+    if (event_tracker->queue.cpu_rings)
+        cpu_rings_drain_locked(&event_tracker->queue);
+
     event_tracker->queue.is_wakeup_get_valid = false;
     ctrl = event_tracker->queue.control;
     sn.get_ahead = atomic_read((atomic_t *)&ctrl->get_ahead);
@@ -2020,6 +2187,38 @@ done:
     uvm_up_read(&va_space->tools.lock);
 }
 
+static NV_STATUS init_cpu_rings(uvm_tools_queue_t *queue, size_t entry_size)
+{
+    int cpu;
+
+    if (uvm_tools_event_ring_size == 0)
+        return NV_OK;
+
+    queue->entry_size = entry_size;
+    queue->cpu_ring_size = uvm_tools_event_ring_size;
+    queue->cpu_ring_slot_size = UVM_ALIGN_UP(sizeof(uvm_tools_ring_slot_t) + entry_size, sizeof(NvU64));
+    atomic_set(&queue->drain_pending, 0);
+    nv_kthread_q_item_init(&queue->drain_q_item, cpu_rings_drain_entry, queue);
+
+    queue->cpu_rings = uvm_kvmalloc_zero(sizeof(*queue->cpu_rings) * nr_cpu_ids);
+    if (!queue->cpu_rings)
+        return NV_ERR_NO_MEMORY;
+
+    queue->cpu_ring_slots = uvm_kvmalloc(queue->cpu_ring_slot_size * queue->cpu_ring_size * nr_cpu_ids);
+    if (!queue->cpu_ring_slots) {
+        uvm_kvfree(queue->cpu_rings);
+        queue->cpu_rings = NULL;
+        return NV_ERR_NO_MEMORY;
+    }
+
+    for_each_possible_cpu(cpu) {
+        queue->cpu_rings[cpu].slots = (char *)queue->cpu_ring_slots +
+                                      (size_t)cpu * queue->cpu_ring_slot_size * queue->cpu_ring_size;
+    }
+
+    return NV_OK;
+}
+
 static NV_STATUS create_event_tracker(UVM_TOOLS_INIT_EVENT_TRACKER_V2_PARAMS *params,
                                       size_t entry_size,
                                       struct file *filp)
@@ -2093,6 +2292,10 @@ static NV_STATUS create_event_tracker(UVM_TOOLS_INIT_EVENT_TRACKER_V2_PARAMS *pa
 
         if (status != NV_OK)
             goto fail;
+
+        status = init_cpu_rings(queue, entry_size);
+        if (status != NV_OK)
+            goto fail;
     }
     else {
         uvm_tools_counter_t *counter = &event_tracker->counter;
@@ -2825,6 +3028,18 @@ int uvm_tools_init(dev_t uvm_base_dev)
 
     uvm_spin_lock_init(&g_tools_channel_list_lock, UVM_LOCK_ORDER_LEAF);
 
+    if (uvm_tools_event_ring_size != 0) {
+        unsigned ring_size = min(roundup_pow_of_two(uvm_tools_event_ring_size),
+                                 (unsigned long)UVM_TOOLS_EVENT_RING_SIZE_MAX);
+
+        if (ring_size != uvm_tools_event_ring_size) {
+            UVM_INFO_PRINT("Invalid value %u for uvm_tools_event_ring_size, using %u instead\n",
+                           uvm_tools_event_ring_size,
+                           ring_size);
+            uvm_tools_event_ring_size = ring_size;
+        }
+    }
+
     ret = nv_kthread_q_init(&g_tools_queue, "UVM Tools Event Queue");
     if (ret < 0)
         goto err_cache_destroy;
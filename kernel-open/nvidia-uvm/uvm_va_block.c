@@ -54,6 +54,16 @@ typedef enum
 
 static NvU64 uvm_perf_authorized_cpu_fault_tracking_window_ns = 300000;
 
+// Service CPU faults on 2M blocks that are not mapped by any processor, and
+// that are either not populated yet or fully resident on the CPU, for the
+// whole block at once: the block is populated with a single 2M chunk when
+// possible and all its pages are mapped by the first fault, instead of taking
+// one fault per page.
+static unsigned uvm_perf_cpu_fault_whole_block __read_mostly = 1;
+module_param(uvm_perf_cpu_fault_whole_block, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_perf_cpu_fault_whole_block,
+                 "Service CPU faults on unmapped 2M blocks for the whole block. Default: 1.");
+
 static struct kmem_cache *g_uvm_va_block_cache __read_mostly;
 static struct kmem_cache *g_uvm_va_block_gpu_state_cache __read_mostly;
 static struct kmem_cache *g_uvm_page_mask_cache __read_mostly;
@@ -88,6 +98,21 @@ MODULE_PARM_DESC(uvm_exp_gpu_cache_sysmem,
                  "Force caching for mappings to system memory. "
                  "This is an experimental parameter that may cause correctness issues if used.");
 
+// Large physically-contiguous copies pushed by the migration code are split in
+// stripes of this size (in bytes), each pushed on a different channel. The
+// stripes are spread across the channels of all the CEs that can process the
+// copy, which raises the bandwidth of single-block migrations on links that a
+// single CE cannot saturate. 0 disables striping.
+#define UVM_BLOCK_COPY_STRIPE_SIZE_MIN (64 * 1024)
+static unsigned uvm_perf_block_copy_stripe_size __read_mostly = 0;
+module_param(uvm_perf_block_copy_stripe_size, uint, S_IRUGO);
+MODULE_PARM_DESC(uvm_perf_block_copy_stripe_size,
+                 "Size in bytes of the stripes in which large block copies are split across channels. "
+                 "Default: 0 (disabled).");
+
+// Post-processed value of uvm_perf_block_copy_stripe_size, in pages
+static NvU32 g_uvm_block_copy_stripe_pages __read_mostly;
+
 static void block_add_eviction_mappings_entry(void *args);
 static void block_unmap_cpu(uvm_va_block_t *block,
                             uvm_va_block_context_t *block_context,
@@ -911,6 +936,17 @@ NV_STATUS uvm_va_block_init(void)
     if (!g_uvm_va_block_cpu_node_state_cache)
         return NV_ERR_NO_MEMORY;
 
+    if (uvm_perf_block_copy_stripe_size != 0 &&
+        (uvm_perf_block_copy_stripe_size < UVM_BLOCK_COPY_STRIPE_SIZE_MIN ||
+         !IS_ALIGNED(uvm_perf_block_copy_stripe_size, PAGE_SIZE))) {
+        UVM_INFO_PRINT("Invalid value %u for uvm_perf_block_copy_stripe_size. Using %u instead\n",
+                       uvm_perf_block_copy_stripe_size,
+                       UVM_BLOCK_COPY_STRIPE_SIZE_MIN);
+        uvm_perf_block_copy_stripe_size = UVM_BLOCK_COPY_STRIPE_SIZE_MIN;
+    }
+
+    g_uvm_block_copy_stripe_pages = uvm_perf_block_copy_stripe_size / PAGE_SIZE;
+
     return NV_OK;
 }
 
@@ -994,6 +1030,7 @@ void uvm_va_block_context_init(uvm_va_block_context_t *va_block_context, struct
 
     va_block_context->mm = mm;
     va_block_context->make_resident.dest_nid = NUMA_NO_NODE;
+    va_block_context->make_resident.copy_channel_hint = 0;
     nodes_clear(va_block_context->make_resident.cpu_pages_used.nodes);
 }
 
@@ -1806,10 +1843,15 @@ out:
 // Also maps the page for physical access by all GPUs used by the block, which
 // is required for IOMMU support. Skipped on GPUs without access to CPU memory.
 // e.g., this happens when the Confidential Computing Feature is enabled.
+//
+// fallback_nid is the NUMA node preferred, but not required, for the
+// allocations when neither the migration nor the policy select a node. It can
+// be NUMA_NO_NODE.
 static NV_STATUS block_populate_pages_cpu(uvm_va_block_t *block,
                                           const uvm_page_mask_t *populate_page_mask,
                                           uvm_va_block_region_t populate_region,
-                                          uvm_va_block_context_t *block_context)
+                                          uvm_va_block_context_t *block_context,
+                                          int fallback_nid)
 {
     NV_STATUS status = NV_OK;
     uvm_cpu_chunk_t *chunk;
@@ -1904,7 +1946,19 @@ static NV_STATUS block_populate_pages_cpu(uvm_va_block_t *block,
         if (!uvm_page_mask_region_full(resident_mask, region))
             chunk_alloc_flags |= UVM_CPU_CHUNK_ALLOC_FLAGS_ZERO;
 
-        status = block_alloc_cpu_chunk(block, allocation_sizes, chunk_alloc_flags, preferred_nid, &chunk);
+        // If the whole 2M block is being populated, try harder to get a
+        // physically contiguous chunk for it so that the block can be mapped
+        // and copied with large pages.
+        if (uvm_va_block_region_size(region) == UVM_PAGE_SIZE_2M &&
+            uvm_va_block_region_contains_region(populate_region, region) &&
+            (!populate_page_mask || uvm_page_mask_region_full(populate_page_mask, region)))
+            chunk_alloc_flags |= UVM_CPU_CHUNK_ALLOC_FLAGS_COMPACT;
+
+        status = block_alloc_cpu_chunk(block,
+                                       allocation_sizes,
+                                       chunk_alloc_flags,
+                                       preferred_nid != NUMA_NO_NODE ? preferred_nid : fallback_nid,
+                                       &chunk);
 
         if (status == NV_WARN_MORE_PROCESSING_REQUIRED) {
             alloc_flags &= ~UVM_CPU_CHUNK_ALLOC_FLAGS_STRICT;
@@ -1931,7 +1985,11 @@ static NV_STATUS block_populate_pages_cpu(uvm_va_block_t *block,
 
 NV_STATUS uvm_va_block_populate_page_cpu(uvm_va_block_t *va_block, uvm_page_index_t page_index, uvm_va_block_context_t *block_context)
 {
-    return block_populate_pages_cpu(va_block, NULL, uvm_va_block_region_for_page(page_index), block_context);
+    return block_populate_pages_cpu(va_block,
+                                    NULL,
+                                    uvm_va_block_region_for_page(page_index),
+                                    block_context,
+                                    NUMA_NO_NODE);
 }
 
 // Try allocating a chunk. If eviction was required,
@@ -2994,6 +3052,7 @@ static NV_STATUS block_populate_pages(uvm_va_block_t *block,
     uvm_page_mask_t *pages_staged = &block_context->make_resident.pages_staged;
     uvm_page_mask_t *cpu_populate_mask;
     uvm_memcg_context_t memcg_context;
+    int fallback_nid = NUMA_NO_NODE;
 
     if (!resident_mask)
         return NV_ERR_NO_MEMORY;
@@ -3055,6 +3114,12 @@ static NV_STATUS block_populate_pages(uvm_va_block_t *block,
 
         cpu_populate_mask = pages_staged;
 
+        // The destination is a GPU, so neither the migration nor the policy
+        // selects a NUMA node for these staging pages and any node would do.
+        // Prefer the node closest to the destination GPU, which performs the
+        // copies out of the staging pages.
+        fallback_nid = uvm_gpu_get(dest_id)->parent->closest_cpu_numa_node;
+
         uvm_processor_mask_cache_free(tmp_processor_mask);
     }
     else {
@@ -3062,7 +3127,7 @@ static NV_STATUS block_populate_pages(uvm_va_block_t *block,
     }
 
     uvm_memcg_context_start(&memcg_context, block_context->mm);
-    status = block_populate_pages_cpu(block, cpu_populate_mask, region, block_context);
+    status = block_populate_pages_cpu(block, cpu_populate_mask, region, block_context, fallback_nid);
     uvm_memcg_context_end(&memcg_context);
     return status;
 }
@@ -3225,12 +3290,15 @@ static uvm_gpu_address_t block_phys_page_copy_address(uvm_va_block_t *block,
 // Issue a GPU TLB physical invalidate if required by the architecture and there
 // are un-flushed mappings in the block. Since this operation clears the pending
 // flag in the block, the caller must either add this push to the block tracker
-// or wait for the push.
-static void block_tlb_invalidate_phys(uvm_va_block_t *block, uvm_push_t *push)
+// or wait for the push. Returns true if the invalidate was issued.
+static bool block_tlb_invalidate_phys(uvm_va_block_t *block, uvm_push_t *push)
 {
     uvm_parent_gpu_t *parent = uvm_push_get_gpu(push)->parent;
-    if (uvm_parent_processor_mask_test_and_clear(&block->needs_phys_invalidate, parent->id))
-        uvm_hal_tlb_invalidate_phys(push, parent->ats.dma_map_invalidation);
+    if (!uvm_parent_processor_mask_test_and_clear(&block->needs_phys_invalidate, parent->id))
+        return false;
+
+    uvm_hal_tlb_invalidate_phys(push, parent->ats.dma_map_invalidation);
+    return true;
 }
 
 typedef struct
@@ -3259,6 +3327,23 @@ typedef struct
     // True if at least one CE transfer (such as a memcopy) has already been
     // pushed to the GPU during the VA block copy thus far.
     bool copy_pushed;
+
+    // Channel hint for the copy pushes, copied from
+    // va_block_context->make_resident.copy_channel_hint.
+    NvU32 channel_hint;
+
+    // Type of the channel used by the copy push
+    uvm_channel_type_t channel_type;
+
+    // Pages whose copy has been deferred to block_copy_end_push(), which
+    // splits them in stripes pushed on channels other than the one used by
+    // the copy push. See uvm_perf_block_copy_stripe_size.
+    uvm_page_mask_t stripe_pages;
+
+    // True if the copy push issued a physical TLB invalidate. The stripe
+    // pushes are not ordered after the copy push, so they need to issue their
+    // own invalidate before using the DMA mappings.
+    bool stripes_need_phys_invalidate;
 } block_copy_state_t;
 
 // Begin a push appropriate for copying data from src_id processor to dst_id
@@ -3317,16 +3402,19 @@ static NV_STATUS block_copy_begin_push(uvm_va_block_t *va_block, block_copy_stat
                    uvm_processor_get_name(dst_id),
                    uvm_processor_get_name(src_id));
 
+    copy_state->channel_type = channel_type;
+
     if (channel_type == UVM_CHANNEL_TYPE_GPU_TO_GPU) {
-        status = uvm_push_begin_acquire_gpu_to_gpu(gpu->channel_manager,
-                                                   uvm_gpu_get(dst_id),
-                                                   tracker_ptr,
-                                                   push,
-                                                   "Copy from %s to %s for block [0x%llx, 0x%llx]",
-                                                   uvm_processor_get_name(src_id),
-                                                   uvm_processor_get_name(dst_id),
-                                                   va_block->start,
-                                                   va_block->end);
+        status = uvm_push_begin_acquire_gpu_to_gpu_with_hint(gpu->channel_manager,
+                                                             uvm_gpu_get(dst_id),
+                                                             copy_state->channel_hint,
+                                                             tracker_ptr,
+                                                             push,
+                                                             "Copy from %s to %s for block [0x%llx, 0x%llx]",
+                                                             uvm_processor_get_name(src_id),
+                                                             uvm_processor_get_name(dst_id),
+                                                             va_block->start,
+                                                             va_block->end);
     }
     else {
         if (g_uvm_global.conf_computing_enabled) {
@@ -3359,15 +3447,16 @@ static NV_STATUS block_copy_begin_push(uvm_va_block_t *va_block, block_copy_stat
             tracker_ptr = &local_tracker;
         }
 
-        status = uvm_push_begin_acquire(gpu->channel_manager,
-                                        channel_type,
-                                        tracker_ptr,
-                                        push,
-                                        "Copy from %s to %s for block [0x%llx, 0x%llx]",
-                                        uvm_processor_get_name(src_id),
-                                        uvm_processor_get_name(dst_id),
-                                        va_block->start,
-                                        va_block->end);
+        status = uvm_push_begin_acquire_with_hint(gpu->channel_manager,
+                                                  channel_type,
+                                                  copy_state->channel_hint,
+                                                  tracker_ptr,
+                                                  push,
+                                                  "Copy from %s to %s for block [0x%llx, 0x%llx]",
+                                                  uvm_processor_get_name(src_id),
+                                                  uvm_processor_get_name(dst_id),
+                                                  va_block->start,
+                                                  va_block->end);
     }
 
     // We only really need to issue this invalidate when the copy uses DMA
@@ -3376,7 +3465,7 @@ static NV_STATUS block_copy_begin_push(uvm_va_block_t *va_block, block_copy_stat
     // In any case, the invalidate is only issued if there have been un-flushed
     // DMA mappings created since the last time we checked.
     if (status == NV_OK)
-        block_tlb_invalidate_phys(va_block, push);
+        copy_state->stripes_need_phys_invalidate = block_tlb_invalidate_phys(va_block, push);
 
 out:
     // Caller is responsible for freeing the DMA buffer on error
@@ -3402,6 +3491,45 @@ static void block_mark_memory_used(uvm_va_block_t *block, uvm_processor_id_t id)
     }
 }
 
+// Refresh the eviction recency of the root chunks backing the given region on
+// the GPU. HMM blocks are skipped as in block_mark_memory_used().
+static void block_mark_gpu_chunks_accessed(uvm_va_block_t *block, uvm_processor_id_t id, uvm_va_block_region_t region)
+{
+    uvm_va_block_gpu_state_t *gpu_state;
+    uvm_gpu_chunk_t *prev_chunk = NULL;
+    uvm_page_index_t page_index;
+    uvm_gpu_t *gpu;
+
+    if (UVM_ID_IS_CPU(id) || uvm_va_block_is_hmm(block))
+        return;
+
+    gpu_state = uvm_va_block_gpu_state_get(block, id);
+    if (!gpu_state || !gpu_state->chunks)
+        return;
+
+    gpu = uvm_gpu_get(id);
+
+    page_index = region.first;
+    while (page_index < region.outer) {
+        uvm_chunk_size_t chunk_size;
+        size_t chunk_index = block_gpu_chunk_index(block, gpu, page_index, &chunk_size);
+        uvm_gpu_chunk_t *chunk = gpu_state->chunks[chunk_index];
+        NvU64 chunk_end;
+
+        // Consecutive chunks usually share the root chunk
+        if (chunk && (!prev_chunk || !uvm_gpu_chunk_same_root(chunk, prev_chunk))) {
+            uvm_pmm_gpu_mark_root_chunk_accessed(&gpu->pmm, chunk);
+            prev_chunk = chunk;
+        }
+
+        chunk_end = UVM_ALIGN_DOWN(uvm_va_block_cpu_page_address(block, page_index), chunk_size) + chunk_size;
+        if (chunk_end > block->end)
+            break;
+
+        page_index = uvm_va_block_cpu_page_index(block, chunk_end);
+    }
+}
+
 static void block_set_resident_processor(uvm_va_block_t *block, uvm_processor_id_t id)
 {
     UVM_ASSERT(!uvm_page_mask_empty(uvm_va_block_resident_mask_get(block, id, NUMA_NO_NODE)));
@@ -3725,6 +3853,16 @@ static void block_copy_push(uvm_va_block_t *block,
             conf_computing_block_copy_push_gpu_to_cpu(block, copy_state, region, push);
     }
     else {
+        // Large copies only push their first stripe here, the rest of the
+        // region is pushed on other channels by block_copy_end_push().
+        if (g_uvm_block_copy_stripe_pages != 0 &&
+            !g_uvm_global.conf_computing_enabled &&
+            uvm_va_block_region_num_pages(region) > g_uvm_block_copy_stripe_pages) {
+            uvm_page_mask_region_fill(&copy_state->stripe_pages,
+                                      uvm_va_block_region(region.first + g_uvm_block_copy_stripe_pages, region.outer));
+            region.outer = region.first + g_uvm_block_copy_stripe_pages;
+        }
+
         gpu_dst_address = block_copy_get_address(block, &copy_state->dst, region.first, gpu);
         gpu_src_address = block_copy_get_address(block, &copy_state->src, region.first, gpu);
 
@@ -3734,6 +3872,124 @@ static void block_copy_push(uvm_va_block_t *block,
     copy_state->copy_pushed = true;
 }
 
+// Returns the part of region copied by the copy push, that is, without the
+// pages deferred to the stripe pushes by block_copy_push().
+static uvm_va_block_region_t block_copy_push_region(block_copy_state_t *copy_state, uvm_va_block_region_t region)
+{
+    if (!uvm_page_mask_region_empty(&copy_state->stripe_pages, region))
+        region.outer = min(region.outer, (uvm_page_index_t)(region.first + g_uvm_block_copy_stripe_pages));
+
+    return region;
+}
+
+// Push the copies deferred by block_copy_push() to copy_state->stripe_pages,
+// one push per stripe, on the channels returned by
+// uvm_channel_manager_stripe_channel(). The stripe pushes only depend on the
+// block tracker, so they execute concurrently with the main copy push and with
+// each other. Each stripe push reports its own migration events.
+//
+// prefetch_page_mask is NULL if the pages cannot have been prefetched.
+static NV_STATUS block_copy_push_stripes(uvm_va_block_t *block,
+                                         uvm_va_block_context_t *block_context,
+                                         block_copy_state_t *copy_state,
+                                         uvm_gpu_t *gpu,
+                                         const uvm_page_mask_t *prefetch_page_mask,
+                                         uvm_va_block_transfer_mode_t transfer_mode,
+                                         uvm_tracker_t *copy_tracker)
+{
+    uvm_va_block_region_t subregion;
+    uvm_va_block_region_t block_region = uvm_va_block_region_from_block(block);
+    uvm_va_space_t *va_space = uvm_va_block_get_va_space(block);
+    uvm_make_resident_cause_t cause = block_context->make_resident.cause;
+    uvm_gpu_t *dst_gpu = NULL;
+    NvU32 stripe_index = 0;
+
+    if (copy_state->channel_type == UVM_CHANNEL_TYPE_GPU_TO_GPU)
+        dst_gpu = uvm_gpu_get(copy_state->dst.id);
+
+    for_each_va_block_subregion_in_mask(subregion, &copy_state->stripe_pages, block_region) {
+        NvU32 first;
+
+        for (first = subregion.first; first < subregion.outer; first += g_uvm_block_copy_stripe_pages) {
+            uvm_va_block_region_t stripe = uvm_va_block_region(first,
+                                                               min(first + g_uvm_block_copy_stripe_pages,
+                                                                   (NvU32)subregion.outer));
+            uvm_gpu_address_t gpu_dst_address, gpu_src_address;
+            uvm_make_resident_cause_t stripe_cause = cause;
+            uvm_channel_t *channel;
+            uvm_push_t push;
+            NV_STATUS status;
+
+            // Stripes never cross the copy regions of
+            // block_copy_resident_pages_between(), so all the pages in the
+            // stripe have the same cause.
+            if (prefetch_page_mask && uvm_page_mask_test(prefetch_page_mask, stripe.first))
+                stripe_cause = UVM_MAKE_RESIDENT_CAUSE_PREFETCH;
+
+            // Stripe 0 is the one pushed by block_copy_push()
+            channel = uvm_channel_manager_stripe_channel(gpu->channel_manager,
+                                                         copy_state->channel_type,
+                                                         dst_gpu,
+                                                         copy_state->channel_hint,
+                                                         ++stripe_index);
+
+            status = uvm_push_begin_acquire_on_channel(channel,
+                                                       &block->tracker,
+                                                       &push,
+                                                       "Copy stripe from %s to %s for block [0x%llx, 0x%llx]",
+                                                       uvm_processor_get_name(copy_state->src.id),
+                                                       uvm_processor_get_name(copy_state->dst.id),
+                                                       block->start,
+                                                       block->end);
+            if (status != NV_OK)
+                return status;
+
+            // The stripe may execute before the invalidate in the copy push,
+            // so it needs its own.
+            if (copy_state->stripes_need_phys_invalidate)
+                uvm_hal_tlb_invalidate_phys(&push, gpu->parent->ats.dma_map_invalidation);
+
+            uvm_tools_record_migration_begin(va_space,
+                                             &push,
+                                             copy_state->dst.id,
+                                             copy_state->dst.nid,
+                                             copy_state->src.id,
+                                             copy_state->src.nid,
+                                             uvm_va_block_region_start(block, stripe),
+                                             stripe_cause,
+                                             UVM_API_RANGE_TYPE_MANAGED);
+
+            gpu_dst_address = block_copy_get_address(block, &copy_state->dst, stripe.first, gpu);
+            gpu_src_address = block_copy_get_address(block, &copy_state->src, stripe.first, gpu);
+
+            // The membar is performed by the semaphore release in
+            // uvm_push_end().
+            uvm_push_set_flag(&push, UVM_PUSH_FLAG_NEXT_MEMBAR_NONE);
+            gpu->parent->ce_hal->memcopy(&push, gpu_dst_address, gpu_src_address, uvm_va_block_region_size(stripe));
+
+            uvm_perf_event_notify_migration(&va_space->perf_events,
+                                            &push,
+                                            block,
+                                            copy_state->dst.id,
+                                            copy_state->src.id,
+                                            uvm_va_block_region_start(block, stripe),
+                                            uvm_va_block_region_size(stripe),
+                                            transfer_mode,
+                                            block_context->make_resident.access_counters_buffer_index,
+                                            stripe_cause,
+                                            &block_context->make_resident);
+
+            uvm_push_end(&push);
+
+            status = uvm_tracker_add_push_safe(copy_tracker, &push);
+            if (status != NV_OK)
+                return status;
+        }
+    }
+
+    return NV_OK;
+}
+
 static NV_STATUS block_copy_end_push(uvm_va_block_t *block,
                                      block_copy_state_t *copy_state,
                                      uvm_tracker_t *copy_tracker,
@@ -3940,6 +4196,8 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
 
     *copied_pages = 0;
 
+    copy_state.channel_hint = block_context->make_resident.copy_channel_hint;
+
     if (UVM_ID_IS_CPU(src_id))
         UVM_ASSERT(src_nid != NUMA_NO_NODE);
 
@@ -4125,7 +4383,8 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
                                                 dst_id,
                                                 src_id,
                                                 uvm_va_block_region_start(block, contig_region),
-                                                uvm_va_block_region_size(contig_region),
+                                                uvm_va_block_region_size(block_copy_push_region(&copy_state,
+                                                                                                contig_region)),
                                                 transfer_mode,
                                                 block_context->make_resident.access_counters_buffer_index,
                                                 contig_cause,
@@ -4174,7 +4433,8 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
                                             dst_id,
                                             src_id,
                                             uvm_va_block_region_start(block, contig_region),
-                                            uvm_va_block_region_size(contig_region),
+                                            uvm_va_block_region_size(block_copy_push_region(&copy_state,
+                                                                                            contig_region)),
                                             transfer_mode,
                                             block_context->make_resident.access_counters_buffer_index,
                                             contig_cause,
@@ -4194,8 +4454,21 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
                                                 &block_context->make_resident);
         }
 
-        if (block_copy_should_use_push(block, &copy_state) && copying_gpu)
+        if (block_copy_should_use_push(block, &copy_state) && copying_gpu) {
             status = block_copy_end_push(block, &copy_state, copy_tracker, status, &push);
+
+            // The stripes are pushed after the copy push has ended, so that no
+            // more than one push is open at a time.
+            if (status == NV_OK && !uvm_page_mask_empty(&copy_state.stripe_pages)) {
+                status = block_copy_push_stripes(block,
+                                                 block_context,
+                                                 &copy_state,
+                                                 copying_gpu,
+                                                 may_prefetch ? prefetch_page_mask : NULL,
+                                                 transfer_mode,
+                                                 copy_tracker);
+            }
+        }
     }
 
     // Update VA block status bits
@@ -4852,6 +5125,9 @@ static void block_make_resident_clear_evicted(uvm_va_block_t *va_block,
 
     UVM_ASSERT(dst_gpu_state);
 
+    if (uvm_page_mask_intersects(&dst_gpu_state->evicted, page_mask))
+        uvm_pmm_gpu_record_refault(&uvm_gpu_get(dst_id)->pmm, dst_gpu_state->evicted_time);
+
     if (!uvm_page_mask_andnot(&dst_gpu_state->evicted, &dst_gpu_state->evicted, page_mask))
         uvm_processor_mask_clear(&va_block->evicted_gpus, dst_id);
 }
@@ -4902,6 +5178,7 @@ static void block_make_resident_update_state(uvm_va_block_t *va_block,
 
             uvm_page_mask_or(&src_gpu_state->evicted, &src_gpu_state->evicted, copy_mask);
             uvm_processor_mask_set(&va_block->evicted_gpus, src_id);
+            src_gpu_state->evicted_time = NV_GETTIME();
         }
     }
     else if (UVM_ID_IS_GPU(dst_id) && uvm_processor_mask_test(&va_block->evicted_gpus, dst_id))
@@ -4954,8 +5231,10 @@ void uvm_va_block_make_resident_finish(uvm_va_block_t *va_block,
     //
     // Skip this if we didn't do anything (the input region and/or page mask was
     // empty).
-    if (uvm_processor_mask_test(&va_block->resident, dst_id))
+    if (uvm_processor_mask_test(&va_block->resident, dst_id)) {
         block_mark_memory_used(va_block, dst_id);
+        block_mark_gpu_chunks_accessed(va_block, dst_id, region);
+    }
 
     if (UVM_ID_IS_GPU(dst_id) && uvm_page_mask_full(uvm_va_block_resident_mask_get(va_block, dst_id, NUMA_NO_NODE)))
         uvm_processor_mask_set(&va_block->ever_fully_resident, dst_id);
@@ -7872,15 +8151,22 @@ NV_STATUS uvm_va_block_unmap(uvm_va_block_t *va_block,
 // each call to vm_insert_page. Multiple faults under one VMA in separate
 // blocks can be serviced concurrently, so the VMA wrapper lock is used
 // to protect access to vma->vm_page_prot.
-static NV_STATUS uvm_cpu_insert_page(struct vm_area_struct *vma,
-                                     NvU64 addr,
-                                     struct page *page,
-                                     uvm_prot_t new_prot)
+//
+// num_pages consecutive pages are mapped starting at addr. Upon return,
+// num_mapped_out contains the number of pages that were mapped, which are the
+// first pages in the array.
+static NV_STATUS uvm_cpu_insert_pages(struct vm_area_struct *vma,
+                                      NvU64 addr,
+                                      struct page **pages,
+                                      NvU32 num_pages,
+                                      uvm_prot_t new_prot,
+                                      NvU32 *num_mapped_out)
 {
     uvm_vma_wrapper_t *vma_wrapper;
     unsigned long target_flags;
     pgprot_t target_pgprot;
-    int ret;
+    int ret = 0;
+    NvU32 i = 0;
 
     UVM_ASSERT(vma);
     UVM_ASSERT(vma->vm_private_data);
@@ -7908,8 +8194,27 @@ static NV_STATUS uvm_cpu_insert_page(struct vm_area_struct *vma,
         uvm_downgrade_write(&vma_wrapper->lock);
     }
 
-    ret = vm_insert_page(vma, addr, page);
+#if defined(NV_VM_INSERT_PAGES_PRESENT)
+    // vm_insert_pages takes the page table lock once per page table instead of
+    // once per page
+    if (num_pages > 1) {
+        unsigned long num_left = num_pages;
+
+        ret = vm_insert_pages(vma, addr, pages, &num_left);
+        i = num_pages - num_left;
+    }
+#endif
+
+    for (; ret == 0 && i < num_pages; i++) {
+        ret = vm_insert_page(vma, addr + i * PAGE_SIZE, pages[i]);
+        if (ret)
+            break;
+    }
+
     uvm_up_read(&vma_wrapper->lock);
+
+    *num_mapped_out = i;
+
     if (ret) {
         UVM_ASSERT_MSG(ret == -ENOMEM, "ret: %d\n", ret);
         return errno_to_nv_status(ret);
@@ -7918,6 +8223,16 @@ static NV_STATUS uvm_cpu_insert_page(struct vm_area_struct *vma,
     return NV_OK;
 }
 
+static NV_STATUS uvm_cpu_insert_page(struct vm_area_struct *vma,
+                                     NvU64 addr,
+                                     struct page *page,
+                                     uvm_prot_t new_prot)
+{
+    NvU32 num_mapped;
+
+    return uvm_cpu_insert_pages(vma, addr, &page, 1, new_prot, &num_mapped);
+}
+
 static uvm_prot_t compute_logical_prot(uvm_va_block_t *va_block,
                                        struct vm_area_struct *hmm_vma,
                                        uvm_page_index_t page_index)
@@ -7975,6 +8290,24 @@ static struct page *block_page_get(uvm_va_block_t *block, block_phys_page_t bloc
     return page;
 }
 
+// Add the range group ranges overlapping the region to their range group's
+// migrated list.
+static void block_cpu_mark_range_groups_migrated(uvm_va_block_t *block, uvm_va_block_region_t region)
+{
+    uvm_va_space_t *va_space = uvm_va_block_get_va_space(block);
+    uvm_range_group_range_t *rgr;
+
+    uvm_range_group_for_each_range_in(rgr,
+                                      va_space,
+                                      uvm_va_block_region_start(block, region),
+                                      uvm_va_block_region_end(block, region)) {
+        uvm_spin_lock(&rgr->range_group->migrated_ranges_lock);
+        if (list_empty(&rgr->range_group_migrated_list_node))
+            list_move_tail(&rgr->range_group_migrated_list_node, &rgr->range_group->migrated_ranges);
+        uvm_spin_unlock(&rgr->range_group->migrated_ranges_lock);
+    }
+}
+
 // Creates or upgrades a CPU mapping for the given page, updating the block's
 // mapping and pte_bits bitmaps as appropriate. Upon successful return, the page
 // will be mapped with at least new_prot permissions.
@@ -8043,17 +8376,8 @@ static NV_STATUS block_map_cpu_page_to(uvm_va_block_t *block,
     UVM_ASSERT(managed_range);
 
     if (UVM_ID_IS_CPU(resident_id)) {
-        if (UVM_ID_IS_CPU(managed_range->policy.preferred_location)) {
-            // Add the page's range group range to the range group's migrated list.
-            uvm_range_group_range_t *rgr = uvm_range_group_range_find(va_space,
-                                                                      uvm_va_block_cpu_page_address(block, page_index));
-            if (rgr != NULL) {
-                uvm_spin_lock(&rgr->range_group->migrated_ranges_lock);
-                if (list_empty(&rgr->range_group_migrated_list_node))
-                    list_move_tail(&rgr->range_group_migrated_list_node, &rgr->range_group->migrated_ranges);
-                uvm_spin_unlock(&rgr->range_group->migrated_ranges_lock);
-            }
-        }
+        if (UVM_ID_IS_CPU(managed_range->policy.preferred_location))
+            block_cpu_mark_range_groups_migrated(block, uvm_va_block_region_for_page(page_index));
 
         nid = block_get_page_node_residency(block, page_index);
         UVM_ASSERT(nid != NUMA_NO_NODE);
@@ -8089,6 +8413,81 @@ static NV_STATUS block_map_cpu_page_to(uvm_va_block_t *block,
     return uvm_cpu_insert_page(vma, addr, page, new_prot);
 }
 
+// Batched version of block_map_cpu_page_to for a region of a managed block in
+// which no page is mapped by the CPU yet. The pages are inserted with a single
+// call, and the tracker wait and VMA permission update are done once for the
+// whole region. See block_map_cpu_page_to for the caller's responsibilities.
+//
+// Upon return, num_mapped_out contains the number of pages at the start of the
+// region that were mapped.
+static NV_STATUS block_map_cpu_region_to(uvm_va_block_t *block,
+                                         uvm_va_block_context_t *block_context,
+                                         uvm_processor_id_t resident_id,
+                                         uvm_va_block_region_t region,
+                                         uvm_prot_t new_prot,
+                                         NvU32 *num_mapped_out)
+{
+    uvm_va_range_managed_t *managed_range = block->managed_range;
+    uvm_va_space_t *va_space = uvm_va_block_get_va_space(block);
+    struct page **pages = block_context->mapping.cpu_pages;
+    struct vm_area_struct *vma;
+    uvm_page_index_t page_index;
+    NV_STATUS status;
+
+    *num_mapped_out = 0;
+
+    UVM_ASSERT(managed_range);
+    UVM_ASSERT(!uvm_va_block_is_hmm(block));
+    UVM_ASSERT(new_prot != UVM_PROT_NONE);
+    UVM_ASSERT(new_prot < UVM_PROT_MAX);
+    UVM_ASSERT(uvm_processor_mask_test(&va_space->accessible_from[uvm_id_value(resident_id)], UVM_ID_CPU));
+    UVM_ASSERT(uvm_page_mask_region_empty(&block->cpu.pte_bits[UVM_PTE_BITS_CPU_READ], region));
+
+    uvm_assert_mutex_locked(&block->lock);
+
+    // For the CPU, write implies atomic
+    if (new_prot == UVM_PROT_READ_WRITE)
+        new_prot = UVM_PROT_READ_WRITE_ATOMIC;
+
+    // The permissions of managed ranges come from the VMA, so they are the
+    // same for all the pages in the block
+    if (new_prot > compute_logical_prot(block, NULL, region.first))
+        return NV_ERR_INVALID_ACCESS_TYPE;
+
+    if (UVM_ID_IS_CPU(resident_id) && UVM_ID_IS_CPU(managed_range->policy.preferred_location))
+        block_cpu_mark_range_groups_migrated(block, region);
+
+    for_each_va_block_page_in_region(page_index, region) {
+        int nid = NUMA_NO_NODE;
+
+        if (UVM_ID_IS_CPU(resident_id)) {
+            UVM_ASSERT(uvm_page_mask_test(&block->cpu.allocated, page_index));
+
+            nid = block_get_page_node_residency(block, page_index);
+            UVM_ASSERT(nid != NUMA_NO_NODE);
+        }
+
+        pages[page_index - region.first] = block_page_get(block, block_phys_page(resident_id, nid, page_index));
+    }
+
+    vma = uvm_va_range_vma(managed_range);
+    uvm_assert_mmap_lock_locked(vma->vm_mm);
+    UVM_ASSERT(!uvm_va_space_mm_enabled(va_space) || va_space->va_space_mm.mm == vma->vm_mm);
+
+    // Don't map the CPU until prior copies and GPU PTE updates finish,
+    // otherwise we might not stay coherent.
+    status = uvm_tracker_wait(&block->tracker);
+    if (status != NV_OK)
+        return status;
+
+    return uvm_cpu_insert_pages(vma,
+                                uvm_va_block_region_start(block, region),
+                                pages,
+                                uvm_va_block_region_num_pages(region),
+                                new_prot,
+                                num_mapped_out);
+}
+
 // Maps the CPU to the given pages which are resident on resident_id.
 // map_page_mask is an in/out parameter: the pages which are mapped to
 // resident_id are removed from the mask before returning.
@@ -8111,6 +8510,7 @@ static NV_STATUS block_map_cpu_to(uvm_va_block_t *block,
     const uvm_page_mask_t *resident_mask = uvm_va_block_resident_mask_get(block, resident_id, NUMA_NO_NODE);
     uvm_pte_bits_cpu_t prot_pte_bit = get_cpu_pte_bit_index(new_prot);
     uvm_pte_bits_cpu_t pte_bit;
+    uvm_va_block_region_t subregion;
 
     UVM_ASSERT(uvm_processor_mask_test(&va_space->accessible_from[uvm_id_value(resident_id)], UVM_ID_CPU));
 
@@ -8132,16 +8532,39 @@ static NV_STATUS block_map_cpu_to(uvm_va_block_t *block,
 
     block->cpu.ever_mapped = true;
 
-    for_each_va_block_page_in_region_mask(page_index, pages_to_map, region) {
-        status = block_map_cpu_page_to(block,
-                                       block_context->hmm.vma,
-                                       resident_id,
-                                       page_index,
-                                       new_prot);
+    for_each_va_block_subregion_in_mask(subregion, pages_to_map, region) {
+        // Runs of pages of managed blocks that are not mapped yet, like the
+        // whole block on the first CPU fault, are inserted in a single batch
+        if (!uvm_va_block_is_hmm(block) &&
+            uvm_va_block_region_num_pages(subregion) > 1 &&
+            uvm_page_mask_region_empty(&block->cpu.pte_bits[UVM_PTE_BITS_CPU_READ], subregion)) {
+            NvU32 num_mapped;
+
+            status = block_map_cpu_region_to(block, block_context, resident_id, subregion, new_prot, &num_mapped);
+            if (num_mapped > 0)
+                uvm_processor_mask_set(&block->mapped, UVM_ID_CPU);
+
+            page_index = subregion.first + num_mapped;
+            if (status != NV_OK)
+                break;
+
+            continue;
+        }
+
+        for_each_va_block_page_in_region(page_index, subregion) {
+            status = block_map_cpu_page_to(block,
+                                           block_context->hmm.vma,
+                                           resident_id,
+                                           page_index,
+                                           new_prot);
+            if (status != NV_OK)
+                break;
+
+            uvm_processor_mask_set(&block->mapped, UVM_ID_CPU);
+        }
+
         if (status != NV_OK)
             break;
-
-        uvm_processor_mask_set(&block->mapped, UVM_ID_CPU);
     }
 
     // If there was some error, shrink the region so that we only update the
@@ -11159,8 +11582,13 @@ static bool can_read_duplicate(uvm_va_block_t *va_block,
     if (uvm_va_policy_is_read_duplicate(policy))
         return true;
 
-    if (policy->read_duplication != UVM_READ_DUPLICATION_DISABLED &&
-        uvm_page_mask_test(&va_block->read_duplicated_pages, page_index) &&
+    if (policy->read_duplication == UVM_READ_DUPLICATION_DISABLED)
+        return false;
+
+    if (thrashing_hint->type == UVM_PERF_THRASHING_HINT_TYPE_READ_DUPLICATE)
+        return true;
+
+    if (uvm_page_mask_test(&va_block->read_duplicated_pages, page_index) &&
         thrashing_hint->type != UVM_PERF_THRASHING_HINT_TYPE_PIN)
         return true;
 
@@ -12348,6 +12776,34 @@ static bool skip_cpu_fault_with_valid_permissions(uvm_va_block_t *va_block,
     return false;
 }
 
+// Check whether a CPU fault can be serviced for the whole block. See
+// uvm_perf_cpu_fault_whole_block.
+static bool block_cpu_fault_whole_block(uvm_va_block_t *va_block,
+                                        uvm_processor_id_t new_residency,
+                                        bool read_duplicate,
+                                        const uvm_perf_thrashing_hint_t *thrashing_hint)
+{
+    if (!uvm_perf_cpu_fault_whole_block)
+        return false;
+
+    if (uvm_va_block_is_hmm(va_block) || uvm_va_block_size(va_block) != UVM_PAGE_SIZE_2M)
+        return false;
+
+    if (!UVM_ID_IS_CPU(new_residency) || read_duplicate || thrashing_hint->type != UVM_PERF_THRASHING_HINT_TYPE_NONE)
+        return false;
+
+    // Mapping the whole block must not require revoking any mapping
+    if (!uvm_processor_mask_empty(&va_block->mapped))
+        return false;
+
+    if (uvm_processor_mask_empty(&va_block->resident))
+        return true;
+
+    return uvm_processor_mask_get_count(&va_block->resident) == 1 &&
+           uvm_processor_mask_test(&va_block->resident, UVM_ID_CPU) &&
+           uvm_page_mask_full(uvm_va_block_resident_mask_get(va_block, UVM_ID_CPU, NUMA_NO_NODE));
+}
+
 static NV_STATUS block_cpu_fault_locked(uvm_va_block_t *va_block,
                                         uvm_va_block_retry_t *va_block_retry,
                                         NvU64 fault_addr,
@@ -12407,7 +12863,11 @@ static NV_STATUS block_cpu_fault_locked(uvm_va_block_t *va_block,
     if (skip_cpu_fault_with_valid_permissions(va_block, page_index, fault_access_type))
         return NV_OK;
 
-    thrashing_hint = uvm_perf_thrashing_get_hint(va_block, service_context->block_context, fault_addr, UVM_ID_CPU);
+    thrashing_hint = uvm_perf_thrashing_get_hint(va_block,
+                                                 service_context->block_context,
+                                                 fault_addr,
+                                                 UVM_ID_CPU,
+                                                 uvm_fault_access_type_mask_bit(fault_access_type));
     // Throttling is implemented by sleeping in the fault handler on the CPU
     if (thrashing_hint.type == UVM_PERF_THRASHING_HINT_TYPE_THROTTLE) {
         service_context->cpu_fault.wakeup_time_stamp = thrashing_hint.throttle.end_time_stamp;
@@ -12457,6 +12917,16 @@ static NV_STATUS block_cpu_fault_locked(uvm_va_block_t *va_block,
 
     service_context->region = uvm_va_block_region_for_page(page_index);
 
+    if (block_cpu_fault_whole_block(va_block, new_residency, read_duplicate, &thrashing_hint)) {
+        uvm_page_index_t block_page_index;
+
+        service_context->region = uvm_va_block_region_from_block(va_block);
+        uvm_page_mask_fill(&service_context->per_processor_masks[uvm_id_value(new_residency)].new_residency);
+
+        for_each_va_block_page(block_page_index, va_block)
+            service_context->access_type[block_page_index] = fault_access_type;
+    }
+
     status = uvm_va_block_service_locked(UVM_ID_CPU, va_block, va_block_retry, service_context);
     UVM_ASSERT(status != NV_WARN_MISMATCHED_TARGET);
 
@@ -13016,12 +13486,12 @@ NV_STATUS uvm_va_block_evict_chunks(uvm_va_block_t *va_block,
     // adding a new processor to the mask triggers going over all the VA blocks
     // in the range and locking them. And we hold one of the VA block's locks.
     //
-    // If uvm_va_range_set_accessed_by() hasn't called
+    // If uvm_va_range_map_accessed_by() hasn't called
     // uvm_va_block_set_accessed_by() for this block yet then it will take care
     // of adding the mapping after we are done. If it already did then we are
     // guaranteed to see the new processor in the accessed_by mask because we
     // locked the block's lock that the thread calling
-    // uvm_va_range_set_accessed_by() unlocked after updating the mask.
+    // uvm_va_range_map_accessed_by() unlocked after the mask was updated.
     //
     // If a processor gets removed from the mask then we might not notice and
     // schedule the work item anyway, but that's benign as
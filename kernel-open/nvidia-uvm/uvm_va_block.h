@@ -111,6 +111,10 @@ typedef struct
     // Pages that have been evicted to sysmem
     uvm_page_mask_t evicted;
 
+    // Time of the most recent eviction of pages in the evicted mask, used to
+    // report re-faults after eviction to PMM
+    NvU64 evicted_time;
+
     // Array of naturally-aligned chunks. Each chunk has the largest possible
     // size which can fit within the block, so they are not uniform size.
     //
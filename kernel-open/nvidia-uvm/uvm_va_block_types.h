@@ -239,6 +239,13 @@ typedef struct
         // Access counters notification buffer index. Only valid when cause is
         // UVM_MAKE_RESIDENT_CAUSE_ACCESS_COUNTER.
         NvU32 access_counters_buffer_index;
+
+        // Hint used to pick the channel for the copies pushed by the
+        // migration. See uvm_channel_reserve_type_with_hint(). Callers
+        // migrating many blocks back to back can set a different hint per
+        // block to spread the copies across the channels of the CE pool. It
+        // is reset to 0 by uvm_va_block_context_init().
+        NvU32 copy_channel_hint;
     } make_resident;
 
     // State used by the mapping APIs (unmap, map, revoke). This could be used
@@ -269,6 +276,10 @@ typedef struct
         uvm_pte_batch_t pte_batch;
         uvm_tlb_batch_t tlb_batch;
 
+        // Pages inserted in a single batch when mapping a run of unmapped
+        // pages on the CPU
+        struct page *cpu_pages[PAGES_PER_UVM_VA_BLOCK];
+
         // Event that triggered the call to the mapping function
         UvmEventMapRemoteCause cause;
     } mapping;
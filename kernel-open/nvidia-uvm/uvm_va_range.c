@@ -1572,18 +1572,21 @@ out:
     return status;
 }
 
-NV_STATUS uvm_va_range_set_accessed_by(uvm_va_range_managed_t *managed_range,
+void uvm_va_range_set_accessed_by(uvm_va_range_managed_t *managed_range, uvm_processor_id_t processor_id)
+{
+    uvm_assert_rwsem_locked_write(&managed_range->va_range.va_space->lock);
+
+    uvm_processor_mask_set(&managed_range->policy.accessed_by, processor_id);
+}
+
+NV_STATUS uvm_va_range_map_accessed_by(uvm_va_range_managed_t *managed_range,
                                        uvm_processor_id_t processor_id,
-                                       struct mm_struct *mm,
-                                       uvm_tracker_t *out_tracker)
+                                       uvm_va_block_context_t *va_block_context)
 {
     NV_STATUS status = NV_OK;
     uvm_va_block_t *va_block;
-    uvm_va_space_t *va_space = managed_range->va_range.va_space;
-    uvm_va_policy_t *policy = &managed_range->policy;
-    uvm_va_block_context_t *va_block_context = uvm_va_space_block_context(va_space, mm);
 
-    uvm_processor_mask_set(&policy->accessed_by, processor_id);
+    UVM_ASSERT(uvm_processor_mask_test(&managed_range->policy.accessed_by, processor_id));
 
     for_each_va_block_in_va_range(managed_range, va_block) {
         status = uvm_va_block_set_accessed_by(va_block, va_block_context, processor_id);
@@ -1051,20 +1051,25 @@ NV_STATUS uvm_va_range_set_preferred_location(uvm_va_range_managed_t *managed_ra
                                               struct mm_struct *mm,
                                               uvm_tracker_t *out_tracker);
 
-// Add a processor to the accessed_by mask and establish any new required
-// mappings.
+// Add a processor to the accessed_by mask. This doesn't establish the mappings
+// required by the new policy, see uvm_va_range_map_accessed_by().
 //
-// If mm != NULL, that mm is used for any CPU mappings which may be created as
-// a result of this call. See uvm_va_block_context_t::mm for details.
+// LOCKING: The caller must hold the VA space lock in write mode.
+void uvm_va_range_set_accessed_by(uvm_va_range_managed_t *managed_range, uvm_processor_id_t processor_id);
+
+// Establish the mappings required by processor_id being in the accessed_by mask
+// on all populated VA blocks of the range. VA blocks are mapped one at a time
+// under their own lock, so this may run concurrently with fault servicing.
 //
-// If out_tracker != NULL any block work will be added to that tracker.
+// va_block_context must not be NULL. If va_block_context->mm != NULL, that mm
+// is used for any CPU mappings which may be created as a result of this call.
 //
-// LOCKING: If mm != NULL, the caller must hold mm->mmap_lock in at least read
-//          mode.
-NV_STATUS uvm_va_range_set_accessed_by(uvm_va_range_managed_t *managed_range,
+// LOCKING: The caller must hold the VA space lock in at least read mode. If
+//          va_block_context->mm != NULL, the caller must hold mm->mmap_lock in
+//          at least read mode.
+NV_STATUS uvm_va_range_map_accessed_by(uvm_va_range_managed_t *managed_range,
                                        uvm_processor_id_t processor_id,
-                                       struct mm_struct *mm,
-                                       uvm_tracker_t *out_tracker);
+                                       uvm_va_block_context_t *va_block_context);
 
 // Remove a processor from the accessed_by mask
 //
@@ -232,6 +232,7 @@ NV_STATUS uvm_va_space_create(struct address_space *mapping, uvm_va_space_t **va
 
     va_space->mapping = mapping;
     va_space->test.page_prefetch_enabled = true;
+    uvm_perf_prefetch_init_va_space(va_space);
 
     init_tools_data(va_space);
 
@@ -332,6 +332,9 @@ struct uvm_va_space_struct
     // Per-va_space event notification information for performance heuristics
     uvm_perf_va_space_events_t perf_events;
 
+    // Stream detector state of the stream prefetcher
+    uvm_perf_prefetch_streams_t prefetch_streams;
+
     uvm_perf_module_data_desc_t perf_modules_data[UVM_PERF_MODULE_TYPE_COUNT];
 
     // Array of modules that are loaded in the va_space, indexed by module type
@@ -397,6 +400,7 @@ struct uvm_va_space_struct
     struct
     {
         bool  page_prefetch_enabled;
+        bool  page_prefetch_stream_enabled;
         bool  skip_migrate_vma;
 
         atomic_t migrate_vma_allocation_fail_nth;
@@ -239,6 +239,34 @@ nv_procfs_read_version(
 
 NV_DEFINE_SINGLE_NVRM_PROCFS_FILE(version);
 
+static int
+nv_procfs_read_control_cache(
+    struct seq_file *s,
+    void *v
+)
+{
+    nvidia_stack_t *sp = NULL;
+    nv_control_cache_stats_t stats;
+
+    if (nv_kmem_cache_alloc_stack(&sp) != 0)
+    {
+        return 0;
+    }
+
+    rm_get_control_cache_stats(sp, &stats);
+
+    seq_printf(s, "Hits:              %llu\n", stats.hits);
+    seq_printf(s, "Misses:            %llu\n", stats.misses);
+    seq_printf(s, "Invalidations:     %llu\n", stats.invalidations);
+    seq_printf(s, "Lock-free hits:    %llu\n", stats.lock_free_hits);
+    seq_printf(s, "Lock-free retries: %llu\n", stats.lock_free_retries);
+
+    nv_kmem_cache_free_stack(sp);
+    return 0;
+}
+
+NV_DEFINE_SINGLE_NVRM_PROCFS_FILE(control_cache);
+
 static void
 nv_procfs_close_file(
     nv_procfs_private_t *nvpp
@@ -1375,6 +1403,10 @@ int nv_procfs_init(void)
     if (!entry)
         goto failed;
 
+    entry = NV_CREATE_PROC_FILE("control_cache", proc_nvidia, control_cache, NULL);
+    if (!entry)
+        goto failed;
+
     proc_nvidia_gpus = NV_CREATE_PROC_DIR("gpus", proc_nvidia);
     if (!proc_nvidia_gpus)
         goto failed;
@@ -233,6 +233,7 @@ typedef struct NV0100_CTRL_GET_LOCK_STRESS_COUNTERS_PARAMS {
     NvS32 gpuLockStressCounter;
     NvS32 clientLockStressCounter;
     NvS32 internalClientLockStressCounter;
+    NvS32 gpuApiLockStressCounter;
 } NV0100_CTRL_GET_LOCK_STRESS_COUNTERS_PARAMS;
 
 /* 
@@ -261,3 +262,66 @@ typedef struct NV0100_CTRL_CMD_RECURSIVE_GPU_LOCK_TEST_PARAM {
 #define NV0100_CTRL_CMD_RECURSIVE_GPU_LOCK_TEST_ALL_LOCK    (0x100010cU) /* finn: Evaluated from "(FINN_LOCK_STRESS_OBJECT_LOCK_STRESS_INTERFACE_ID << 8) | (NV0100_CTRL_CMD_RECURSIVE_GPU_LOCK_TEST_PARAM_MESSAGE_ID + 1)" */
 #define NV0100_CTRL_CMD_RECURSIVE_GPU_LOCK_TEST_DEVICE_LOCK (0x100010dU) /* finn: Evaluated from "(FINN_LOCK_STRESS_OBJECT_LOCK_STRESS_INTERFACE_ID << 8) | (NV0100_CTRL_CMD_RECURSIVE_GPU_LOCK_TEST_PARAM_MESSAGE_ID + 2)" */
 
+/*
+ * NV0100_CTRL_CMD_PERFORM_LOCK_STRESS_PER_GPU_API_LOCK
+ *
+ * This command does a random increment/decrement on the per-GPU API lock stress
+ * counter of the object's GPU and reports the operation performed back to the caller.
+ * This is done with the device GPU lock held and either the API lock held in write
+ * mode, or, if the per-GPU API lock is enabled, the API lock held in read mode and
+ * the per-GPU API lock held in write mode. Issuing this command from one thread per
+ * GPU measures how the API lock scales across GPUs.
+ *
+ * action [OUT]
+ *   NV0100_CTRL_GPU_API_LOCK_STRESS_COUNTER_INCREMENT if the counter was incremented
+ *
+ * bPerGpuApiLock [OUT]
+ *   NV_TRUE if the command ran under the per-GPU API lock
+ *
+ * Possible status values returned are:
+ *    NV_OK
+ *    NV_ERR_INVALID_LOCK_STATE
+ */
+#define NV0100_CTRL_CMD_PERFORM_LOCK_STRESS_PER_GPU_API_LOCK (0x100010eU) /* finn: Evaluated from "(FINN_LOCK_STRESS_OBJECT_LOCK_STRESS_INTERFACE_ID << 8) | NV0100_CTRL_PERFORM_LOCK_STRESS_PER_GPU_API_LOCK_PARAMS_MESSAGE_ID" */
+
+#define NV0100_CTRL_GPU_API_LOCK_STRESS_COUNTER_INCREMENT          0:0
+
+#define NV0100_CTRL_PERFORM_LOCK_STRESS_PER_GPU_API_LOCK_PARAMS_MESSAGE_ID (0xEU)
+
+typedef struct NV0100_CTRL_PERFORM_LOCK_STRESS_PER_GPU_API_LOCK_PARAMS {
+    NvU8   action;
+    NvBool bPerGpuApiLock;
+} NV0100_CTRL_PERFORM_LOCK_STRESS_PER_GPU_API_LOCK_PARAMS;
+
+/*
+ * NV0100_CTRL_CMD_GET_PER_GPU_API_LOCK_STATS
+ *
+ * This command gets the per-GPU API lock counters of the object's GPU.
+ *
+ * bEnabled [OUT]
+ *   NV_TRUE if the per-GPU API lock is enabled
+ *
+ * acquireCount [OUT]
+ *   Number of times the per-GPU API lock was acquired
+ *
+ * contentionCount [OUT]
+ *   Number of acquires that had to wait for another owner
+ *
+ * waitTimeNs [OUT]
+ *   Total time spent waiting for the per-GPU API lock, only collected when
+ *   RM lock time collection is enabled
+ *
+ * Possible status values returned are:
+ *    NV_OK
+ */
+#define NV0100_CTRL_CMD_GET_PER_GPU_API_LOCK_STATS (0x100010fU) /* finn: Evaluated from "(FINN_LOCK_STRESS_OBJECT_LOCK_STRESS_INTERFACE_ID << 8) | NV0100_CTRL_GET_PER_GPU_API_LOCK_STATS_PARAMS_MESSAGE_ID" */
+
+#define NV0100_CTRL_GET_PER_GPU_API_LOCK_STATS_PARAMS_MESSAGE_ID (0xFU)
+
+typedef struct NV0100_CTRL_GET_PER_GPU_API_LOCK_STATS_PARAMS {
+    NvBool bEnabled;
+    NV_DECLARE_ALIGNED(NvU64 acquireCount, 8);
+    NV_DECLARE_ALIGNED(NvU64 contentionCount, 8);
+    NV_DECLARE_ALIGNED(NvU64 waitTimeNs, 8);
+} NV0100_CTRL_GET_PER_GPU_API_LOCK_STATS_PARAMS;
+
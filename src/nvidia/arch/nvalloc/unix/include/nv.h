@@ -765,6 +765,15 @@ typedef struct
     const char *db_support;
 } nv_power_info_t;
 
+typedef struct
+{
+    NvU64 hits;
+    NvU64 misses;
+    NvU64 invalidations;
+    NvU64 lock_free_hits;
+    NvU64 lock_free_retries;
+} nv_control_cache_stats_t;
+
 typedef enum
 {
     NV_MEMORY_TYPE_SYSTEM,      /* Memory mapped for ROM, SBIOS and physical RAM. */
@@ -1268,6 +1277,7 @@ NV_STATUS  NV_API_CALL rm_ref_dynamic_power(nvidia_stack_t *, nv_state_t *, nv_d
 void       NV_API_CALL rm_unref_dynamic_power(nvidia_stack_t *, nv_state_t *, nv_dynamic_power_mode_t);
 NV_STATUS  NV_API_CALL rm_transition_dynamic_power(nvidia_stack_t *, nv_state_t *, NvBool, NvBool *);
 void       NV_API_CALL rm_get_power_info(nvidia_stack_t *, nv_state_t *, nv_power_info_t *);
+void       NV_API_CALL rm_get_control_cache_stats(nvidia_stack_t *, nv_control_cache_stats_t *);
 
 void       NV_API_CALL rm_acpi_notify(nvidia_stack_t *, nv_state_t *, NvU32);
 void       NV_API_CALL rm_acpi_nvpcf_notify(nvidia_stack_t *);
@@ -5527,6 +5527,31 @@ NvBool NV_API_CALL rm_disable_iomap_wc(void)
     return pCl->getProperty(pCl, PDB_PROP_CL_DISABLE_IOMAP_WC) == NV_TRUE;
 }
 
+//
+// Snapshot the RM control cache counters. The counters are maintained
+// without locks, so no RM lock is taken here either.
+//
+void NV_API_CALL rm_get_control_cache_stats(
+    nvidia_stack_t           *sp,
+    nv_control_cache_stats_t *pStats
+)
+{
+    void                     *fp;
+    RMAPI_CONTROL_CACHE_STATS stats;
+
+    NV_ENTER_RM_RUNTIME(sp,fp);
+
+    rmapiControlCacheGetStats(&stats);
+
+    pStats->hits              = stats.hits;
+    pStats->misses            = stats.misses;
+    pStats->invalidations     = stats.invalidations;
+    pStats->lock_free_hits    = stats.lockFreeHits;
+    pStats->lock_free_retries = stats.lockFreeRetries;
+
+    NV_EXIT_RM_RUNTIME(sp,fp);
+}
+
 //
 // Verifies the handle, offset and size and dups hMemory.
 // Must be called with API lock and GPU lock held.
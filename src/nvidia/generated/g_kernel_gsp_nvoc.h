@@ -2194,6 +2194,8 @@ NvBool kgspHasLibosKernelLogging_STATIC_DISPATCH(struct OBJGPU *pGpu);
 
 NV_STATUS rpcRmApiControl_GSP(RM_API *pRmApi, NvHandle hClient, NvHandle hObject,
                               NvU32 cmd, void *pParamStructPtr, NvU32 paramsSize);
+NV_STATUS rpcRmApiControlBatch_GSP(RM_API *pRmApi, NvHandle hClient,
+                                   RMAPI_CONTROL_BATCH_ENTRY *pEntries, NvU32 numEntries);
 NV_STATUS rpcRmApiAlloc_GSP(RM_API *pRmApi, NvHandle hClient, NvHandle hParent,
                             NvHandle hObject, NvU32 hClass, void *pAllocParams, NvU32 allocParamsSize);
 NV_STATUS rpcRmApiDupObject_GSP(RM_API *pRmApi, NvHandle hClient, NvHandle hParent, NvHandle *phObject,
@@ -321,6 +321,36 @@ static const struct NVOC_EXPORTED_METHOD_DEF __nvoc_exported_method_def_LockStre
         /*pClassInfo=*/ &(__nvoc_class_def_LockStressObject.classInfo),
 #if NV_PRINTF_STRINGS_ALLOWED
         /*func=*/       "lockStressObjCtrlCmdRecursiveGpuLockTestDeviceLock"
+#endif
+    },
+    {               /*  [13] */
+#if NVOC_EXPORTED_METHOD_DISABLED_BY_FLAG(0x1000018u)
+        /*pFunc=*/      (void (*)(void)) NULL,
+#else
+        /*pFunc=*/      (void (*)(void)) &lockStressObjCtrlCmdPerformLockStressPerGpuApiLock_IMPL,
+#endif // NVOC_EXPORTED_METHOD_DISABLED_BY_FLAG(0x1000018u)
+        /*flags=*/      0x1000018u,
+        /*accessRight=*/0x0u,
+        /*methodId=*/   0x100010eu,
+        /*paramSize=*/  sizeof(NV0100_CTRL_PERFORM_LOCK_STRESS_PER_GPU_API_LOCK_PARAMS),
+        /*pClassInfo=*/ &(__nvoc_class_def_LockStressObject.classInfo),
+#if NV_PRINTF_STRINGS_ALLOWED
+        /*func=*/       "lockStressObjCtrlCmdPerformLockStressPerGpuApiLock"
+#endif
+    },
+    {               /*  [14] */
+#if NVOC_EXPORTED_METHOD_DISABLED_BY_FLAG(0x109u)
+        /*pFunc=*/      (void (*)(void)) NULL,
+#else
+        /*pFunc=*/      (void (*)(void)) &lockStressObjCtrlCmdGetPerGpuApiLockStats_IMPL,
+#endif // NVOC_EXPORTED_METHOD_DISABLED_BY_FLAG(0x109u)
+        /*flags=*/      0x109u,
+        /*accessRight=*/0x0u,
+        /*methodId=*/   0x100010fu,
+        /*paramSize=*/  sizeof(NV0100_CTRL_GET_PER_GPU_API_LOCK_STATS_PARAMS),
+        /*pClassInfo=*/ &(__nvoc_class_def_LockStressObject.classInfo),
+#if NV_PRINTF_STRINGS_ALLOWED
+        /*func=*/       "lockStressObjCtrlCmdGetPerGpuApiLockStats"
 #endif
     },
 };
@@ -582,7 +612,7 @@ void __nvoc_up_thunk_RsResource_lockStressObjAddAdditionalDependants(struct RsCl
 
 const struct NVOC_EXPORT_INFO __nvoc_export_info__LockStressObject = 
 {
-    .numEntries=     13,
+    .numEntries=     15,
     .pExportEntries= __nvoc_exported_method_def_LockStressObject
 };
 
@@ -293,6 +293,26 @@ static inline NV_STATUS lockStressObjCtrlCmdRecursiveGpuLockTestDeviceLock(struc
 #define lockStressObjCtrlCmdRecursiveGpuLockTestDeviceLock(pResource, pParams) lockStressObjCtrlCmdRecursiveGpuLockTestDeviceLock_IMPL(pResource, pParams)
 #endif // __nvoc_lock_stress_h_disabled
 
+NV_STATUS lockStressObjCtrlCmdPerformLockStressPerGpuApiLock_IMPL(struct LockStressObject *pResource, NV0100_CTRL_PERFORM_LOCK_STRESS_PER_GPU_API_LOCK_PARAMS *pParams);
+#ifdef __nvoc_lock_stress_h_disabled
+static inline NV_STATUS lockStressObjCtrlCmdPerformLockStressPerGpuApiLock(struct LockStressObject *pResource, NV0100_CTRL_PERFORM_LOCK_STRESS_PER_GPU_API_LOCK_PARAMS *pParams) {
+    NV_ASSERT_FAILED_PRECOMP("LockStressObject was disabled!");
+    return NV_ERR_NOT_SUPPORTED;
+}
+#else // __nvoc_lock_stress_h_disabled
+#define lockStressObjCtrlCmdPerformLockStressPerGpuApiLock(pResource, pParams) lockStressObjCtrlCmdPerformLockStressPerGpuApiLock_IMPL(pResource, pParams)
+#endif // __nvoc_lock_stress_h_disabled
+
+NV_STATUS lockStressObjCtrlCmdGetPerGpuApiLockStats_IMPL(struct LockStressObject *pResource, NV0100_CTRL_GET_PER_GPU_API_LOCK_STATS_PARAMS *pParams);
+#ifdef __nvoc_lock_stress_h_disabled
+static inline NV_STATUS lockStressObjCtrlCmdGetPerGpuApiLockStats(struct LockStressObject *pResource, NV0100_CTRL_GET_PER_GPU_API_LOCK_STATS_PARAMS *pParams) {
+    NV_ASSERT_FAILED_PRECOMP("LockStressObject was disabled!");
+    return NV_ERR_NOT_SUPPORTED;
+}
+#else // __nvoc_lock_stress_h_disabled
+#define lockStressObjCtrlCmdGetPerGpuApiLockStats(pResource, pParams) lockStressObjCtrlCmdGetPerGpuApiLockStats_IMPL(pResource, pParams)
+#endif // __nvoc_lock_stress_h_disabled
+
 
 // Wrapper macros for halified functions
 #define lockStressObjControl_FNPTR(pGpuResource) pGpuResource->__nvoc_base_GpuResource.__nvoc_metadata_ptr->vtable.__gpuresControl__
@@ -475,6 +495,10 @@ NV_STATUS lockStressObjCtrlCmdRecursiveGpuLockTestAllLock_IMPL(struct LockStress
 
 NV_STATUS lockStressObjCtrlCmdRecursiveGpuLockTestDeviceLock_IMPL(struct LockStressObject *pResource, NV0100_CTRL_CMD_RECURSIVE_GPU_LOCK_TEST_PARAM *pParams);
 
+NV_STATUS lockStressObjCtrlCmdPerformLockStressPerGpuApiLock_IMPL(struct LockStressObject *pResource, NV0100_CTRL_PERFORM_LOCK_STRESS_PER_GPU_API_LOCK_PARAMS *pParams);
+
+NV_STATUS lockStressObjCtrlCmdGetPerGpuApiLockStats_IMPL(struct LockStressObject *pResource, NV0100_CTRL_GET_PER_GPU_API_LOCK_STATS_PARAMS *pParams);
+
 // HAL method declarations without bodies
 // Inline HAL method definitions
 // Static dispatch method declarations
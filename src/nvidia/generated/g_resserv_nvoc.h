@@ -207,12 +207,14 @@ typedef void *PUID_TOKEN;
 #define RS_LOCK_FLAGS_NO_DEPENDANT_SESSION_LOCK NVBIT(5)
 #define RS_LOCK_FLAGS_FREE_SESSION_LOCK         NVBIT(6)
 #define RS_LOCK_FLAGS_LOW_PRIORITY              NVBIT(7)
+#define RS_LOCK_FLAGS_CUSTOM_LOCK_4             NVBIT(8)
 
 /// RS_LOCK_STATE
 #define RS_LOCK_STATE_TOP_LOCK_ACQUIRED        NVBIT(0)
 #define RS_LOCK_STATE_CUSTOM_LOCK_1_ACQUIRED   NVBIT(1)
 #define RS_LOCK_STATE_CUSTOM_LOCK_2_ACQUIRED   NVBIT(2)
 #define RS_LOCK_STATE_CUSTOM_LOCK_3_ACQUIRED   NVBIT(3)
+#define RS_LOCK_STATE_CUSTOM_LOCK_4_ACQUIRED   NVBIT(4)
 #define RS_LOCK_STATE_ALLOW_RECURSIVE_RES_LOCK NVBIT(6)
 #define RS_LOCK_STATE_CLIENT_LOCK_ACQUIRED     NVBIT(7)
 #define RS_LOCK_STATE_SESSION_LOCK_ACQUIRED    NVBIT(8)
@@ -224,6 +226,7 @@ typedef void *PUID_TOKEN;
 #define RS_LOCK_RELEASE_CUSTOM_LOCK_2          NVBIT(3)
 #define RS_LOCK_RELEASE_CUSTOM_LOCK_3          NVBIT(4)
 #define RS_LOCK_RELEASE_SESSION_LOCK           NVBIT(5)
+#define RS_LOCK_RELEASE_CUSTOM_LOCK_4          NVBIT(6)
 
 /// API enumerations used for locking knobs
 typedef enum
@@ -65,6 +65,28 @@ typedef struct RpcHistoryEntry
     NvU64 ts_end;
 } RpcHistoryEntry;
 
+//
+// Maximum number of RPCs that may be outstanding without their response having
+// been received. Kept well below the depth of the GSP status queue so that
+// responses left undrained can never stall GSP-RM.
+//
+#define RPC_DEFERRED_DEPTH 16
+
+//
+// Completion callback of a deferred RPC. It is called with the GPU lock held,
+// from whichever thread drains the response, and must not issue RPCs.
+//
+typedef void RpcDeferredCallback(OBJGPU *pGpu, void *pArg, NvU32 function, NvU32 sequence, NV_STATUS status);
+
+typedef struct RpcDeferredEntry
+{
+    NvU32 function;
+    NvU32 sequence;
+    NvU32 historyEntry;     // slot in OBJRPC::rpcHistory
+    RpcDeferredCallback *pCallback;
+    void *pCallbackArg;
+} RpcDeferredEntry;
+
 struct OBJRPC{
     OBJECT_BASE_DEFINITION(RPC);
 
@@ -97,6 +119,20 @@ struct OBJRPC{
     NvU32 timeoutCount;
     NvBool bQuietPrints;
 
+    //
+    // RPCs sent without waiting for their response, oldest first. GSP-RM
+    // answers RPCs in order, so the responses are retired from the head of
+    // the ring as they are drained, either while waiting for a later RPC or
+    // when servicing GSP events.
+    //
+    RpcDeferredEntry deferred[RPC_DEFERRED_DEPTH];
+    NvU32 deferredHead;
+    NvU32 deferredCount;
+    NvU32 deferredFailures;
+
+    // Issue RM frees to GSP-RM without waiting for their completion
+    NvBool bDeferFree;
+
     OBJRPCSTRUCTURECOPY rpcStructureCopy;
 };
 
@@ -137,6 +173,13 @@ NV_STATUS _allocRpcMemDesc(OBJGPU *pGpu, NvU64 size, NvBool bContig, NV_ADDRESS_
                            MEMORY_DESCRIPTOR **ppMemDesc, void **ppMemBuffer, void **ppMemBufferPriv);
 void _freeRpcMemDesc(OBJGPU *pGpu, MEMORY_DESCRIPTOR **ppMemDesc, void **ppMemBuffer, void **ppMemBufferPriv);
 
+// Deferred RPC tracking, see OBJRPC::deferred
+NvBool rpcRetireDeferred(OBJGPU *pGpu, OBJRPC *pRpc, NvU32 function, NvU32 sequence, NvU32 rpcResult);
+NvBool rpcGetDeferredHistoryEntry(OBJRPC *pRpc, NvU32 function, NvU32 sequence, NvU32 *pHistoryEntry);
+NV_STATUS rpcWaitDeferred(OBJGPU *pGpu, OBJRPC *pRpc, NvU32 sequence);
+NV_STATUS rpcFlushDeferred(OBJGPU *pGpu, OBJRPC *pRpc);
+void rpcCancelDeferred(OBJGPU *pGpu, OBJRPC *pRpc, NV_STATUS status);
+
 NV_STATUS rpcDmaControl_wrapper(OBJGPU *pGpu, OBJRPC *pRpc, NvHandle hClient, NvHandle hObject, NvU32 cmd,
                                void *pParamStructPtr, NvU32 paramSize);
 //
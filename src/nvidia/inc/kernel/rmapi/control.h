@@ -65,6 +65,10 @@ struct RS_CONTROL_COOKIE
     // API Copy Flags
     NvU32        apiCopyFlags;
 
+    // Control cache invalidation sequence before the control ran, checked when
+    // filling the cache (RMCTRL_API_COPY_FLAGS_SET_CONTROL_CACHE)
+    NvU32        cacheInvalidateSeq;
+
     // Required Access Rights for this command
     const RS_ACCESS_MASK rightsRequired;
 
@@ -343,6 +347,15 @@ NV_STATUS embeddedParamCopyOut(RMAPI_PARAM_COPY  *pParamCopy, RmCtrlParams *pRmC
 //
 #define RMCTRL_FLAGS_PERSISTENT_CACHEABLE                     0x000800000
 
+//
+// This flag specifies that the control call takes the API lock in read-only
+// mode plus the per-GPU API lock of its device when NV_REG_STR_RM_PER_GPU_API_LOCK
+// is set, instead of the API lock in read-write mode.
+// Must be combined with RMCTRL_FLAGS_GPU_LOCK_DEVICE_ONLY, and the control must
+// not depend on state of other GPUs.
+//
+#define RMCTRL_FLAGS_PER_GPU_API_LOCK                         0x001000000
+
 //
 //  'ACCESS_RIGHTS' Attribute
 //  ------------------------
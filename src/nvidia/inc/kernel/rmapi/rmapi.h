@@ -111,6 +111,55 @@ NvBool rmapiLockIsWriteOwner(void);
  */
 void rmapiLockGetTimes(NV0000_CTRL_SYSTEM_GET_LOCK_TIMES_PARAMS *);
 
+/**
+ * Check if the API lock is partitioned per GPU (NV_REG_STR_RM_PER_GPU_API_LOCK)
+ *
+ * In that mode, operations that opted in and only touch a single GPU hold the
+ * global API lock for READ plus the per-GPU API lock of the GPUs they touch,
+ * instead of the global API lock for WRITE. Operations
+ * holding the global API lock for WRITE still exclude everyone else.
+ *
+ * Lock order: API lock, per-GPU API locks, GPU locks.
+ */
+NvBool rmapiLockIsPerGpuEnabled(void);
+
+/**
+ * Acquire the per-GPU API locks for the GPUs in gpuMask
+ *
+ * The caller must own the API lock and must not own any GPU lock. Per-GPU API
+ * locks are always taken in ascending GPU instance order.
+ *
+ * If the caller already owns per-GPU API locks, the missing ones are only
+ * acquired if available, and are released by the caller's rmapiLockReleaseGpus.
+ *
+ * @param[in] gpuMask Mask of GPU instances to lock
+ * @param[in] flags   RMAPI_LOCK_FLAGS_COND_ACQUIRE and/or RMAPI_LOCK_FLAGS_READ
+ *
+ * @returns NV_WARN_NOTHING_TO_DO if the per-GPU API lock is disabled, the caller
+ *          owns the API lock for WRITE, or the caller already owns per-GPU API
+ *          locks. rmapiLockReleaseGpus must only be called on NV_OK.
+ *          NV_ERR_INVALID_LOCK_STATE if the caller already owns per-GPU API locks
+ *          and the missing ones are not available.
+ */
+NV_STATUS rmapiLockAcquireGpus(NvU32 gpuMask, NvU32 flags);
+
+/**
+ * Release the per-GPU API locks owned by the current thread
+ */
+void rmapiLockReleaseGpus(void);
+
+/**
+ * Check if current thread owns the RW API lock or the RW per-GPU API lock
+ * of the given GPU
+ */
+NvBool rmapiLockIsGpuWriteOwner(NvU32 gpuInstance);
+
+/**
+ * Retrieve per-GPU API lock acquire, contention and wait time counters
+ */
+void rmapiLockGetGpuStats(NvU32 gpuInstance, NvU64 *pAcquireCount,
+                          NvU64 *pContentionCount, NvU64 *pWaitTime);
+
 /**
  * Indicates current thread is in the RTD3 PM path (rm_transition_dynamic_power) which
  * means that certain locking asserts/checks must be skipped due to inability to acquire
@@ -162,6 +211,19 @@ RM_API *rmapiGetInterface(RMAPI_TYPE rmapiType);
 #define RMAPI_RPC_FLAGS_COPYOUT_ON_ERROR          NVBIT(0)
 #define RMAPI_RPC_FLAGS_SERIALIZED                NVBIT(1)
 
+/**
+ * One control of a batch submitted through RM_API::ControlBatch. The status of
+ * each control is returned in the entry.
+ */
+typedef struct RMAPI_CONTROL_BATCH_ENTRY
+{
+    NvHandle  hObject;
+    NvU32     cmd;
+    void     *pParams;
+    NvU32     paramsSize;
+    NV_STATUS status;
+} RMAPI_CONTROL_BATCH_ENTRY;
+
 /**
  * Interface for performing operations through the RM API exposed to client
  * drivers. Interface provides consistent view to the RM API while abstracting
@@ -210,6 +272,11 @@ struct _RM_API
     // Prefetch a control parameters into the control call cache (0000, 0080 and 2080 classes only)
     NV_STATUS (*ControlPrefetch)(struct _RM_API *pRmApi, NvU32 cmd);
 
+    // Invoke a batch of controls in order with default security attributes and local pointers (no NvP64).
+    // Returns the first failing control status, all controls are attempted.
+    NV_STATUS (*ControlBatch)(struct _RM_API *pRmApi, NvHandle hClient, RMAPI_CONTROL_BATCH_ENTRY *pEntries,
+                              NvU32 numEntries);
+
     // Dup an object with default security attributes
     NV_STATUS (*DupObject)(struct _RM_API *pRmApi, NvHandle hClient, NvHandle hParent, NvHandle *phObject,
                            NvHandle hClientSrc, NvHandle hObjectSrc, NvU32 flags);
@@ -270,6 +337,9 @@ struct _RM_API
     void              *pPrivateContext;
 };
 
+// Default RM_API::ControlBatch implementation, issuing each control through RM_API::Control
+NV_STATUS rmapiControlBatch(RM_API *pRmApi, NvHandle hClient, RMAPI_CONTROL_BATCH_ENTRY *pEntries, NvU32 numEntries);
+
 // Called before any RM resource is freed
 NV_STATUS rmapiFreeResourcePrologue(RS_RES_FREE_PARAMS_INTERNAL *pRmFreeParams);
 
@@ -327,6 +397,34 @@ NV_STATUS rmapiControlCacheFreeForControl(NvU32 gpuInstance, NvU32 cmd);
 void rmapiControlCacheFreeClientEntry(NvHandle hClient);
 void rmapiControlCacheFreeObjectEntry(NvHandle hClient, NvHandle hObject);
 
+typedef struct
+{
+    NvU64 hits;
+    NvU64 misses;
+    NvU64 invalidations;
+    NvU64 lockFreeHits;
+    NvU64 lockFreeRetries;
+} RMAPI_CONTROL_CACHE_STATS;
+
+void rmapiControlCacheGetStats(RMAPI_CONTROL_CACHE_STATS *pStats);
+
+//
+// GPU state a cached control may depend on. The state-change paths invalidate
+// exactly the dependent entries through rmapiControlCacheInvalidate().
+//
+#define RMAPI_CONTROL_CACHE_DEP_CE_CONFIG       NVBIT(0)
+#define RMAPI_CONTROL_CACHE_DEP_ECC_CONFIG      NVBIT(1)
+#define RMAPI_CONTROL_CACHE_DEP_COMPUTE_MODE    NVBIT(2)
+#define RMAPI_CONTROL_CACHE_DEP_POWER_SOURCE    NVBIT(3)
+#define RMAPI_CONTROL_CACHE_DEP_MIG_CONFIG      NVBIT(4)
+
+NvU32 rmapiControlCacheGetDeclaredFlags(NvU32 cmd);
+NV_STATUS rmapiControlCacheInvalidate(NvU32 gpuInst, NvU32 dependencies);
+void rmapiControlCacheInvalidateForControl(NvHandle hClient, NvHandle hObject, NvU32 cmd);
+NvU32 rmapiControlCacheGetInvalidateSeq(void);
+NV_STATUS rmapiControlCacheSetSinceInvalidateSeq(NvHandle hClient, NvHandle hObject, NvU32 cmd,
+                                                 void* params, NvU32 paramsSize, NvU32 invalidateSeq);
+
 typedef struct _RM_API_CONTEXT {
     NvU32 gpuMask;
 } RM_API_CONTEXT;
@@ -440,6 +538,7 @@ rmapiInitLockInfo
 #define RM_LOCK_FLAGS_NO_GPUS_LOCK             RS_LOCK_FLAGS_NO_CUSTOM_LOCK_1
 #define RM_LOCK_FLAGS_GPU_GROUP_LOCK           RS_LOCK_FLAGS_NO_CUSTOM_LOCK_2
 #define RM_LOCK_FLAGS_RM_SEMA                  RS_LOCK_FLAGS_NO_CUSTOM_LOCK_3
+#define RM_LOCK_FLAGS_GPU_API_LOCK             RS_LOCK_FLAGS_CUSTOM_LOCK_4
 
 //
 // ResServ lock state translation
@@ -451,6 +550,7 @@ rmapiInitLockInfo
 #define RM_LOCK_STATES_ALLOW_RECURSIVE_LOCKS   RS_LOCK_STATE_ALLOW_RECURSIVE_RES_LOCK
 #define RM_LOCK_STATES_CLIENT_LOCK_ACQUIRED    RS_LOCK_STATE_CLIENT_LOCK_ACQUIRED
 #define RM_LOCK_STATES_RM_SEMA_ACQUIRED        RS_LOCK_STATE_CUSTOM_LOCK_3_ACQUIRED
+#define RM_LOCK_STATES_GPU_API_LOCK_ACQUIRED   RS_LOCK_STATE_CUSTOM_LOCK_4_ACQUIRED
 
 //
 // ResServ lock release translation
@@ -460,5 +560,6 @@ rmapiInitLockInfo
 #define RM_LOCK_RELEASE_GPUS_LOCK              RS_LOCK_RELEASE_CUSTOM_LOCK_1
 #define RM_LOCK_RELEASE_GPU_GROUP_LOCK         RS_LOCK_RELEASE_CUSTOM_LOCK_2
 #define RM_LOCK_RELEASE_RM_SEMA                RS_LOCK_RELEASE_CUSTOM_LOCK_3
+#define RM_LOCK_RELEASE_GPU_API_LOCK           RS_LOCK_RELEASE_CUSTOM_LOCK_4
 
 #endif // _RMAPI_H_
@@ -846,6 +846,24 @@
 //
 #define NV_REG_STR_RM_LOCKING_LOW_PRIORITY_AGING              "RMLockingLowPriorityAging"
 
+//
+// Type DWORD
+// Used to partition the RM API lock per GPU.
+// When enabled, controls flagged PER_GPU_API_LOCK and allocations of
+// classes flagged RS_FLAGS_ACQUIRE_PER_GPU_API_LOCK_ON_ALLOC (if RO API lock
+// allocations are supported) that would otherwise take the global API lock
+// for WRITE acquire it for READ plus a per-GPU API lock for WRITE, so that
+// such calls targeting different GPUs no longer serialize on the global API
+// lock. Everything else, including any operation spanning multiple GPUs,
+// keeps taking the global API lock as before.
+// 0 - (default) Use the global API lock only
+// 1 - Enable the per-GPU API lock
+//
+#define NV_REG_STR_RM_PER_GPU_API_LOCK                        "RmPerGpuApiLock"
+#define NV_REG_STR_RM_PER_GPU_API_LOCK_DISABLE                0x00000000
+#define NV_REG_STR_RM_PER_GPU_API_LOCK_ENABLE                 0x00000001
+#define NV_REG_STR_RM_PER_GPU_API_LOCK_DEFAULT                NV_REG_STR_RM_PER_GPU_API_LOCK_DISABLE
+
 //
 // Type DWORD
 // This regkey restricts profiling capabilities (creation of profiling objects
@@ -3197,6 +3215,16 @@
 #define NV_REG_STR_RM_GSP_RPC_TIMEOUT_GPU_RESET_THRESHOLD         "RmGspRpcTimeoutGpuResetThreshold"
 #define NV_REG_STR_RM_GSP_RPC_TIMEOUT_GPU_RESET_THRESHOLD_DEFAULT 3
 
+//
+// Type DWORD
+// Send RM frees to GSP-RM without waiting for their completion. Responses are
+// retired, and failures logged, when later RPCs or GSP events drain them.
+//
+#define NV_REG_STR_RM_GSP_DEFERRED_FREE                          "RmGspDeferredFree"
+#define NV_REG_STR_RM_GSP_DEFERRED_FREE_DISABLE                  (0x00000000)
+#define NV_REG_STR_RM_GSP_DEFERRED_FREE_ENABLE                   (0x00000001)
+#define NV_REG_STR_RM_GSP_DEFERRED_FREE_DEFAULT                  NV_REG_STR_RM_GSP_DEFERRED_FREE_DISABLE
+
 //
 // Type: DWORD
 // Regkey to set GSP-RM Log buffer size for TASK_INIT.
@@ -806,8 +806,8 @@ NV_STATUS kceTopLevelPceLceMappingsUpdate_IMPL(OBJGPU *pGpu, KernelCE *pKCe)
     params.bUpdateNvlinkPceLce = bUpdateNvlinkPceLce;
 
     NV_ASSERT_OK_OR_RETURN(
-        rmapiControlCacheFreeForControl(gpuGetInstance(pGpu),
-                                        NV2080_CTRL_CMD_CE_GET_CE_PCE_MASK));
+        rmapiControlCacheInvalidate(gpuGetInstance(pGpu),
+                                    RMAPI_CONTROL_CACHE_DEP_CE_CONFIG));
 
     // For GSP clients, the update needs to be routed through ctrl call
     params.shimInstance = pKCe->shimInstance;
@@ -194,8 +194,8 @@ clearCePceCacheAndForwardCtrlToGsp
     RM_API *pRmApi = GPU_GET_PHYSICAL_RMAPI(pGpu);
 
     NV_ASSERT_OK_OR_RETURN(
-        rmapiControlCacheFreeForControl(gpuGetInstance(pGpu),
-                                        NV2080_CTRL_CMD_CE_GET_CE_PCE_MASK));
+        rmapiControlCacheInvalidate(gpuGetInstance(pGpu),
+                                    RMAPI_CONTROL_CACHE_DEP_CE_CONFIG));
 
     if (IS_GSP_CLIENT(pGpu))
     {
@@ -392,6 +392,26 @@ _kgspCompleteRpcHistoryEntry
     }
 }
 
+//
+// rpcHistory slot of the RPC being waited for: the slot recorded for a deferred
+// RPC, otherwise the latest RPC sent.
+//
+static NvU32
+_kgspGetRpcHistoryEntry
+(
+    OBJRPC *pRpc,
+    NvU32 expectedFunc,
+    NvU32 expectedSequence
+)
+{
+    NvU32 historyEntry;
+
+    if (rpcGetDeferredHistoryEntry(pRpc, expectedFunc, expectedSequence, &historyEntry))
+        return historyEntry;
+
+    return pRpc->rpcHistoryCurrent;
+}
+
 /*!
  * GSP client RM RPC send routine
  */
@@ -1817,6 +1837,7 @@ _kgspRpcDrainOneEvent
 )
 {
     NV_STATUS nvStatus;
+    NvU32 historyEntry;
 
     // Issue a memory barrier to ensure we see any queue updates.
     // Note: Without the fence, the CPU may get stuck in an infinite loop
@@ -1835,6 +1856,13 @@ _kgspRpcDrainOneEvent
             return NV_WARN_MORE_PROCESSING_REQUIRED;
         }
 
+        // Responses to RPCs sent without waiting are retired as they arrive
+        if (rpcGetDeferredHistoryEntry(pRpc, pMsgHdr->function, pMsgHdr->sequence, &historyEntry))
+            _kgspCompleteRpcHistoryEntry(pRpc->rpcHistory, historyEntry);
+
+        if (rpcRetireDeferred(pGpu, pRpc, pMsgHdr->function, pMsgHdr->sequence, pMsgHdr->rpc_result))
+            return NV_OK;
+
         _kgspProcessRpcEvent(pGpu, pRpc, rpcHandlerContext);
     }
 
@@ -2190,10 +2218,11 @@ static void
 _kgspCheckSlowRpc
 (
     OBJGPU *pGpu,
-    OBJRPC *pRpc
+    OBJRPC *pRpc,
+    NvU32 historyEntry
 )
 {
-    RpcHistoryEntry *pHistoryEntry = &pRpc->rpcHistory[pRpc->rpcHistoryCurrent];
+    RpcHistoryEntry *pHistoryEntry = &pRpc->rpcHistory[historyEntry];
     NvU64 duration;
     KernelGsp *pKernelGsp = GPU_GET_KERNEL_GSP(pGpu);
     const NvU64 tsFreqUs = osGetTimestampFreq() / 1000000;
@@ -2358,7 +2387,8 @@ _kgspLogRpcTimeout
     NvBool bIsFatalTimeout
 )
 {
-    RpcHistoryEntry *pHistoryEntry = &pRpc->rpcHistory[pRpc->rpcHistoryCurrent];
+    RpcHistoryEntry *pHistoryEntry =
+        &pRpc->rpcHistory[_kgspGetRpcHistoryEntry(pRpc, expectedFunc, expectedSequence)];
     NvU64 ts_end = osGetTimestamp();
     NvU64 duration;
     char  durationUnitsChar;
@@ -2438,7 +2468,8 @@ _kgspLogRpcSanityCheckFailure
     NvU32 expectedSequence
 )
 {
-    RpcHistoryEntry *pHistoryEntry = &pRpc->rpcHistory[pRpc->rpcHistoryCurrent];
+    RpcHistoryEntry *pHistoryEntry =
+        &pRpc->rpcHistory[_kgspGetRpcHistoryEntry(pRpc, expectedFunc, expectedSequence)];
 
     NV_ASSERT(expectedFunc == pHistoryEntry->function);
 
@@ -2661,6 +2692,7 @@ _kgspRpcRecvPoll
     NvU32      timeoutFlags;
     NvBool     bSlowGspRpc = !IS_SILICON(pGpu);
     NvU32      gpuMaskUnused;
+    NvU32      historyEntry = _kgspGetRpcHistoryEntry(pRpc, expectedFunc, expectedSequence);
 
 #if defined(GSPRM_HWASAN_ENABLE)
     //
@@ -2771,10 +2803,10 @@ _kgspRpcRecvPoll
         switch (rpcStatus) {
             case NV_WARN_MORE_PROCESSING_REQUIRED:
                 // The synchronous RPC response we were waiting for is here
-                _kgspCompleteRpcHistoryEntry(pRpc->rpcHistory, pRpc->rpcHistoryCurrent);
+                _kgspCompleteRpcHistoryEntry(pRpc->rpcHistory, historyEntry);
                 if (!bSlowGspRpc)
                 {
-                    _kgspCheckSlowRpc(pGpu, pRpc);
+                    _kgspCheckSlowRpc(pGpu, pRpc, historyEntry);
                 }
                 rpcStatus = NV_OK;
                 goto done;
@@ -2958,6 +2990,7 @@ _kgspConstructRpcObject
 )
 {
     OBJRPC *pRpc;
+    NvU32 deferredFree;
 
     NV_ASSERT_OR_RETURN(pMQI != NULL, NV_ERR_INVALID_ARGUMENT);
 
@@ -2982,6 +3015,12 @@ _kgspConstructRpcObject
     rpcSendMessage_FNPTR(pRpc) = _kgspRpcSendMessage;
     rpcRecvPoll_FNPTR(pRpc)    = _kgspRpcRecvPoll;
 
+    if ((osReadRegistryDword(pGpu, NV_REG_STR_RM_GSP_DEFERRED_FREE, &deferredFree) == NV_OK) &&
+        (deferredFree == NV_REG_STR_RM_GSP_DEFERRED_FREE_ENABLE))
+    {
+        pRpc->bDeferFree = NV_TRUE;
+    }
+
     *ppRpc = pRpc;
 
     return NV_OK;
@@ -2996,6 +3035,7 @@ _kgspFreeRpcInfrastructure
 {
     if (pKernelGsp->pRpc != NULL)
     {
+        rpcCancelDeferred(pGpu, pKernelGsp->pRpc, NV_ERR_INVALID_STATE);
         rpcDestroy(pGpu, pKernelGsp->pRpc);
         portMemFree(pKernelGsp->pRpc);
         pKernelGsp->pRpc = NULL;
@@ -5096,6 +5136,11 @@ kgspUnloadRm_IMPL
     NvBool bGc6Entering = (unloadMode == KGSP_UNLOAD_MODE_GC6_ENTER);
 
     NV_PRINTF(LEVEL_INFO, "unloading GSP-RM\n");
+
+    // Retire RPCs sent without waiting before GSP-RM stops answering them
+    if (pKernelGsp->pRpc != NULL)
+        (void)rpcFlushDeferred(pGpu, pKernelGsp->pRpc);
+
     NV_RM_RPC_UNLOADING_GUEST_DRIVER(pGpu, rpcStatus, bInPmTransition, bGc6Entering, newPmLevel);
 
     if (gpuIsCCFeatureEnabled(pGpu))
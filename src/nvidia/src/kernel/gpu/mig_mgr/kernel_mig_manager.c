@@ -1555,8 +1555,10 @@ kmigmgrLoadStaticInfo_KERNEL
     RM_API *pRmApi = GPU_GET_PHYSICAL_RMAPI(pGpu);
     NV_STATUS status;
     NV2080_CTRL_INTERNAL_STATIC_MIGMGR_GET_PARTITIONABLE_ENGINES_PARAMS params = {0};
+    RMAPI_CONTROL_BATCH_ENTRY batch[5];
     ENGTYPE_BIT_VECTOR partitionableNv2080Engines;
     NvU32 nv2080EngineType;
+    NvU32 i;
     KernelMemorySystem *pKernelMemorySystem = GPU_GET_KERNEL_MEMORY_SYSTEM(pGpu);
 
     NV_ASSERT_OR_RETURN(pPrivate != NULL, NV_ERR_INVALID_STATE);
@@ -1578,14 +1580,62 @@ kmigmgrLoadStaticInfo_KERNEL
         NV_CHECK(LEVEL_ERROR, kmigmgrEnableAllLCEs(pGpu, pKernelMIGManager, NV_TRUE) == NV_OK);
     }
 
-    NV_CHECK_OK_OR_GOTO(status, LEVEL_ERROR,
-        pRmApi->Control(pRmApi,
-                        pGpu->hInternalClient,
-                        pGpu->hInternalSubdevice,
-                        NV2080_CTRL_CMD_INTERNAL_STATIC_KMIGMGR_GET_PARTITIONABLE_ENGINES,
-                        &params,
-                        sizeof(params)),
-        failed);
+    pPrivate->staticInfo.pSkylineInfo = portMemAllocNonPaged(sizeof(*pPrivate->staticInfo.pSkylineInfo));
+    NV_CHECK_OR_ELSE(LEVEL_ERROR,
+        pPrivate->staticInfo.pSkylineInfo != NULL,
+        status = NV_ERR_NO_MEMORY;
+        goto failed;);
+    portMemSet(pPrivate->staticInfo.pSkylineInfo, 0x0, sizeof(*pPrivate->staticInfo.pSkylineInfo));
+
+    pPrivate->staticInfo.pSwizzIdFbMemPageRanges = portMemAllocNonPaged(sizeof(*pPrivate->staticInfo.pSwizzIdFbMemPageRanges));
+    NV_CHECK_OR_ELSE(LEVEL_ERROR,
+        pPrivate->staticInfo.pSwizzIdFbMemPageRanges != NULL,
+        status = NV_ERR_NO_MEMORY;
+        goto failed;);
+    portMemSet(pPrivate->staticInfo.pSwizzIdFbMemPageRanges, 0x0, sizeof(*pPrivate->staticInfo.pSwizzIdFbMemPageRanges));
+
+    pPrivate->staticInfo.pCIProfiles = portMemAllocNonPaged(sizeof(*pPrivate->staticInfo.pCIProfiles));
+    NV_CHECK_OR_ELSE(LEVEL_ERROR,
+        pPrivate->staticInfo.pCIProfiles != NULL,
+        status = NV_ERR_NO_MEMORY;
+        goto failed;);
+    portMemSet(pPrivate->staticInfo.pCIProfiles, 0x0, sizeof(*pPrivate->staticInfo.pCIProfiles));
+
+    pPrivate->staticInfo.pProfiles = portMemAllocNonPaged(sizeof(*pPrivate->staticInfo.pProfiles));
+    NV_CHECK_OR_ELSE(LEVEL_ERROR,
+        pPrivate->staticInfo.pProfiles != NULL,
+        status = NV_ERR_NO_MEMORY;
+        goto failed;);
+    portMemSet(pPrivate->staticInfo.pProfiles, 0x0, sizeof(*pPrivate->staticInfo.pProfiles));
+
+    //
+    // None of these queries depends on another, so submit them as one batch
+    // rather than waiting on Physical RM for each of them in turn. The status
+    // of each query is checked below.
+    //
+    portMemSet(batch, 0, sizeof(batch));
+    batch[0].cmd        = NV2080_CTRL_CMD_INTERNAL_STATIC_KMIGMGR_GET_PARTITIONABLE_ENGINES;
+    batch[0].pParams    = &params;
+    batch[0].paramsSize = sizeof(params);
+    batch[1].cmd        = NV2080_CTRL_CMD_INTERNAL_STATIC_GRMGR_GET_SKYLINE_INFO;
+    batch[1].pParams    = pPrivate->staticInfo.pSkylineInfo;
+    batch[1].paramsSize = sizeof(*pPrivate->staticInfo.pSkylineInfo);
+    batch[2].cmd        = NV2080_CTRL_CMD_INTERNAL_STATIC_KMIGMGR_GET_SWIZZ_ID_FB_MEM_PAGE_RANGES;
+    batch[2].pParams    = pPrivate->staticInfo.pSwizzIdFbMemPageRanges;
+    batch[2].paramsSize = sizeof(*pPrivate->staticInfo.pSwizzIdFbMemPageRanges);
+    batch[3].cmd        = NV2080_CTRL_CMD_INTERNAL_STATIC_KMIGMGR_GET_COMPUTE_PROFILES;
+    batch[3].pParams    = pPrivate->staticInfo.pCIProfiles;
+    batch[3].paramsSize = sizeof(*pPrivate->staticInfo.pCIProfiles);
+    batch[4].cmd        = NV2080_CTRL_CMD_INTERNAL_STATIC_KMIGMGR_GET_PROFILES;
+    batch[4].pParams    = pPrivate->staticInfo.pProfiles;
+    batch[4].paramsSize = sizeof(*pPrivate->staticInfo.pProfiles);
+
+    for (i = 0; i < NV_ARRAY_ELEMENTS(batch); i++)
+        batch[i].hObject = pGpu->hInternalSubdevice;
+
+    (void)pRmApi->ControlBatch(pRmApi, pGpu->hInternalClient, batch, NV_ARRAY_ELEMENTS(batch));
+
+    NV_CHECK_OK_OR_GOTO(status, LEVEL_ERROR, batch[0].status, failed);
 
     //
     // Copy over the engineMask and save it in the staticInfo for later use.
@@ -1601,37 +1651,9 @@ kmigmgrLoadStaticInfo_KERNEL
     }
     FOR_EACH_IN_BITVECTOR_END();
 
+    NV_CHECK_OK_OR_GOTO(status, LEVEL_ERROR, batch[1].status, failed);
 
-    pPrivate->staticInfo.pSkylineInfo = portMemAllocNonPaged(sizeof(*pPrivate->staticInfo.pSkylineInfo));
-    NV_CHECK_OR_ELSE(LEVEL_ERROR,
-        pPrivate->staticInfo.pSkylineInfo != NULL,
-        status = NV_ERR_NO_MEMORY;
-        goto failed;);
-    portMemSet(pPrivate->staticInfo.pSkylineInfo, 0x0, sizeof(*pPrivate->staticInfo.pSkylineInfo));
-
-    NV_CHECK_OK_OR_GOTO(status, LEVEL_ERROR,
-        pRmApi->Control(pRmApi,
-                        pGpu->hInternalClient,
-                        pGpu->hInternalSubdevice,
-                        NV2080_CTRL_CMD_INTERNAL_STATIC_GRMGR_GET_SKYLINE_INFO,
-                        pPrivate->staticInfo.pSkylineInfo,
-                        sizeof(*pPrivate->staticInfo.pSkylineInfo)),
-        failed);
-
-    pPrivate->staticInfo.pSwizzIdFbMemPageRanges = portMemAllocNonPaged(sizeof(*pPrivate->staticInfo.pSwizzIdFbMemPageRanges));
-    NV_CHECK_OR_ELSE(LEVEL_ERROR,
-        pPrivate->staticInfo.pSwizzIdFbMemPageRanges != NULL,
-        status = NV_ERR_NO_MEMORY;
-        goto failed;);
-    portMemSet(pPrivate->staticInfo.pSwizzIdFbMemPageRanges, 0x0, sizeof(*pPrivate->staticInfo.pSwizzIdFbMemPageRanges));
-
-    status = pRmApi->Control(pRmApi,
-                             pGpu->hInternalClient,
-                             pGpu->hInternalSubdevice,
-                             NV2080_CTRL_CMD_INTERNAL_STATIC_KMIGMGR_GET_SWIZZ_ID_FB_MEM_PAGE_RANGES,
-                             pPrivate->staticInfo.pSwizzIdFbMemPageRanges,
-                             sizeof(*pPrivate->staticInfo.pSwizzIdFbMemPageRanges));
-
+    status = batch[2].status;
     if (status == NV_ERR_NOT_SUPPORTED)
     {
         // Only supported on specific GPU's
@@ -1644,44 +1666,15 @@ kmigmgrLoadStaticInfo_KERNEL
         NV_CHECK_OK_OR_GOTO(status, LEVEL_ERROR, status, failed);
     }
 
+    NV_CHECK_OK_OR_GOTO(status, LEVEL_ERROR, batch[3].status, failed);
+    NV_CHECK_OK_OR_GOTO(status, LEVEL_ERROR, batch[4].status, failed);
+
     //
     // Populate static GPU instance memory config which will be used to manage
     // GPU instance memory
     //
     NV_ASSERT_OK_OR_RETURN(kmemsysPopulateMIGGPUInstanceMemConfig_HAL(pGpu, pKernelMemorySystem));
 
-    pPrivate->staticInfo.pCIProfiles = portMemAllocNonPaged(sizeof(*pPrivate->staticInfo.pCIProfiles));
-    NV_CHECK_OR_ELSE(LEVEL_ERROR,
-        pPrivate->staticInfo.pCIProfiles != NULL,
-        status = NV_ERR_NO_MEMORY;
-        goto failed;);
-    portMemSet(pPrivate->staticInfo.pCIProfiles, 0x0, sizeof(*pPrivate->staticInfo.pCIProfiles));
-
-    NV_CHECK_OK_OR_GOTO(status, LEVEL_ERROR,
-        pRmApi->Control(pRmApi,
-                        pGpu->hInternalClient,
-                        pGpu->hInternalSubdevice,
-                        NV2080_CTRL_CMD_INTERNAL_STATIC_KMIGMGR_GET_COMPUTE_PROFILES,
-                        pPrivate->staticInfo.pCIProfiles,
-                        sizeof(*pPrivate->staticInfo.pCIProfiles)),
-        failed);
-
-    pPrivate->staticInfo.pProfiles = portMemAllocNonPaged(sizeof(*pPrivate->staticInfo.pProfiles));
-    NV_CHECK_OR_ELSE(LEVEL_ERROR,
-        pPrivate->staticInfo.pProfiles != NULL,
-        status = NV_ERR_NO_MEMORY;
-        goto failed;);
-    portMemSet(pPrivate->staticInfo.pProfiles, 0x0, sizeof(*pPrivate->staticInfo.pProfiles));
-
-    NV_CHECK_OK_OR_GOTO(status, LEVEL_ERROR,
-        pRmApi->Control(pRmApi,
-                        pGpu->hInternalClient,
-                        pGpu->hInternalSubdevice,
-                        NV2080_CTRL_CMD_INTERNAL_STATIC_KMIGMGR_GET_PROFILES,
-                        pPrivate->staticInfo.pProfiles,
-                        sizeof(*pPrivate->staticInfo.pProfiles)),
-        failed);
-
     if (IS_GSP_CLIENT(pGpu))
     {
         NV_CHECK(LEVEL_ERROR, kmigmgrEnableAllLCEs(pGpu, pKernelMIGManager, NV_FALSE) == NV_OK);
@@ -2226,6 +2219,7 @@ kmigmgrSetSwizzIdInUse_IMPL
     }
 
     pKernelMIGManager->swizzIdInUseMask |= mask;
+    rmapiControlCacheInvalidate(pGpu->gpuInstance, RMAPI_CONTROL_CACHE_DEP_MIG_CONFIG);
 
     return NV_OK;
 }
@@ -2257,6 +2251,7 @@ kmigmgrClearSwizzIdInUse_IMPL
     }
 
     pKernelMIGManager->swizzIdInUseMask &= ~mask;
+    rmapiControlCacheInvalidate(pGpu->gpuInstance, RMAPI_CONTROL_CACHE_DEP_MIG_CONFIG);
 
     return NV_OK;
 }
@@ -3939,6 +3934,7 @@ kmigmgrSetPartitioningMode_IMPL
     pKernelMIGManager->bMIGEnabled = (params.smcMode == NV2080_CTRL_GPU_INFO_GPU_SMC_MODE_ENABLED);
 
     gpumgrCacheSetMIGEnabled(pGpu, pKernelMIGManager->bMIGEnabled);
+    rmapiControlCacheInvalidate(pGpu->gpuInstance, RMAPI_CONTROL_CACHE_DEP_MIG_CONFIG);
 
     // MIG Mode might not have been enabled yet, so load static info if enabled
     if (IS_MIG_ENABLED(pGpu))
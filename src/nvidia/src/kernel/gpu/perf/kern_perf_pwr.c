@@ -244,6 +244,8 @@ kperfPerfSetPowerstate_KERNEL
         NV_PRINTF(LEVEL_ERROR, "NV2080_CTRL_CMD_PERF_SET_POWERSTATE RPC failed\n");
     }
 
+    rmapiControlCacheInvalidate(pGpu->gpuInstance, RMAPI_CONTROL_CACHE_DEP_POWER_SOURCE);
+
     // If callback was registered, update platform with the current Auxpower state(Dx)
     _kperfSendPostPowerStateCallback(pGpu, pKernelPerf);
 
@@ -457,13 +457,53 @@ serverResLock_Prologue
             pLockInfo->gpuMask = gpuMask | gpumgrGetGpuMask(pParentGpu) |
                                  _resGetBackRefGpusMask(pLockInfo->pResRefToBackRef);
 
+            //
+            // With the per-GPU API lock, calls promoted from the RW to the RO
+            // API lock are serialized against other such calls on the same GPUs
+            // here. This keeps them exclusive even across paths that drop and
+            // reacquire the GPU lock, as the RW API lock did before. Calls that
+            // take the RO API lock anyway do not take per-GPU API locks.
+            //
+            // Per-GPU API locks are ordered after the API lock and before the
+            // GPU locks, so they must be taken before rmGpuGroupLockAcquire.
+            // Threads that already own GPU locks run under the locks of the
+            // call that acquired them and do not take per-GPU API locks.
+            //
+            if ((pLockInfo->flags & RM_LOCK_FLAGS_GPU_API_LOCK) &&
+                !(pLockInfo->state & RM_LOCK_STATES_GPU_API_LOCK_ACQUIRED) &&
+                (rmGpuLocksGetOwnedMask() == 0))
+            {
+                status = rmapiLockAcquireGpus(pLockInfo->gpuMask, RMAPI_LOCK_FLAGS_WRITE);
+                if (status == NV_OK)
+                {
+                    *pReleaseFlags |= RM_LOCK_RELEASE_GPU_API_LOCK;
+                    pLockInfo->state |= RM_LOCK_STATES_GPU_API_LOCK_ACQUIRED;
+                }
+                else if (status == NV_WARN_NOTHING_TO_DO)
+                {
+                    status = NV_OK;
+                }
+                else
+                {
+                    goto done;
+                }
+            }
+
             status = rmGpuGroupLockAcquire(0,
                                            GPU_LOCK_GRP_MASK,
                                            GPUS_LOCK_FLAGS_NONE,
                                            RM_LOCK_MODULES_CLIENT,
                                            &pLockInfo->gpuMask);
             if (status != NV_OK)
+            {
+                if (*pReleaseFlags & RM_LOCK_RELEASE_GPU_API_LOCK)
+                {
+                    rmapiLockReleaseGpus();
+                    pLockInfo->state &= ~RM_LOCK_STATES_GPU_API_LOCK_ACQUIRED;
+                    *pReleaseFlags &= ~RM_LOCK_RELEASE_GPU_API_LOCK;
+                }
                 goto done;
+            }
 
             *pReleaseFlags |= RM_LOCK_RELEASE_GPU_GROUP_LOCK;
             pLockInfo->state |= RM_LOCK_STATES_GPU_GROUP_LOCK_ACQUIRED;
@@ -1066,6 +1106,13 @@ serverResLock_Epilogue
         pLockInfo->state &= ~RM_LOCK_STATES_GPUS_LOCK_ACQUIRED;
         *pReleaseFlags &= ~RM_LOCK_RELEASE_GPUS_LOCK;
     }
+
+    if (*pReleaseFlags & RM_LOCK_RELEASE_GPU_API_LOCK)
+    {
+        rmapiLockReleaseGpus();
+        pLockInfo->state &= ~RM_LOCK_STATES_GPU_API_LOCK_ACQUIRED;
+        *pReleaseFlags &= ~RM_LOCK_RELEASE_GPU_API_LOCK;
+    }
 }
 
 NV_STATUS
@@ -1717,6 +1764,23 @@ serverAllocResourceLookupLockFlags
             return NV_OK;
         }
 
+        //
+        // Classes that opted in are serialized by the per-GPU API lock in
+        // serverResLock_Prologue instead of the RW API lock, if enabled. Only
+        // allocations promoted from the RW API lock take the per-GPU API lock.
+        //
+        if ((*pAccess == LOCK_ACCESS_WRITE) &&
+            rmapiLockIsPerGpuEnabled() &&
+            ((pResDesc->flags & (RS_FLAGS_ACQUIRE_PER_GPU_API_LOCK_ON_ALLOC |
+                                 RS_FLAGS_ACQUIRE_GPU_GROUP_LOCK_ON_ALLOC |
+                                 RS_FLAGS_ACQUIRE_GPUS_LOCK_ON_ALLOC |
+                                 RS_FLAGS_DUAL_CLIENT_LOCK)) ==
+             (RS_FLAGS_ACQUIRE_PER_GPU_API_LOCK_ON_ALLOC | RS_FLAGS_ACQUIRE_GPU_GROUP_LOCK_ON_ALLOC)))
+        {
+            *pAccess = LOCK_ACCESS_READ;
+            pParams->pLockInfo->flags |= RM_LOCK_FLAGS_GPU_API_LOCK;
+        }
+
         return NV_OK;
     }
 
@@ -295,11 +295,12 @@ serverControlApiCopyOut
 
     if ((pCookie->apiCopyFlags & RMCTRL_API_COPY_FLAGS_SET_CONTROL_CACHE) && rmStatus == NV_OK)
     {
-        rmapiControlCacheSet(pRmCtrlParams->hClient,
-                             pRmCtrlParams->hObject,
-                             pRmCtrlParams->cmd,
-                             pRmCtrlParams->pParams,
-                             pRmCtrlParams->paramsSize);
+        rmapiControlCacheSetSinceInvalidateSeq(pRmCtrlParams->hClient,
+                                               pRmCtrlParams->hObject,
+                                               pRmCtrlParams->cmd,
+                                               pRmCtrlParams->pParams,
+                                               pRmCtrlParams->paramsSize,
+                                               pCookie->cacheInvalidateSeq);
     }
 
     pParamCopy = &pCookie->paramCopy;
@@ -353,6 +354,7 @@ _rmapiRmControl(NvHandle hClient, NvHandle hObject, NvU32 cmd, NvP64 pUserParams
     NV_STATUS  rmStatus = NV_OK;
     RS_LOCK_INFO        lockInfo = {0};
     NvU32 ctrlFlags = 0;
+    NvU32 ctrlCacheFlags = 0;
     NvU32 ctrlAccessRight = 0;
     NvU32 ctrlParamsSize = 0;
     NV_STATUS getCtrlInfoStatus;
@@ -553,7 +555,10 @@ _rmapiRmControl(NvHandle hClient, NvHandle hObject, NvU32 cmd, NvP64 pUserParams
 
         if (getCtrlInfoStatus == NV_OK)
         {
-            if (rmapiControlIsCacheable(ctrlFlags, ctrlAccessRight, NV_FALSE))
+            // The cache also honors the flags declared in its descriptor table
+            ctrlCacheFlags = ctrlFlags | rmapiControlCacheGetDeclaredFlags(cmd);
+
+            if (rmapiControlIsCacheable(ctrlCacheFlags, ctrlAccessRight, NV_FALSE))
             {
                 rmCtrlParams.pCookie->apiCopyFlags |= RMCTRL_API_COPY_FLAGS_FORCE_SKIP_COPYOUT_ON_ERROR;
 
@@ -582,9 +587,10 @@ _rmapiRmControl(NvHandle hClient, NvHandle hObject, NvU32 cmd, NvP64 pUserParams
                     // reset cookie if cache get failed
                     portMemSet(rmCtrlParams.pCookie, 0, sizeof(RS_CONTROL_COOKIE));
                     rmCtrlParams.pCookie->apiCopyFlags |= RMCTRL_API_COPY_FLAGS_SET_CONTROL_CACHE;
+                    rmCtrlParams.pCookie->cacheInvalidateSeq = rmapiControlCacheGetInvalidateSeq();
 
                     // re-initialize the flag if it's cleaned
-                    if (ctrlFlags & RMCTRL_FLAGS_CACHEABLE)
+                    if (ctrlCacheFlags & RMCTRL_FLAGS_CACHEABLE)
                         rmCtrlParams.pCookie->apiCopyFlags |= RMCTRL_API_COPY_FLAGS_SKIP_COPYIN_ZERO_BUFFER;
                 }
             }
@@ -959,6 +965,24 @@ serverControlLookupLockFlags
             *pAccess = LOCK_ACCESS_WRITE;
         }
 
+        //
+        // With the per-GPU API lock, controls that opted in are serialized per
+        // GPU in serverResLock_Prologue rather than by the RW API lock. Only
+        // calls promoted from the RW API lock take the per-GPU API lock.
+        //
+        if ((*pAccess == LOCK_ACCESS_WRITE) &&
+            rmapiLockIsPerGpuEnabled() &&
+            ((controlFlags & (RMCTRL_FLAGS_PER_GPU_API_LOCK |
+                              RMCTRL_FLAGS_GPU_LOCK_DEVICE_ONLY |
+                              RMCTRL_FLAGS_NO_GPUS_LOCK |
+                              RMCTRL_FLAGS_ALL_CLIENT_LOCK)) ==
+             (RMCTRL_FLAGS_PER_GPU_API_LOCK | RMCTRL_FLAGS_GPU_LOCK_DEVICE_ONLY)) &&
+            ((pRmCtrlParams->flags & (NVOS54_FLAGS_IRQL_RAISED | NVOS54_FLAGS_LOCK_BYPASS)) == 0))
+        {
+            *pAccess = LOCK_ACCESS_READ;
+            pRmCtrlParams->pLockInfo->flags |= RM_LOCK_FLAGS_GPU_API_LOCK;
+        }
+
         return NV_OK;
     }
 
@@ -1040,6 +1064,31 @@ rmapiControl
                                       paramsSize, 0, &pRmApi->defaultSecInfo);
 }
 
+NV_STATUS
+rmapiControlBatch
+(
+    RM_API                    *pRmApi,
+    NvHandle                   hClient,
+    RMAPI_CONTROL_BATCH_ENTRY *pEntries,
+    NvU32                      numEntries
+)
+{
+    NV_STATUS status = NV_OK;
+    NvU32 i;
+
+    NV_ASSERT_OR_RETURN((pEntries != NULL) || (numEntries == 0), NV_ERR_INVALID_ARGUMENT);
+
+    for (i = 0; i < numEntries; i++)
+    {
+        pEntries[i].status = pRmApi->Control(pRmApi, hClient, pEntries[i].hObject, pEntries[i].cmd,
+                                             pEntries[i].pParams, pEntries[i].paramsSize);
+        if (status == NV_OK)
+            status = pEntries[i].status;
+    }
+
+    return status;
+}
+
 NV_STATUS
 rmapiControlWithSecInfo
 (
@@ -40,6 +40,7 @@
 #include "g_finn_rm_api.h"
 
 static NvS32 g_LockStressCounter = 0;
+static NvS32 g_GpuApiLockStressCounter[NV_MAX_DEVICES] = {0};
 
 NV_STATUS
 lockStressObjConstruct_IMPL
@@ -178,6 +179,7 @@ lockStressObjCtrlCmdResetLockStressState_IMPL
     g_LockStressCounter = 0;
 
     pGpu->lockStressCounter = 0;
+    g_GpuApiLockStressCounter[pGpu->gpuInstance] = 0;
     pRmClient->lockStressCounter = 0;
     pRmInternalClient->lockStressCounter = 0;
 
@@ -594,6 +596,58 @@ lockStressObjCtrlCmdGetLockStressCounters_IMPL
     pParams->gpuLockStressCounter = pGpu->lockStressCounter;
     pParams->clientLockStressCounter = pRmClient->lockStressCounter;
     pParams->internalClientLockStressCounter = pRmInternalClient->lockStressCounter;
+    pParams->gpuApiLockStressCounter = g_GpuApiLockStressCounter[pGpu->gpuInstance];
+
+    return NV_OK;
+}
+
+NV_STATUS
+lockStressObjCtrlCmdPerformLockStressPerGpuApiLock_IMPL
+(
+    LockStressObject *pResource,
+    NV0100_CTRL_PERFORM_LOCK_STRESS_PER_GPU_API_LOCK_PARAMS *pParams
+)
+{
+    OBJGPU *pGpu = GPU_RES_GET_GPU(pResource);
+    NvU8 rand;
+
+    // Perform random increments/decrements but report what we did back to caller
+    NV_CHECK_OK_OR_RETURN(LEVEL_SILENT, osGetRandomBytes(&rand, 1));
+
+    //
+    // This API only takes the device GPU lock. The per-GPU API lock stress counter
+    // is serialized either by the RW API lock or, when the per-GPU API lock is
+    // enabled, by the RW per-GPU API lock of this GPU, so callers on different
+    // GPUs only contend in the latter case.
+    //
+    NV_ASSERT_OR_RETURN(rmapiLockIsGpuWriteOwner(pGpu->gpuInstance), NV_ERR_INVALID_LOCK_STATE);
+
+    pParams->action = rand & DRF_SHIFTMASK(NV0100_CTRL_GPU_API_LOCK_STRESS_COUNTER_INCREMENT);
+    pParams->bPerGpuApiLock = !rmapiLockIsWriteOwner();
+
+    if (DRF_VAL(0100_CTRL, _GPU_API, _LOCK_STRESS_COUNTER_INCREMENT, pParams->action) != 0)
+        g_GpuApiLockStressCounter[pGpu->gpuInstance]++;
+    else
+        g_GpuApiLockStressCounter[pGpu->gpuInstance]--;
+
+    return NV_OK;
+}
+
+NV_STATUS
+lockStressObjCtrlCmdGetPerGpuApiLockStats_IMPL
+(
+    LockStressObject *pResource,
+    NV0100_CTRL_GET_PER_GPU_API_LOCK_STATS_PARAMS *pParams
+)
+{
+    OBJGPU *pGpu = GPU_RES_GET_GPU(pResource);
+
+    pParams->bEnabled = rmapiLockIsPerGpuEnabled();
+
+    rmapiLockGetGpuStats(pGpu->gpuInstance,
+                         &pParams->acquireCount,
+                         &pParams->contentionCount,
+                         &pParams->waitTimeNs);
 
     return NV_OK;
 }
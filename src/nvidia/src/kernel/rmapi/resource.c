@@ -308,4 +308,11 @@ rmresControl_Epilogue_IMPL
     RS_RES_CONTROL_PARAMS_INTERNAL *pParams
 )
 {
+    //
+    // Drop the cached state the control may have changed while its locks are
+    // still held, so that no other caller can observe the new state while
+    // the stale entries are still cached. The status of the control is not
+    // known here; dropping entries is always safe.
+    //
+    rmapiControlCacheInvalidateForControl(pParams->hClient, pParams->hObject, pParams->cmd);
 }
@@ -99,4 +99,13 @@
  */
 #define RS_FLAGS_ACQUIRE_RELAXED_GPUS_LOCK_ON_DUP NVBIT(18)
 
+/**
+ * Acquire the RO API lock and the per-GPU API lock for allocation when
+ * NV_REG_STR_RM_PER_GPU_API_LOCK is set, default is RW API lock.
+ *
+ *  Must be combined with RS_FLAGS_ACQUIRE_GPU_GROUP_LOCK_ON_ALLOC, and the class
+ *  must not depend on state of other GPUs during allocation.
+ */
+#define RS_FLAGS_ACQUIRE_PER_GPU_API_LOCK_ON_ALLOC NVBIT(19)
+
 #endif // _RESOURCE_DESC_FLAGS_H_
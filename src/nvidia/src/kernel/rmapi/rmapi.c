@@ -38,6 +38,19 @@
 #include "resource_desc.h"
 #include "ctrl/ctrl0000/ctrl0000system.h"
 
+//
+// Per-GPU partition of the API lock, only taken while holding the global API
+// lock for READ. threadId is only valid while held for WRITE.
+//
+typedef struct
+{
+    PORT_RWLOCK *       pLock;
+    NvU64               threadId;
+    PORT_ATOMIC NvU64   acquireCount;
+    PORT_ATOMIC NvU64   contentionCount;
+    PORT_ATOMIC NvU64   totalWaitTime;
+} RMAPI_GPU_LOCK;
+
 typedef struct
 {
     PORT_RWLOCK *       pLock;
@@ -50,6 +63,9 @@ typedef struct
     PORT_ATOMIC NvU64   totalWaitTime;
     PORT_ATOMIC NvU64   totalRwHoldTime;
     PORT_ATOMIC NvU64   totalRoHoldTime;
+    NvBool              bPerGpu;
+    NvU64               gpuTlsEntryId;
+    RMAPI_GPU_LOCK      gpuLocks[NV_MAX_DEVICES];
 } RMAPI_LOCK;
 
 RsServer          g_resServ;
@@ -193,6 +209,7 @@ _rmapiInitInterface
 
     pRmApi->Control = rmapiControl;
     pRmApi->ControlWithSecInfo = pRmApi->bTlsInternal ? rmapiControlWithSecInfo : rmapiControlWithSecInfoTls;
+    pRmApi->ControlBatch = rmapiControlBatch;
 
     pRmApi->DupObject = rmapiDupObject;
     pRmApi->DupObjectWithSecInfo = pRmApi->bTlsInternal ? rmapiDupObjectWithSecInfo : rmapiDupObjectWithSecInfoTls;
@@ -538,12 +555,58 @@ _rmapiLockAlloc(void)
 
     g_RmApiLock.tlsEntryId = tlsEntryAlloc();
 
+    if ((osReadRegistryDword(NULL,
+                            NV_REG_STR_RM_PER_GPU_API_LOCK,
+                            &val) == NV_OK) &&
+        (val == NV_REG_STR_RM_PER_GPU_API_LOCK_ENABLE))
+    {
+        NvU32 i;
+
+        for (i = 0; i < NV_MAX_DEVICES; i++)
+        {
+            g_RmApiLock.gpuLocks[i].threadId = ~((NvU64)(0));
+            g_RmApiLock.gpuLocks[i].pLock =
+                portSyncRwLockCreate(portMemAllocatorGetGlobalNonPaged());
+            if (g_RmApiLock.gpuLocks[i].pLock == NULL)
+                break;
+        }
+
+        if (i == NV_MAX_DEVICES)
+        {
+            g_RmApiLock.gpuTlsEntryId = tlsEntryAlloc();
+            g_RmApiLock.bPerGpu = NV_TRUE;
+            NV_PRINTF(LEVEL_INFO, "Per-GPU API lock enabled\n");
+        }
+        else
+        {
+            // Fall back to the global API lock only
+            while (i-- > 0)
+            {
+                portSyncRwLockDestroy(g_RmApiLock.gpuLocks[i].pLock);
+                g_RmApiLock.gpuLocks[i].pLock = NULL;
+            }
+            NV_PRINTF(LEVEL_ERROR, "Cannot allocate per-GPU API locks\n");
+        }
+    }
+
     return NV_OK;
 }
 
 static void
 _rmapiLockFree(void)
 {
+    NvU32 i;
+
+    for (i = 0; i < NV_MAX_DEVICES; i++)
+    {
+        if (g_RmApiLock.gpuLocks[i].pLock != NULL)
+        {
+            portSyncRwLockDestroy(g_RmApiLock.gpuLocks[i].pLock);
+            g_RmApiLock.gpuLocks[i].pLock = NULL;
+        }
+    }
+    g_RmApiLock.bPerGpu = NV_FALSE;
+
     portSyncRwLockDestroy(g_RmApiLock.pLock);
 }
 
@@ -710,6 +773,9 @@ rmapiLockRelease(void)
     NvU64 timestamp;
     NvU64 startTime = 0;
 
+    // Per-GPU API locks must be released before the API lock
+    NV_ASSERT(!g_RmApiLock.bPerGpu || (tlsEntryGet(g_RmApiLock.gpuTlsEntryId) == 0));
+
     // Fetch start of hold time from TLS if measuring lock times
     if (pSys->getProperty(pSys, PDB_PROP_SYS_RM_LOCK_TIME_COLLECT))
         startTime = (NvU64) tlsEntryGet(g_RmApiLock.tlsEntryId);
@@ -781,6 +847,232 @@ rmapiLockGetTimes(NV0000_CTRL_SYSTEM_GET_LOCK_TIMES_PARAMS *pParams)
     pParams->holdRwApiLock = g_RmApiLock.totalRwHoldTime;
 }
 
+NvBool
+rmapiLockIsPerGpuEnabled(void)
+{
+    return g_RmApiLock.bPerGpu;
+}
+
+static void
+_rmapiLockReleaseGpuMask(NvU32 gpuMask)
+{
+    NvU64 threadId = portThreadGetCurrentThreadId();
+    NvU32 gpuInstance;
+
+    FOR_EACH_INDEX_IN_MASK(32, gpuInstance, gpuMask)
+    {
+        RMAPI_GPU_LOCK *pGpuLock = &g_RmApiLock.gpuLocks[gpuInstance];
+
+        if (pGpuLock->threadId == threadId)
+        {
+            pGpuLock->threadId = ~0ull;
+            portSyncRwLockReleaseWrite(pGpuLock->pLock);
+        }
+        else
+        {
+            portSyncRwLockReleaseRead(pGpuLock->pLock);
+        }
+    }
+    FOR_EACH_INDEX_IN_MASK_END;
+}
+
+//
+// Acquire the per-GPU API locks in gpuMask in ascending GPU instance order.
+// On failure, *pAcquiredMask holds the locks that were acquired.
+//
+static NV_STATUS
+_rmapiLockAcquireGpuMask
+(
+    NvU32  gpuMask,
+    NvU32  flags,
+    NvU32 *pAcquiredMask
+)
+{
+    OBJSYS *pSys = SYS_GET_INSTANCE();
+    NvU64   threadId = portThreadGetCurrentThreadId();
+    NvU32   gpuInstance;
+
+    *pAcquiredMask = 0;
+
+    FOR_EACH_INDEX_IN_MASK(32, gpuInstance, gpuMask)
+    {
+        RMAPI_GPU_LOCK *pGpuLock = &g_RmApiLock.gpuLocks[gpuInstance];
+        NvU64 startWaitTime = 0;
+        NvBool bAcquired;
+
+        if (pSys->getProperty(pSys, PDB_PROP_SYS_RM_LOCK_TIME_COLLECT))
+            startWaitTime = osGetMonotonicTimeNs();
+
+        if (flags & RMAPI_LOCK_FLAGS_READ)
+            bAcquired = portSyncRwLockAcquireReadConditional(pGpuLock->pLock);
+        else
+            bAcquired = portSyncRwLockAcquireWriteConditional(pGpuLock->pLock);
+
+        if (!bAcquired)
+        {
+            if (flags & RMAPI_LOCK_FLAGS_COND_ACQUIRE)
+                return NV_ERR_TIMEOUT_RETRY;
+
+            portAtomicExIncrementU64(&pGpuLock->contentionCount);
+
+            if (flags & RMAPI_LOCK_FLAGS_READ)
+                portSyncRwLockAcquireRead(pGpuLock->pLock);
+            else
+                portSyncRwLockAcquireWrite(pGpuLock->pLock);
+        }
+
+        if (!(flags & RMAPI_LOCK_FLAGS_READ))
+            pGpuLock->threadId = threadId;
+
+        portAtomicExIncrementU64(&pGpuLock->acquireCount);
+
+        if (pSys->getProperty(pSys, PDB_PROP_SYS_RM_LOCK_TIME_COLLECT))
+            portAtomicExAddU64(&pGpuLock->totalWaitTime, osGetMonotonicTimeNs() - startWaitTime);
+
+        *pAcquiredMask |= NVBIT(gpuInstance);
+    }
+    FOR_EACH_INDEX_IN_MASK_END;
+
+    return NV_OK;
+}
+
+//
+// Lock order: API lock, then per-GPU API locks in ascending GPU instance
+// order, then GPU locks. Only the outermost RM API call takes per-GPU API
+// locks; nested calls run under the locks of the outermost call.
+//
+NV_STATUS
+rmapiLockAcquireGpus
+(
+    NvU32 gpuMask,
+    NvU32 flags
+)
+{
+    NV_STATUS status;
+    NvU32     heldMask;
+    NvU32     acquiredMask;
+    NvP64    *pEntry;
+
+    if (!g_RmApiLock.bPerGpu)
+        return NV_WARN_NOTHING_TO_DO;
+
+    NV_ASSERT_OR_RETURN(gpuMask != 0, NV_ERR_INVALID_ARGUMENT);
+    NV_ASSERT_OR_RETURN(rmapiLockIsOwner(), NV_ERR_INVALID_LOCK_STATE);
+
+    // The API lock held for WRITE already excludes every other API lock owner
+    if (rmapiLockIsWriteOwner())
+        return NV_WARN_NOTHING_TO_DO;
+
+    heldMask = (NvU32)(NvU64)tlsEntryGet(g_RmApiLock.gpuTlsEntryId);
+    if (heldMask != 0)
+    {
+        gpuMask &= ~heldMask;
+        if (gpuMask == 0)
+            return NV_WARN_NOTHING_TO_DO;
+
+        //
+        // A nested call needs GPUs that the outermost call did not lock. They
+        // would be taken out of order, possibly under GPU locks, so only try
+        // to acquire them. They are released with the outermost call's locks.
+        //
+        status = _rmapiLockAcquireGpuMask(gpuMask, flags | RMAPI_LOCK_FLAGS_COND_ACQUIRE, &acquiredMask);
+        if (status != NV_OK)
+        {
+            NV_PRINTF(LEVEL_WARNING,
+                      "Cannot extend per-GPU API locks 0x%x with 0x%x in a nested call\n",
+                      heldMask, gpuMask);
+            _rmapiLockReleaseGpuMask(acquiredMask);
+            return NV_ERR_INVALID_LOCK_STATE;
+        }
+
+        tlsEntrySet(g_RmApiLock.gpuTlsEntryId, (NvP64)(NvUPtr)(heldMask | acquiredMask));
+        return NV_WARN_NOTHING_TO_DO;
+    }
+
+    // Ensure that GPU locks are NEVER acquired before the per-GPU API locks
+    NV_ASSERT_OR_RETURN(rmGpuLocksGetOwnedMask() == 0, NV_ERR_INVALID_LOCK_STATE);
+
+    status = _rmapiLockAcquireGpuMask(gpuMask, flags, &acquiredMask);
+
+    if (status == NV_OK)
+    {
+        pEntry = tlsEntryAcquire(g_RmApiLock.gpuTlsEntryId);
+        if (pEntry != NULL)
+            *(NvU64 *)pEntry = acquiredMask;
+        else
+            status = NV_ERR_INSUFFICIENT_RESOURCES;
+    }
+
+    if (status != NV_OK)
+        _rmapiLockReleaseGpuMask(acquiredMask);
+
+    return status;
+}
+
+void
+rmapiLockReleaseGpus(void)
+{
+    NvU32 heldMask;
+
+    if (!g_RmApiLock.bPerGpu)
+        return;
+
+    heldMask = (NvU32)(NvU64)tlsEntryGet(g_RmApiLock.gpuTlsEntryId);
+    if (heldMask == 0)
+        return;
+
+    // GPU locks must be released before the per-GPU API locks
+    NV_ASSERT((rmGpuLocksGetOwnedMask() & heldMask) == 0);
+
+    _rmapiLockReleaseGpuMask(heldMask);
+
+    tlsEntryRelease(g_RmApiLock.gpuTlsEntryId);
+}
+
+NvBool
+rmapiLockIsGpuWriteOwner(NvU32 gpuInstance)
+{
+    NvU64 threadId = portThreadGetCurrentThreadId();
+    NvU32 heldMask;
+
+    if (rmapiLockIsWriteOwner())
+        return NV_TRUE;
+
+    if (!g_RmApiLock.bPerGpu || (gpuInstance >= NV_MAX_DEVICES))
+        return NV_FALSE;
+
+    heldMask = (NvU32)(NvU64)tlsEntryGet(g_RmApiLock.gpuTlsEntryId);
+
+    return rmapiLockIsOwner() &&
+           ((heldMask & NVBIT(gpuInstance)) != 0) &&
+           (g_RmApiLock.gpuLocks[gpuInstance].threadId == threadId);
+}
+
+void
+rmapiLockGetGpuStats
+(
+    NvU32  gpuInstance,
+    NvU64 *pAcquireCount,
+    NvU64 *pContentionCount,
+    NvU64 *pWaitTime
+)
+{
+    RMAPI_GPU_LOCK *pGpuLock;
+
+    *pAcquireCount    = 0;
+    *pContentionCount = 0;
+    *pWaitTime        = 0;
+
+    if (!g_RmApiLock.bPerGpu || (gpuInstance >= NV_MAX_DEVICES))
+        return;
+
+    pGpuLock = &g_RmApiLock.gpuLocks[gpuInstance];
+
+    *pAcquireCount    = portAtomicExAddU64(&pGpuLock->acquireCount, 0);
+    *pContentionCount = portAtomicExAddU64(&pGpuLock->contentionCount, 0);
+    *pWaitTime        = portAtomicExAddU64(&pGpuLock->totalWaitTime, 0);
+}
+
 //
 // Indicates current thread is in the RTD3 PM path (rm_transition_dynamic_power) which
 // means that certain locking asserts/checks must be skipped due to inability to acquire
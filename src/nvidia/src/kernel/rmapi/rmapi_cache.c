@@ -38,7 +38,9 @@
 #include "ctrl/ctrl2080/ctrl2080bus.h"
 #include "ctrl/ctrl2080/ctrl2080bios.h"
 #include "ctrl/ctrl2080/ctrl2080ce.h"
+#include "ctrl/ctrl2080/ctrl2080perf.h"
 #include "gpu/gpu.h"
+#include "gpu_mgr/gpu_mgr.h"
 
 typedef struct
 {
@@ -109,11 +111,77 @@ static NvU64 _getGpuAttrFromGpu(OBJGPU *pGpu)
     return gpuAttr;
 }
 
+//
+// Lock-free read index for RMCTRL_FLAGS_CACHEABLE entries.
+//
+// Plain cacheable controls are queried at high rates by monitoring tools, so
+// their lookups avoid the cache rw lock altogether. An object is resolved to
+// its GPU through a direct-mapped object index, and (gpuInst, cmd) is then
+// resolved through a direct-mapped entry index. Each slot carries a sequence
+// count: it is odd while the slot is being written and readers retry (or fall
+// back to the locked path) if it changed across their copy.
+//
+// All index updates are made with the cache lock held exclusively, so each
+// slot has a single writer. The maps above remain authoritative; a hash
+// collision simply evicts the slot and the evicted entry is served through
+// the locked path until it is set again.
+//
+// Entry slots are allocated on first use and only freed by
+// rmapiControlCacheFree(), so a racing reader may observe a stale sequence
+// count but never freed memory.
+//
+#define CACHE_INDEX_ENTRIES             1024
+#define CACHE_INDEX_OBJECTS             1024
+#define CACHE_INDEX_MAX_PARAM_SIZE      4096
+#define CACHE_INDEX_READ_RETRIES        4
+#define CACHE_INDEX_STACK_BOUNCE_SIZE   256
+#define CACHE_STATS_SHARDS              16
+
+ct_assert(ONEBITSET(CACHE_INDEX_ENTRIES));
+ct_assert(ONEBITSET(CACHE_INDEX_OBJECTS));
+ct_assert(ONEBITSET(CACHE_STATS_SHARDS));
+
+typedef struct
+{
+    volatile NvU32 seq;
+    volatile NvU32 gpuInst;
+    volatile NvU32 cmd;
+    volatile NvU32 rmctrlFlags;
+    volatile NvU32 paramSize;   // 0 if the slot is empty
+    NvU32 capacity;
+    NvU8 *params;
+} RmapiControlCacheIndexEntry;
+
+typedef struct
+{
+    volatile NvU32 seq;
+    volatile NvU64 key;         // 0 if the slot is empty
+    volatile NvU64 gpuAttr;
+} RmapiControlCacheIndexObject;
+
+//
+// Hit/miss counters are sharded by CPU so that the lookup path does not
+// bounce a single cache line between all the querying processes.
+//
+typedef struct
+{
+    volatile NvU64 hits;
+    volatile NvU64 misses;
+    volatile NvU64 lockFreeHits;
+    volatile NvU64 lockFreeRetries;
+    NvU64 padding[4];
+} RmapiControlCacheStatsShard;
+
 static struct {
     GpusControlCache gpusControlCache;
     ObjectToGpuAttrMap objectToGpuAttrMap;
     NvU32 mode;
     PORT_RWLOCK *pLock;
+    RmapiControlCacheIndexEntry * volatile pIndexEntries[CACHE_INDEX_ENTRIES];
+    RmapiControlCacheIndexObject indexObjects[CACHE_INDEX_OBJECTS];
+    RmapiControlCacheStatsShard stats[CACHE_STATS_SHARDS];
+    volatile NvU64 invalidations;
+    volatile NvU32 invalidateSeq;   // bumped by each dependency invalidation
 } RmapiControlCache;
 
 enum CACHE_LOCK_TYPE
@@ -145,6 +213,430 @@ NvBool _cacheIsDisabled(void)
                 NV0000_CTRL_SYSTEM_RMCTRL_CACHE_MODE_CTRL_MODE_DISABLE);
 }
 
+static inline RmapiControlCacheStatsShard *_cacheStatsShard(void)
+{
+    return &RmapiControlCache.stats[osGetCurrentProcessorNumber() & (CACHE_STATS_SHARDS - 1)];
+}
+
+static void _cacheRecordLookup(NV_STATUS status)
+{
+    RmapiControlCacheStatsShard *pShard = _cacheStatsShard();
+
+    if (status == NV_OK)
+        portAtomicExIncrementU64(&pShard->hits);
+    else
+        portAtomicExIncrementU64(&pShard->misses);
+}
+
+static inline NvU32 _indexHash(NvU64 key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (NvU32)key;
+}
+
+static inline NvU32 _indexEntrySlot(NvU32 gpuInst, NvU32 cmd)
+{
+    return _indexHash(((NvU64)gpuInst << 32) | cmd) & (CACHE_INDEX_ENTRIES - 1);
+}
+
+static inline NvU32 _indexObjectSlot(NvU64 key)
+{
+    return _indexHash(key) & (CACHE_INDEX_OBJECTS - 1);
+}
+
+// Need to hold rmapi control cache write lock
+static inline void _indexWriteBegin(volatile NvU32 *pSeq)
+{
+    portAtomicIncrementU32(pSeq);
+    portAtomicMemoryFenceStore();
+}
+
+// Need to hold rmapi control cache write lock
+static inline void _indexWriteEnd(volatile NvU32 *pSeq)
+{
+    portAtomicMemoryFenceStore();
+    portAtomicIncrementU32(pSeq);
+}
+
+// Need to hold rmapi control cache write lock
+static void _indexObjectSet(NvU64 key, NvU64 gpuAttr)
+{
+    RmapiControlCacheIndexObject *pSlot = &RmapiControlCache.indexObjects[_indexObjectSlot(key)];
+
+    _indexWriteBegin(&pSlot->seq);
+    pSlot->key = key;
+    pSlot->gpuAttr = gpuAttr;
+    _indexWriteEnd(&pSlot->seq);
+}
+
+// Need to hold rmapi control cache write lock
+static void _indexObjectClear(NvU64 key)
+{
+    RmapiControlCacheIndexObject *pSlot = &RmapiControlCache.indexObjects[_indexObjectSlot(key)];
+
+    if (pSlot->key != key)
+        return;
+
+    _indexWriteBegin(&pSlot->seq);
+    pSlot->key = 0;
+    _indexWriteEnd(&pSlot->seq);
+}
+
+// Need to hold rmapi control cache write lock
+static void _indexObjectClearClient(NvHandle hClient)
+{
+    NvU32 i;
+
+    for (i = 0; i < CACHE_INDEX_OBJECTS; i++)
+    {
+        RmapiControlCacheIndexObject *pSlot = &RmapiControlCache.indexObjects[i];
+
+        if ((pSlot->key == 0) || (_gpuAttrKeyToClient(pSlot->key) != hClient))
+            continue;
+
+        _indexWriteBegin(&pSlot->seq);
+        pSlot->key = 0;
+        _indexWriteEnd(&pSlot->seq);
+    }
+}
+
+// Does not take any locks.
+static NvBool _indexObjectLookup(NvU64 key, NvU64 *pGpuAttr)
+{
+    RmapiControlCacheIndexObject *pSlot = &RmapiControlCache.indexObjects[_indexObjectSlot(key)];
+    NvU32 attempt;
+
+    for (attempt = 0; attempt < CACHE_INDEX_READ_RETRIES; attempt++)
+    {
+        NvU32 seq = pSlot->seq;
+        NvBool bMatch;
+
+        if ((seq & 1) == 0)
+        {
+            portAtomicMemoryFenceLoad();
+            bMatch = (pSlot->key == key);
+            *pGpuAttr = pSlot->gpuAttr;
+            portAtomicMemoryFenceLoad();
+
+            if (pSlot->seq == seq)
+                return bMatch;
+        }
+
+        portAtomicExIncrementU64(&_cacheStatsShard()->lockFreeRetries);
+    }
+
+    return NV_FALSE;
+}
+
+//
+// Publish a cacheable entry in the lock-free index. Entries that do not fit
+// the index are silently left to the locked path.
+//
+// Need to hold rmapi control cache write lock
+//
+static void _indexEntrySet
+(
+    NvU32 gpuInst,
+    NvU32 cmd,
+    NvU32 rmctrlFlags,
+    const void *params,
+    NvU32 paramSize
+)
+{
+    const NvU32 slot = _indexEntrySlot(gpuInst, cmd);
+    RmapiControlCacheIndexEntry *pSlot = RmapiControlCache.pIndexEntries[slot];
+
+    if ((paramSize == 0) || (paramSize > CACHE_INDEX_MAX_PARAM_SIZE))
+        return;
+
+    if (pSlot == NULL)
+    {
+        pSlot = portMemAllocNonPaged(sizeof(*pSlot) + paramSize);
+        if (pSlot == NULL)
+            return;
+
+        portMemSet(pSlot, 0, sizeof(*pSlot));
+        pSlot->capacity = paramSize;
+        pSlot->params = (NvU8 *)(pSlot + 1);
+
+        // Make the initialized slot visible before its pointer
+        portAtomicMemoryFenceStore();
+        RmapiControlCache.pIndexEntries[slot] = pSlot;
+    }
+
+    if (pSlot->capacity < paramSize)
+        return;
+
+    _indexWriteBegin(&pSlot->seq);
+    pSlot->gpuInst = gpuInst;
+    pSlot->cmd = cmd;
+    pSlot->rmctrlFlags = rmctrlFlags;
+    pSlot->paramSize = paramSize;
+    portMemCopy(pSlot->params, pSlot->capacity, params, paramSize);
+    _indexWriteEnd(&pSlot->seq);
+}
+
+// Need to hold rmapi control cache write lock
+static void _indexEntryClearSlot(RmapiControlCacheIndexEntry *pSlot)
+{
+    _indexWriteBegin(&pSlot->seq);
+    pSlot->paramSize = 0;
+    _indexWriteEnd(&pSlot->seq);
+}
+
+// Need to hold rmapi control cache write lock
+static void _indexEntryClear(NvU32 gpuInst, NvU32 cmd)
+{
+    RmapiControlCacheIndexEntry *pSlot =
+        RmapiControlCache.pIndexEntries[_indexEntrySlot(gpuInst, cmd)];
+
+    if ((pSlot != NULL) && (pSlot->paramSize != 0) &&
+        (pSlot->gpuInst == gpuInst) && (pSlot->cmd == cmd))
+    {
+        _indexEntryClearSlot(pSlot);
+    }
+}
+
+// Need to hold rmapi control cache write lock
+static void _indexEntryClearGpu(NvU32 gpuInst, NvBool bClearPersistent)
+{
+    NvU32 i;
+
+    for (i = 0; i < CACHE_INDEX_ENTRIES; i++)
+    {
+        RmapiControlCacheIndexEntry *pSlot = RmapiControlCache.pIndexEntries[i];
+
+        if ((pSlot == NULL) || (pSlot->paramSize == 0) || (pSlot->gpuInst != gpuInst))
+            continue;
+
+        if ((pSlot->rmctrlFlags & RMCTRL_FLAGS_PERSISTENT_CACHEABLE) && !bClearPersistent)
+            continue;
+
+        _indexEntryClearSlot(pSlot);
+    }
+}
+
+//
+// Look up a CACHEABLE entry without taking the cache lock. If params is NULL
+// only the RMCTRL flags of the entry are returned.
+//
+// Returns NV_FALSE on any miss or if the slot kept changing under the reader;
+// the caller is expected to fall back to the locked path. The entry is copied
+// into a bounce buffer and only handed to the caller once the sequence check
+// has passed, so params is never written with a torn copy.
+//
+static NvBool _rmapiControlCacheLookupLockFree
+(
+    NvHandle hClient,
+    NvHandle hObject,
+    NvU32    cmd,
+    void    *params,
+    NvU32    paramsSize,
+    NvU32   *pRmctrlFlags
+)
+{
+    RmapiControlCacheIndexEntry *pSlot;
+    NvU8 stackBounce[CACHE_INDEX_STACK_BOUNCE_SIZE];
+    NvU8 *pBounce = NULL;
+    NvBool bFound = NV_FALSE;
+    NvU32 gpuInst;
+    NvU32 attempt;
+
+    if (rmapiControlCacheGetMode() != NV0000_CTRL_SYSTEM_RMCTRL_CACHE_MODE_CTRL_MODE_ENABLE)
+        return NV_FALSE;
+
+    if (_isCmdSystemWide(cmd))
+    {
+        gpuInst = NV_MAX_DEVICES;
+    }
+    else
+    {
+        NvU64 gpuAttr;
+
+        if (!_indexObjectLookup(_handlesToGpuAttrKey(hClient, hObject), &gpuAttr))
+            return NV_FALSE;
+
+        gpuInst = _getGpuInstFromGpuAttr(gpuAttr);
+    }
+
+    pSlot = RmapiControlCache.pIndexEntries[_indexEntrySlot(gpuInst, cmd)];
+    if (pSlot == NULL)
+        return NV_FALSE;
+
+    // The slot capacity is fixed before the slot is published
+    if (params != NULL)
+    {
+        if (pSlot->capacity <= sizeof(stackBounce))
+        {
+            pBounce = stackBounce;
+        }
+        else
+        {
+            pBounce = portMemAllocNonPaged(pSlot->capacity);
+            if (pBounce == NULL)
+                return NV_FALSE;
+        }
+    }
+
+    for (attempt = 0; attempt < CACHE_INDEX_READ_RETRIES; attempt++)
+    {
+        NvU32 seq = pSlot->seq;
+        NvBool bMatch = NV_FALSE;
+
+        if ((seq & 1) == 0)
+        {
+            NvU32 paramSize = 0;
+            NvU32 rmctrlFlags = 0;
+
+            portAtomicMemoryFenceLoad();
+
+            paramSize = pSlot->paramSize;
+            rmctrlFlags = pSlot->rmctrlFlags;
+
+            if ((paramSize != 0) &&
+                (paramSize <= pSlot->capacity) &&
+                (pSlot->gpuInst == gpuInst) &&
+                (pSlot->cmd == cmd) &&
+                (rmctrlFlags & RMCTRL_FLAGS_CACHEABLE) &&
+                ((params == NULL) || (paramSize <= paramsSize)))
+            {
+                if (pBounce != NULL)
+                    portMemCopy(pBounce, pSlot->capacity, pSlot->params, paramSize);
+
+                bMatch = NV_TRUE;
+            }
+
+            portAtomicMemoryFenceLoad();
+
+            if (pSlot->seq == seq)
+            {
+                if (bMatch)
+                {
+                    if (pBounce != NULL)
+                    {
+                        portMemCopy(params, paramsSize, pBounce, paramSize);
+                        portAtomicExIncrementU64(&_cacheStatsShard()->lockFreeHits);
+                    }
+
+                    if (pRmctrlFlags != NULL)
+                        *pRmctrlFlags = rmctrlFlags;
+                }
+
+                bFound = bMatch;
+                goto done;
+            }
+        }
+
+        portAtomicExIncrementU64(&_cacheStatsShard()->lockFreeRetries);
+    }
+
+done:
+    if ((pBounce != NULL) && (pBounce != stackBounce))
+        portMemFree(pBounce);
+
+    return bFound;
+}
+
+//
+// Declarative cacheability table.
+//
+// A descriptor names the GPU state (RMAPI_CONTROL_CACHE_DEP_*) the cached value
+// of a control depends on. It may also add cacheable flags on top of the RMCTRL
+// export flags, for read-only controls whose output does not depend on the
+// input and only changes on a known state transition.
+//
+// Writer controls list the state they change; once they succeed, the dependent
+// entries of that GPU are dropped by rmapiControlCacheInvalidateForControl().
+// State changes made outside of a control call invalidate explicitly through
+// rmapiControlCacheInvalidate().
+//
+typedef struct
+{
+    NvU32 cmd;
+    NvU32 rmctrlFlags;      // RMCTRL_FLAGS_CACHEABLE* added to the export flags
+    NvU32 dependencies;     // state the cached value depends on
+    NvU32 invalidates;      // state changed by a successful call
+} RmapiControlCacheDescriptor;
+
+static const RmapiControlCacheDescriptor _rmapiControlCacheDescriptors[] =
+{
+    { NV2080_CTRL_CMD_CE_GET_CE_PCE_MASK,           0,                      RMAPI_CONTROL_CACHE_DEP_CE_CONFIG,      0 },
+    { NV2080_CTRL_CMD_CE_GET_HUB_PCE_MASK,          0,                      RMAPI_CONTROL_CACHE_DEP_CE_CONFIG,      0 },
+    { NV2080_CTRL_CMD_CE_GET_PHYSICAL_CAPS,         0,                      RMAPI_CONTROL_CACHE_DEP_CE_CONFIG,      0 },
+
+    { NV2080_CTRL_CMD_GPU_QUERY_ECC_CONFIGURATION,  RMCTRL_FLAGS_CACHEABLE, RMAPI_CONTROL_CACHE_DEP_ECC_CONFIG,     0 },
+    { NV2080_CTRL_CMD_GPU_SET_ECC_CONFIGURATION,    0,                      0,                                      RMAPI_CONTROL_CACHE_DEP_ECC_CONFIG },
+
+    { NV2080_CTRL_CMD_GPU_QUERY_COMPUTE_MODE_RULES, RMCTRL_FLAGS_CACHEABLE, RMAPI_CONTROL_CACHE_DEP_COMPUTE_MODE,   0 },
+    { NV2080_CTRL_CMD_GPU_SET_COMPUTE_MODE_RULES,   0,                      0,                                      RMAPI_CONTROL_CACHE_DEP_COMPUTE_MODE },
+
+    { NV2080_CTRL_CMD_PERF_GET_POWERSTATE,          RMCTRL_FLAGS_CACHEABLE, RMAPI_CONTROL_CACHE_DEP_POWER_SOURCE,   0 },
+
+    { NV2080_CTRL_CMD_GPU_GET_ACTIVE_PARTITION_IDS, RMCTRL_FLAGS_CACHEABLE, RMAPI_CONTROL_CACHE_DEP_MIG_CONFIG,     0 },
+};
+
+static const RmapiControlCacheDescriptor *_getCacheDescriptor(NvU32 cmd)
+{
+    NvU32 i;
+
+    for (i = 0; i < NV_ARRAY_ELEMENTS(_rmapiControlCacheDescriptors); i++)
+    {
+        if (_rmapiControlCacheDescriptors[i].cmd == cmd)
+            return &_rmapiControlCacheDescriptors[i];
+    }
+
+    return NULL;
+}
+
+/*!
+ * Cacheable RMCTRL flags declared for a control in addition to its export flags.
+ */
+NvU32 rmapiControlCacheGetDeclaredFlags(NvU32 cmd)
+{
+    const RmapiControlCacheDescriptor *pDesc = _getCacheDescriptor(cmd);
+
+    return (pDesc != NULL) ? pDesc->rmctrlFlags : 0;
+}
+
+//
+// Controls made cacheable by the table are only declared safe for state owned
+// by this RM instance. Under virtualization the state lives in the host and
+// may change without this RM seeing the transition, so do not cache them.
+//
+static NvBool _isDeclaredCacheableOnGpu(NvU32 gpuInst, NvU32 cmd)
+{
+    OBJGPU *pGpu;
+
+    if (rmapiControlCacheGetDeclaredFlags(cmd) == 0)
+        return NV_TRUE;
+
+    pGpu = gpumgrGetGpu(gpuInst);
+
+    return (pGpu != NULL) && !IS_VIRTUAL(pGpu);
+}
+
+//
+// Params produced by a control that started at *pInvalidateSeq are stale if a
+// dependency invalidation ran since, and must not be filled in. A NULL
+// pInvalidateSeq means the caller does not track the sequence.
+//
+// Need to hold rmapi control cache write lock
+//
+static NvBool _isCacheFillStale(NvU32 cmd, const NvU32 *pInvalidateSeq)
+{
+    const RmapiControlCacheDescriptor *pDesc;
+
+    if (pInvalidateSeq == NULL)
+        return NV_FALSE;
+
+    pDesc = _getCacheDescriptor(cmd);
+
+    return (pDesc != NULL) && (pDesc->dependencies != 0) &&
+           (RmapiControlCache.invalidateSeq != *pInvalidateSeq);
+}
+
 static RmapiControlCacheEntry* _setCacheEntry(NvU64 key1, NvU64 key2, NvU32 allocSize,
                                               NvU32 rmctrlFlags, NvBool *pbParamsAllocated);
 static RmapiControlCacheEntry* _getCacheEntry(NvU64 key1, NvU64 key2);
@@ -180,6 +672,8 @@ NvBool rmapiCmdIsCacheable(NvU32 cmd, NvBool bAllowInternal)
     if (rmapiutilGetControlInfo(cmd, &flags, &accessRight, NULL) != NV_OK)
         return NV_FALSE;
 
+    flags |= rmapiControlCacheGetDeclaredFlags(cmd);
+
     return rmapiControlIsCacheable(flags, accessRight, bAllowInternal);
 }
 
@@ -253,6 +747,7 @@ NV_STATUS rmapiControlCacheSetGpuAttrForObject
     }
 
     *entry = gpuAttr;
+    _indexObjectSet(_handlesToGpuAttrKey(hClient, hObject), gpuAttr);
 
 done:
     _cacheLockRelease(LOCK_EXCLUSIVE);
@@ -299,6 +794,8 @@ static void _rmapiControlCacheFreeGpuAttrForObject
     const NvU64 key = _handlesToGpuAttrKey(hClient, hObject);
     NvU64* entry = mapFind(&RmapiControlCache.objectToGpuAttrMap, key);
 
+    _indexObjectClear(key);
+
     if (entry != NULL)
     {
         mapRemove(&RmapiControlCache.objectToGpuAttrMap, entry);
@@ -309,6 +806,8 @@ static void _rmapiControlCacheFreeGpuAttrForObject
 // Need to hold rmapi control cache write lock
 static void _rmapiControlCacheFreeGpuAttrForClient(NvHandle hClient)
 {
+    _indexObjectClearClient(hClient);
+
     while (NV_TRUE)
     {
         NvU64* entry = mapFindGEQ(&RmapiControlCache.objectToGpuAttrMap, _handlesToGpuAttrKey(hClient, 0));
@@ -340,6 +839,9 @@ static NV_STATUS _rmapiControlCacheGetCacheable
     NvU32 gpuInst;
     NV_STATUS status = NV_OK;
 
+    if (_rmapiControlCacheLookupLockFree(hClient, hObject, cmd, params, paramsSize, NULL))
+        return NV_OK;
+
     _cacheLockAcquire(LOCK_SHARED);
 
     if (_cacheIsDisabled())
@@ -419,6 +921,15 @@ static NV_STATUS _rmapiControlCacheGetAny
     NV_STATUS status = NV_OK;
     NvU32 rmctrlFlags = 0;
 
+    if (_rmapiControlCacheLookupLockFree(hClient, hObject, cmd, NULL, 0, &rmctrlFlags))
+    {
+        status = rmControlValidateClientPrivilegeAccess(hClient, hObject, cmd, rmctrlFlags, pSecInfo);
+        if (status != NV_OK)
+            return status;
+
+        return _rmapiControlCacheGetCacheable(hClient, hObject, cmd, params, paramsSize);
+    }
+
     _cacheLockAcquire(LOCK_SHARED);
 
     if (_cacheIsDisabled())
@@ -485,7 +996,8 @@ static NV_STATUS _rmapiControlCacheSet
     NvU32 cmd,
     NvU32 rmctrlFlags,
     const void* params,
-    NvU32 paramsSize
+    NvU32 paramsSize,
+    const NvU32 *pInvalidateSeq
 )
 {
     NV_STATUS status = NV_OK;
@@ -513,6 +1025,12 @@ static NV_STATUS _rmapiControlCacheSet
             goto done;
     }
 
+    if (!_isDeclaredCacheableOnGpu(gpuInst, cmd))
+        goto done;
+
+    if (_isCacheFillStale(cmd, pInvalidateSeq))
+        goto done;
+
     entry = _setCacheEntry(gpuInst, cmd, paramsSize, rmctrlFlags, &bParamsAllocated);
     if (entry == NULL)
     {
@@ -535,11 +1053,17 @@ static NV_STATUS _rmapiControlCacheSet
         {
             NV_ASSERT(portMemCmp(entry->params, params, paramsSize) == 0);
         }
+        else
+        {
+            // Re-publish entries that may have been evicted from the index
+            _indexEntrySet(gpuInst, cmd, entry->rmctrlFlags, entry->params, (NvU32)entry->paramSize);
+        }
         status = NV_OK;
         goto done;
     }
 
     portMemCopy(entry->params, paramsSize, params, paramsSize);
+    _indexEntrySet(gpuInst, cmd, rmctrlFlags, entry->params, paramsSize);
 
 done:
     _cacheLockRelease(LOCK_EXCLUSIVE);
@@ -1071,7 +1595,8 @@ static NV_STATUS _getCePhysicalCapsHandler
     NvU32 rmctrlFlags,
     NvU32 ceEngineType,
     NvU8 capsTbl[NV2080_CTRL_CE_CAPS_TBL_SIZE],
-    NvBool bSet
+    NvBool bSet,
+    const NvU32 *pInvalidateSeq
 )
 {
     NV_STATUS status = NV_OK;
@@ -1101,6 +1626,9 @@ static NV_STATUS _getCePhysicalCapsHandler
     if (status != NV_OK)
         goto done;
 
+    if (bSet && _isCacheFillStale(NV2080_CTRL_CMD_CE_GET_PHYSICAL_CAPS, pInvalidateSeq))
+        goto done;
+
     if (bSet)
         entry = _setCacheEntry(gpuInst, NV2080_CTRL_CMD_CE_GET_PHYSICAL_CAPS, allocSize, rmctrlFlags, NULL);
     else
@@ -1181,7 +1709,8 @@ static NV_STATUS _getCePceMaskHandler
     NvU32 rmctrlFlags,
     NvU32 ceEngineType,
     NvU32 *pceMask,
-    NvBool bSet
+    NvBool bSet,
+    const NvU32 *pInvalidateSeq
 )
 {
     NV_STATUS status = NV_OK;
@@ -1211,6 +1740,9 @@ static NV_STATUS _getCePceMaskHandler
     if (status != NV_OK)
         goto done;
 
+    if (bSet && _isCacheFillStale(NV2080_CTRL_CMD_CE_GET_CE_PCE_MASK, pInvalidateSeq))
+        goto done;
+
     if (bSet)
         entry = _setCacheEntry(gpuInst, NV2080_CTRL_CMD_CE_GET_CE_PCE_MASK, allocSize, rmctrlFlags, NULL);
     else
@@ -1270,32 +1802,98 @@ done:
     return status;
 }
 
+// Need to hold rmapi control cache write lock
+static void _rmapiControlCacheFreeEntry(NvU32 gpuInst, NvU32 cmd)
+{
+    RmapiControlCacheEntry *entry;
+
+    _indexEntryClear(gpuInst, cmd);
+
+    entry = multimapFindItem(&RmapiControlCache.gpusControlCache, gpuInst, cmd);
+    if (entry == NULL)
+        return;
+
+    if (entry->params != NULL)
+        portMemFree(entry->params);
+
+    multimapRemoveItem(&RmapiControlCache.gpusControlCache, entry);
+    RmapiControlCache.invalidations++;
+}
+
 NV_STATUS rmapiControlCacheFreeForControl
 (
     NvU32 gpuInstance,
     NvU32 cmd
 )
 {
-    RmapiControlCacheEntry *entry = NULL;
-
     _cacheLockAcquire(LOCK_EXCLUSIVE);
+    _rmapiControlCacheFreeEntry(gpuInstance, cmd);
+    _cacheLockRelease(LOCK_EXCLUSIVE);
 
-    entry = multimapFindItem(&RmapiControlCache.gpusControlCache, gpuInstance, cmd);
+    return NV_OK;
+}
 
-    if (entry == NULL)
-        goto done;
+// Need to hold rmapi control cache write lock
+static void _rmapiControlCacheInvalidateGpu(NvU32 gpuInst, NvU32 dependencies)
+{
+    NvU32 i;
 
-    if (entry->params != NULL)
-        portMemFree(entry->params);
+    RmapiControlCache.invalidateSeq++;
 
-    multimapRemoveItem(&RmapiControlCache.gpusControlCache, entry);
+    for (i = 0; i < NV_ARRAY_ELEMENTS(_rmapiControlCacheDescriptors); i++)
+    {
+        const RmapiControlCacheDescriptor *pDesc = &_rmapiControlCacheDescriptors[i];
 
-done:
+        if (pDesc->dependencies & dependencies)
+            _rmapiControlCacheFreeEntry(gpuInst, pDesc->cmd);
+    }
+}
+
+/*!
+ * Drop the cached entries of a GPU that depend on any of the given
+ * RMAPI_CONTROL_CACHE_DEP_* state.
+ */
+NV_STATUS rmapiControlCacheInvalidate
+(
+    NvU32 gpuInst,
+    NvU32 dependencies
+)
+{
+    NV_PRINTF(LEVEL_INFO, "invalidate cache dependencies 0x%x for gpu %u\n", dependencies, gpuInst);
+
+    _cacheLockAcquire(LOCK_EXCLUSIVE);
+    _rmapiControlCacheInvalidateGpu(gpuInst, dependencies);
     _cacheLockRelease(LOCK_EXCLUSIVE);
 
     return NV_OK;
 }
 
+/*!
+ * Called after a control ran, with its locks held. If the control is declared
+ * to change cached state, drop the dependent entries of the GPU hObject
+ * belongs to.
+ */
+void rmapiControlCacheInvalidateForControl
+(
+    NvHandle hClient,
+    NvHandle hObject,
+    NvU32    cmd
+)
+{
+    const RmapiControlCacheDescriptor *pDesc = _getCacheDescriptor(cmd);
+    NvU32 gpuInst;
+
+    if ((pDesc == NULL) || (pDesc->invalidates == 0))
+        return;
+
+    _cacheLockAcquire(LOCK_EXCLUSIVE);
+
+    if (_rmapiControlCacheGetGpuAttrForObject(hClient, hObject, &gpuInst, NULL) == NV_OK)
+        _rmapiControlCacheInvalidateGpu(gpuInst, pDesc->invalidates);
+
+    _cacheLockRelease(LOCK_EXCLUSIVE);
+}
+
 static NV_STATUS _rmapiControlCacheGetByInput
 (
     NvHandle hClient,
@@ -1339,13 +1937,13 @@ static NV_STATUS _rmapiControlCacheGetByInput
             return _getCePhysicalCapsHandler(hClient, hObject, 0,
                                              ((NV2080_CTRL_CE_GET_PHYSICAL_CAPS_PARAMS*)params)->ceEngineType,
                                              ((NV2080_CTRL_CE_GET_PHYSICAL_CAPS_PARAMS*)params)->capsTbl,
-                                             NV_FALSE);
+                                             NV_FALSE, NULL);
 
         case NV2080_CTRL_CMD_CE_GET_CE_PCE_MASK:
             return _getCePceMaskHandler(hClient, hObject, 0,
                                         ((NV2080_CTRL_CE_GET_CE_PCE_MASK_PARAMS*)params)->ceEngineType,
                                         &((NV2080_CTRL_CE_GET_CE_PCE_MASK_PARAMS*)params)->pceMask,
-                                        NV_FALSE);
+                                        NV_FALSE, NULL);
 
         case NV2080_CTRL_CMD_GPU_GET_NAME_STRING:
             return _gpuNameStringGet(hClient, hObject, params);
@@ -1381,7 +1979,8 @@ NV_STATUS _rmapiControlCacheSetByInput
     NvU32 cmd,
     NvU32 rmctrlFlags,
     void* params,
-    NvU32 paramsSize
+    NvU32 paramsSize,
+    const NvU32 *pInvalidateSeq
 )
 {
     switch (cmd)
@@ -1418,13 +2017,13 @@ NV_STATUS _rmapiControlCacheSetByInput
             return _getCePhysicalCapsHandler(hClient, hObject, rmctrlFlags,
                                              ((NV2080_CTRL_CE_GET_PHYSICAL_CAPS_PARAMS*)params)->ceEngineType,
                                              ((NV2080_CTRL_CE_GET_PHYSICAL_CAPS_PARAMS*)params)->capsTbl,
-                                             NV_TRUE);
+                                             NV_TRUE, pInvalidateSeq);
 
         case NV2080_CTRL_CMD_CE_GET_CE_PCE_MASK:
             return _getCePceMaskHandler(hClient, hObject, rmctrlFlags,
                                         ((NV2080_CTRL_CE_GET_CE_PCE_MASK_PARAMS*)params)->ceEngineType,
                                         &((NV2080_CTRL_CE_GET_CE_PCE_MASK_PARAMS*)params)->pceMask,
-                                        NV_TRUE);
+                                        NV_TRUE, pInvalidateSeq);
 
         case NV2080_CTRL_CMD_GPU_GET_NAME_STRING:
             return _gpuNameStringSet(hClient, hObject, rmctrlFlags, params);
@@ -1476,6 +2075,7 @@ NV_STATUS rmapiControlCacheGetUnchecked
         return NV_ERR_OBJECT_NOT_FOUND;
 
     status = _rmapiControlCacheGetAny(hClient, hObject, cmd, params, paramsSize, pSecInfo);
+    _cacheRecordLookup(status);
 
     NV_PRINTF(LEVEL_INFO, "control cache get for 0x%x 0x%x 0x%x status: 0x%x\n", hClient, hObject, cmd, status);
     return status;
@@ -1510,6 +2110,8 @@ NV_STATUS rmapiControlCacheGet
     if (status != NV_OK)
         goto done;
 
+    flags |= rmapiControlCacheGetDeclaredFlags(cmd);
+
     NV_CHECK_OR_ELSE(LEVEL_ERROR,
                      (params != NULL && paramsSize == ctrlParamsSize),
                      status = NV_ERR_INVALID_PARAMETER; goto done);
@@ -1533,10 +2135,69 @@ NV_STATUS rmapiControlCacheGet
     }
 
 done:
+    _cacheRecordLookup(status);
     NV_PRINTF(LEVEL_INFO, "control cache get for 0x%x 0x%x 0x%x status: 0x%x\n", hClient, hObject, cmd, status);
     return status;
 }
 
+static NV_STATUS _rmapiControlCacheSetAny
+(
+    NvHandle hClient,
+    NvHandle hObject,
+    NvU32 cmd,
+    void* params,
+    NvU32 paramsSize,
+    NvU32 rmctrlFlags,
+    const NvU32 *pInvalidateSeq
+)
+{
+    NV_STATUS status = NV_OK;
+
+    switch ((rmctrlFlags & RMCTRL_FLAGS_CACHEABLE_ANY))
+    {
+        case RMCTRL_FLAGS_CACHEABLE:
+            status = _rmapiControlCacheSet(hClient, hObject, cmd, rmctrlFlags, params, paramsSize,
+                                           pInvalidateSeq);
+            break;
+        case RMCTRL_FLAGS_CACHEABLE_BY_INPUT:
+            status = _rmapiControlCacheSetByInput(hClient, hObject, cmd, rmctrlFlags, params, paramsSize,
+                                                  pInvalidateSeq);
+            break;
+        default:
+            NV_PRINTF(LEVEL_ERROR, "Invalid cacheable flag 0x%x for cmd 0x%x\n", rmctrlFlags, cmd);
+            status = NV_ERR_INVALID_PARAMETER;
+            goto done;
+    }
+
+done:
+    NV_PRINTF(LEVEL_INFO, "control cache set for 0x%x 0x%x 0x%x status: 0x%x\n", hClient, hObject, cmd, status);
+    return status;
+}
+
+static NV_STATUS _rmapiControlCacheSetChecked
+(
+    NvHandle hClient,
+    NvHandle hObject,
+    NvU32 cmd,
+    void* params,
+    NvU32 paramsSize,
+    const NvU32 *pInvalidateSeq
+)
+{
+    NvU32 flags;
+    NvU32 ctrlParamsSize;
+
+    NV_CHECK_OK_OR_RETURN(LEVEL_ERROR, rmapiutilGetControlInfo(cmd, &flags, NULL, &ctrlParamsSize));
+
+    flags |= rmapiControlCacheGetDeclaredFlags(cmd);
+
+    NV_CHECK_OR_RETURN(LEVEL_ERROR,
+                       (params != NULL && paramsSize == ctrlParamsSize),
+                       NV_ERR_INVALID_PARAMETER);
+
+    return _rmapiControlCacheSetAny(hClient, hObject, cmd, params, paramsSize, flags, pInvalidateSeq);
+}
+
 /*!
  * Try to set cached params for a (hClient, hObject, cmd) triple.
  * If there is an existing cache entry for the triple, the entry is unmodified.
@@ -1555,16 +2216,38 @@ NV_STATUS rmapiControlCacheSet
     NvU32 paramsSize
 )
 {
-    NvU32 flags;
-    NvU32 ctrlParamsSize;
-
-    NV_CHECK_OK_OR_RETURN(LEVEL_ERROR, rmapiutilGetControlInfo(cmd, &flags, NULL, &ctrlParamsSize));
+    return _rmapiControlCacheSetChecked(hClient, hObject, cmd, params, paramsSize, NULL);
+}
 
-    NV_CHECK_OR_RETURN(LEVEL_ERROR,
-                       (params != NULL && paramsSize == ctrlParamsSize),
-                       NV_ERR_INVALID_PARAMETER);
+/*!
+ * Current dependency invalidation sequence, see
+ * rmapiControlCacheSetSinceInvalidateSeq().
+ */
+NvU32 rmapiControlCacheGetInvalidateSeq(void)
+{
+    return RmapiControlCache.invalidateSeq;
+}
 
-    return rmapiControlCacheSetUnchecked(hClient, hObject, cmd, params, paramsSize, flags);
+/*!
+ * Same as rmapiControlCacheSet(), for params produced by a control that
+ * started when the invalidation sequence was invalidateSeq.
+ *
+ * The params are copied out after the locks of the control are dropped, so a
+ * control that changed the state they depend on may have run and invalidated
+ * the cache in between. In that case the fill is skipped, checked under the
+ * same cache lock that publishes the entry.
+ */
+NV_STATUS rmapiControlCacheSetSinceInvalidateSeq
+(
+    NvHandle hClient,
+    NvHandle hObject,
+    NvU32 cmd,
+    void* params,
+    NvU32 paramsSize,
+    NvU32 invalidateSeq
+)
+{
+    return _rmapiControlCacheSetChecked(hClient, hObject, cmd, params, paramsSize, &invalidateSeq);
 }
 
 /*!
@@ -1587,25 +2270,7 @@ NV_STATUS rmapiControlCacheSetUnchecked
     NvU32 rmctrlFlags
 )
 {
-    NV_STATUS status = NV_OK;
-
-    switch ((rmctrlFlags & RMCTRL_FLAGS_CACHEABLE_ANY))
-    {
-        case RMCTRL_FLAGS_CACHEABLE:
-            status = _rmapiControlCacheSet(hClient, hObject, cmd, rmctrlFlags, params, paramsSize);
-            break;
-        case RMCTRL_FLAGS_CACHEABLE_BY_INPUT:
-            status = _rmapiControlCacheSetByInput(hClient, hObject, cmd, rmctrlFlags, params, paramsSize);
-            break;
-        default:
-            NV_PRINTF(LEVEL_ERROR, "Invalid cacheable flag 0x%x for cmd 0x%x\n", rmctrlFlags, cmd);
-            status = NV_ERR_INVALID_PARAMETER;
-            goto done;
-    }
-
-done:
-    NV_PRINTF(LEVEL_INFO, "control cache set for 0x%x 0x%x 0x%x status: 0x%x\n", hClient, hObject, cmd, status);
-    return status;
+    return _rmapiControlCacheSetAny(hClient, hObject, cmd, params, paramsSize, rmctrlFlags, NULL);
 }
 
 // Need to hold rmapi control cache write lock
@@ -1628,6 +2293,7 @@ static void _freeSubmap(GpusControlCache *pMap, GpusControlCacheSubmap* pSubmap,
 
             portMemFree(entry->params);
             multimapRemoveItem(pMap, entry);
+            RmapiControlCache.invalidations++;
 
             // Restart iterating
             break;
@@ -1648,6 +2314,8 @@ static void _rmapiControlCacheFreeGpuCache(NvU32 gpuInst, NvBool bFreePersistent
 {
     GpusControlCacheSubmap *submap;
 
+    _indexEntryClearGpu(gpuInst, bFreePersistent);
+
     submap = multimapFindSubmap(&RmapiControlCache.gpusControlCache, gpuInst);
     if (submap != NULL)
         _freeSubmap(&RmapiControlCache.gpusControlCache, submap, bFreePersistent);
@@ -1700,6 +2368,14 @@ void rmapiControlCacheFreeObjectEntry(NvHandle hClient, NvHandle hObject)
 void rmapiControlCacheFree(void)
 {
     GpusControlCacheIter it;
+    NvU32 i;
+
+    for (i = 0; i < CACHE_INDEX_ENTRIES; i++)
+    {
+        portMemFree(RmapiControlCache.pIndexEntries[i]);
+        RmapiControlCache.pIndexEntries[i] = NULL;
+    }
+    portMemSet(RmapiControlCache.indexObjects, 0, sizeof(RmapiControlCache.indexObjects));
 
     it = multimapItemIterAll(&RmapiControlCache.gpusControlCache);
     while (multimapItemIterNext(&it))
@@ -1728,3 +2404,22 @@ NvU32 rmapiControlCacheGetMode(void)
 {
     return RmapiControlCache.mode;
 }
+
+void rmapiControlCacheGetStats(RMAPI_CONTROL_CACHE_STATS *pStats)
+{
+    NvU32 i;
+
+    portMemSet(pStats, 0, sizeof(*pStats));
+
+    for (i = 0; i < CACHE_STATS_SHARDS; i++)
+    {
+        const RmapiControlCacheStatsShard *pShard = &RmapiControlCache.stats[i];
+
+        pStats->hits            += pShard->hits;
+        pStats->misses          += pShard->misses;
+        pStats->lockFreeHits    += pShard->lockFreeHits;
+        pStats->lockFreeRetries += pShard->lockFreeRetries;
+    }
+
+    pStats->invalidations = RmapiControlCache.invalidations;
+}
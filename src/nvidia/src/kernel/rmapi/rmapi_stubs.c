@@ -166,6 +166,7 @@ void rmapiInitStubInterface(RM_API *pRmApi)
     pRmApi->Control                      = _rmapiControl_STUB;
     pRmApi->ControlWithSecInfo           = _rmapiControlWithSecInfo_STUB;
     pRmApi->ControlPrefetch              = _rmapiControlPrefetch_STUB;
+    pRmApi->ControlBatch                 = rmapiControlBatch;
     pRmApi->DupObject                    = _rmapiDupObject_STUB;
     pRmApi->DupObjectWithSecInfo         = _rmapiDupObjectWithSecInfo_STUB;
     pRmApi->Share                        = _rmapiShare_STUB;
@@ -74,6 +74,7 @@ static void rpcRmApiSetup(OBJGPU *pGpu)
     else if (IS_GSP_CLIENT(pGpu))
     {
         pRmApi->Control         = rpcRmApiControl_GSP;
+        pRmApi->ControlBatch    = rpcRmApiControlBatch_GSP;
         pRmApi->AllocWithHandle = rpcRmApiAlloc_GSP;
         pRmApi->Free            = rpcRmApiFree_GSP;
         pRmApi->DupObject       = rpcRmApiDupObject_GSP;
@@ -96,6 +97,10 @@ OBJRPC *initRpcObject(OBJGPU *pGpu)
     pRpc->bQuietPrints = NV_FALSE;
 
     pRpc->sequence = 0;
+    pRpc->deferredHead = 0;
+    pRpc->deferredCount = 0;
+    pRpc->deferredFailures = 0;
+    pRpc->bDeferFree = NV_FALSE;
     if (!IS_DCE_CLIENT(pGpu))
     {
         // VIRTUALIZATION is disabled on DCE. Only run the below code on VGPU and GSP.
@@ -2051,6 +2051,241 @@ static NV_STATUS _issueRpcAsync(OBJGPU *pGpu, OBJRPC *pRpc)
     return NV_OK;
 }
 
+static NV_STATUS _rpcResultToStatus(NvU32 rpcResult)
+{
+    if (rpcResult == NV_VGPU_MSG_RESULT_SUCCESS)
+        return NV_OK;
+
+    if (rpcResult < DRF_BASE(NV_VGPU_MSG_RESULT__VMIOP))
+        return rpcResult;
+
+    return NV_ERR_GENERIC;
+}
+
+static void _rpcCompleteDeferredHead(OBJGPU *pGpu, OBJRPC *pRpc, NV_STATUS status)
+{
+    RpcDeferredEntry entry = pRpc->deferred[pRpc->deferredHead];
+
+    pRpc->deferredHead = (pRpc->deferredHead + 1) % RPC_DEFERRED_DEPTH;
+    pRpc->deferredCount--;
+
+    if (status != NV_OK)
+    {
+        pRpc->deferredFailures++;
+        NV_PRINTF_COND(pRpc->bQuietPrints, LEVEL_INFO, LEVEL_ERROR,
+                       "Deferred RPC failed with status 0x%08x for fn %d sequence %u!\n",
+                       status, entry.function, entry.sequence);
+    }
+
+    if (entry.pCallback != NULL)
+        entry.pCallback(pGpu, entry.pCallbackArg, entry.function, entry.sequence, status);
+}
+
+static NvBool _rpcIsDeferred(OBJRPC *pRpc, NvU32 sequence)
+{
+    NvU32 i;
+
+    for (i = 0; i < pRpc->deferredCount; i++)
+    {
+        if (pRpc->deferred[(pRpc->deferredHead + i) % RPC_DEFERRED_DEPTH].sequence == sequence)
+            return NV_TRUE;
+    }
+
+    return NV_FALSE;
+}
+
+/*!
+ * Retire the oldest deferred RPC if the message in the staging area is its
+ * response.
+ *
+ * @return NV_TRUE if the message was consumed.
+ */
+NvBool rpcRetireDeferred(OBJGPU *pGpu, OBJRPC *pRpc, NvU32 function, NvU32 sequence, NvU32 rpcResult)
+{
+    RpcDeferredEntry *pHead;
+
+    if (pRpc->deferredCount == 0)
+        return NV_FALSE;
+
+    pHead = &pRpc->deferred[pRpc->deferredHead];
+    if ((pHead->function != function) || (pHead->sequence != sequence))
+        return NV_FALSE;
+
+    _rpcCompleteDeferredHead(pGpu, pRpc, _rpcResultToStatus(rpcResult));
+
+    return NV_TRUE;
+}
+
+/*!
+ * Look up the rpcHistory slot of the oldest deferred RPC, if it is the given
+ * RPC. Deferred RPCs are usually not the latest RPC sent, so their response
+ * must be accounted against the slot recorded when they were issued.
+ *
+ * @return NV_FALSE if the RPC is not the oldest deferred RPC, or if its slot
+ *         has since been reused.
+ */
+NvBool rpcGetDeferredHistoryEntry(OBJRPC *pRpc, NvU32 function, NvU32 sequence, NvU32 *pHistoryEntry)
+{
+    RpcDeferredEntry *pHead;
+    RpcHistoryEntry *pHistory;
+
+    if (pRpc->deferredCount == 0)
+        return NV_FALSE;
+
+    pHead = &pRpc->deferred[pRpc->deferredHead];
+    if ((pHead->function != function) || (pHead->sequence != sequence))
+        return NV_FALSE;
+
+    pHistory = &pRpc->rpcHistory[pHead->historyEntry];
+    if ((pHistory->function != function) || (pHistory->sequence != sequence))
+        return NV_FALSE;
+
+    *pHistoryEntry = pHead->historyEntry;
+    return NV_TRUE;
+}
+
+/*!
+ * Complete all outstanding deferred RPCs with the given status without
+ * waiting for their responses, e.g. once GSP-RM is known to be dead.
+ */
+void rpcCancelDeferred(OBJGPU *pGpu, OBJRPC *pRpc, NV_STATUS status)
+{
+    while (pRpc->deferredCount != 0)
+        _rpcCompleteDeferredHead(pGpu, pRpc, status);
+}
+
+/*!
+ * Wait until the deferred RPC with the given sequence number and all RPCs
+ * deferred before it have completed.
+ *
+ * @return the status of the RPC, or NV_OK if it had already completed.
+ */
+NV_STATUS rpcWaitDeferred(OBJGPU *pGpu, OBJRPC *pRpc, NvU32 sequence)
+{
+    NV_STATUS status = NV_OK;
+
+    NV_CHECK(LEVEL_ERROR, rmDeviceGpuLockIsOwner(pGpu->gpuInstance));
+
+    while (_rpcIsDeferred(pRpc, sequence))
+    {
+        RpcDeferredEntry *pHead = &pRpc->deferred[pRpc->deferredHead];
+
+        status = rpcRecvPoll(pGpu, pRpc, pHead->function, pHead->sequence);
+        if (status != NV_OK)
+        {
+            //
+            // The responses can no longer be matched reliably, fail everything
+            // that is still outstanding.
+            //
+            rpcCancelDeferred(pGpu, pRpc, status);
+            return status;
+        }
+
+        // The response is left in the staging area by rpcRecvPoll()
+        status = _rpcResultToStatus(vgpu_rpc_message_header_v->rpc_result);
+        _rpcCompleteDeferredHead(pGpu, pRpc, status);
+    }
+
+    return status;
+}
+
+/*!
+ * Wait for all outstanding deferred RPCs to complete.
+ */
+NV_STATUS rpcFlushDeferred(OBJGPU *pGpu, OBJRPC *pRpc)
+{
+    NV_STATUS status = NV_OK;
+
+    while (pRpc->deferredCount != 0)
+    {
+        NvU32 tailSequence =
+            pRpc->deferred[(pRpc->deferredHead + pRpc->deferredCount - 1) % RPC_DEFERRED_DEPTH].sequence;
+        NV_STATUS waitStatus = rpcWaitDeferred(pGpu, pRpc, tailSequence);
+
+        if (status == NV_OK)
+            status = waitStatus;
+    }
+
+    return status;
+}
+
+/*!
+ * Send the RPC in the message buffer without waiting for its response.
+ *
+ * The response is retired, and pCallback called, when it is drained by a later
+ * wait or by the GSP event handler. The returned sequence number can be passed
+ * to rpcWaitDeferred(). Only GSP clients track responses this way, other RPC
+ * transports wait synchronously.
+ */
+static NV_STATUS _issueRpcDeferred
+(
+    OBJGPU *pGpu,
+    OBJRPC *pRpc,
+    RpcDeferredCallback *pCallback,
+    void *pCallbackArg,
+    NvU32 *pSequence
+)
+{
+    NV_STATUS status;
+    RpcDeferredEntry *pEntry;
+    NvU32 function = vgpu_rpc_message_header_v->function;
+    NvU32 sequence = 0;
+
+    if (!IS_GSP_CLIENT(pGpu))
+    {
+        status = _issueRpcAndWait(pGpu, pRpc);
+        if (pCallback != NULL)
+            pCallback(pGpu, pCallbackArg, function, 0, status);
+        if (pSequence != NULL)
+            *pSequence = 0;
+        return status;
+    }
+
+    // should not be called in broadcast mode
+    NV_ASSERT_OR_RETURN(!gpumgrGetBcEnabledStatus(pGpu), NV_ERR_INVALID_STATE);
+    NV_CHECK(LEVEL_ERROR, rmDeviceGpuLockIsOwner(pGpu->gpuInstance));
+
+    //
+    // Make room by waiting for the oldest response. This overwrites the
+    // message buffer, so stash the request in the meantime.
+    //
+    if (pRpc->deferredCount == RPC_DEFERRED_DEPTH)
+    {
+        NvU32 length = vgpu_rpc_message_header_v->length;
+        void *pMessage = portMemAllocNonPaged(length);
+
+        NV_ASSERT_OR_RETURN(pMessage != NULL, NV_ERR_NO_MEMORY);
+        portMemCopy(pMessage, length, pRpc->message_buffer, length);
+
+        (void)rpcWaitDeferred(pGpu, pRpc, pRpc->deferred[pRpc->deferredHead].sequence);
+
+        portMemCopy(pRpc->message_buffer, length, pMessage, length);
+        portMemFree(pMessage);
+    }
+
+    status = rpcSendMessage(pGpu, pRpc, &sequence);
+    if (status != NV_OK)
+    {
+        NV_PRINTF_COND(pRpc->bQuietPrints, LEVEL_INFO, LEVEL_ERROR,
+            "rpcSendMessage deferred failed with status 0x%08x for fn %d!\n",
+            status, function);
+        return (status == NV_ERR_BUSY_RETRY) ? NV_ERR_GENERIC : status;
+    }
+
+    pEntry = &pRpc->deferred[(pRpc->deferredHead + pRpc->deferredCount) % RPC_DEFERRED_DEPTH];
+    pEntry->function     = function;
+    pEntry->sequence     = sequence;
+    pEntry->historyEntry = pRpc->rpcHistoryCurrent;     // recorded by rpcSendMessage()
+    pEntry->pCallback    = pCallback;
+    pEntry->pCallbackArg = pCallbackArg;
+    pRpc->deferredCount++;
+
+    if (pSequence != NULL)
+        *pSequence = sequence;
+
+    return NV_OK;
+}
+
 static NV_STATUS _issueRpcLarge
 (
     OBJGPU *pGpu,
@@ -11019,6 +11254,19 @@ void osAssertFailed(void);
 #define RPC_LOCK_DEBUG_DUMP_STACK()
 #endif
 
+// Control failures expected in normal operation, which are not worth a warning
+static NvBool _rpcRmApiControlIsQuietStatus(NV_STATUS status)
+{
+    switch (status)
+    {
+        case NV_ERR_NOT_SUPPORTED:
+        case NV_ERR_OBJECT_NOT_FOUND:
+            return NV_TRUE;
+        default:
+            return NV_FALSE;
+    }
+}
+
 NV_STATUS rpcRmApiControl_GSP
 (
     RM_API *pRmApi,
@@ -11275,15 +11523,7 @@ NV_STATUS rpcRmApiControl_GSP
 
     if (status != NV_OK)
     {
-        NvBool bQuiet = NV_FALSE;
-        switch (status)
-        {
-            case NV_ERR_NOT_SUPPORTED:
-            case NV_ERR_OBJECT_NOT_FOUND:
-                bQuiet = NV_TRUE;
-                break;
-        }
-        NV_PRINTF_COND((pRpc->bQuietPrints || bQuiet), LEVEL_INFO, LEVEL_WARNING,
+        NV_PRINTF_COND((pRpc->bQuietPrints || _rpcRmApiControlIsQuietStatus(status)), LEVEL_INFO, LEVEL_WARNING,
             "GspRmControl failed: hClient=0x%08x; hObject=0x%08x; cmd=0x%08x; paramsSize=0x%08x; paramsStatus=0x%08x; status=0x%08x\n",
             hClient, hObject, cmd, paramsSize, rpc_params->status, status);
     }
@@ -11305,6 +11545,178 @@ done:
     return status;
 }
 
+//
+// Controls that can be pipelined by rpcRmApiControlBatch_GSP(): flat parameters
+// that fit in a single message, and that do not go through the control cache.
+// Everything else takes the regular rpcRmApiControl_GSP() path.
+//
+static NvBool _rpcRmApiControlIsBatchable(OBJRPC *pRpc, NvU32 cmd, void *pParams, NvU32 paramsSize, NvU32 *pCtrlFlags)
+{
+    const NvU32 fixed_param_size = sizeof(rpc_message_header_v) + sizeof(rpc_gsp_rm_control_v03_00);
+    const NvU32 interface_id = (DRF_VAL(XXXX, _CTRL_CMD, _CLASS, cmd) << 8) |
+                                DRF_VAL(XXXX, _CTRL_CMD, _CATEGORY, cmd);
+    const NvU32 message_id = DRF_VAL(XXXX, _CTRL_CMD, _INDEX, cmd);
+    NvU32 ctrlAccessRight = 0;
+
+    *pCtrlFlags = 0;
+
+    if ((pParams == NULL) != (paramsSize == 0))
+        return NV_FALSE;
+
+    if (paramsSize > pRpc->maxRpcSize - fixed_param_size)
+        return NV_FALSE;
+
+    if (rmapiutilGetControlInfo(cmd, pCtrlFlags, &ctrlAccessRight, NULL) != NV_OK)
+        return NV_FALSE;
+
+    if (rmapiControlIsCacheable(*pCtrlFlags, ctrlAccessRight, NV_TRUE) || IsGssLegacyCall(cmd))
+        return NV_FALSE;
+
+    if ((pParams != NULL) && (FinnRmApiGetSerializedSize(interface_id, message_id, pParams) != 0))
+        return NV_FALSE;
+
+    return NV_TRUE;
+}
+
+// Deferred RPC callback copying a batched control response out of the staging area
+static void _rpcRmApiControlBatchComplete
+(
+    OBJGPU *pGpu,
+    void *pArg,
+    NvU32 function,
+    NvU32 sequence,
+    NV_STATUS status
+)
+{
+    RMAPI_CONTROL_BATCH_ENTRY *pEntry = pArg;
+    OBJRPC *pRpc = GPU_GET_RPC(pGpu);
+    rpc_gsp_rm_control_v03_00 *rpc_params = &rpc_message->gsp_rm_control_v03_00;
+
+    if (status != NV_OK)
+    {
+        pEntry->status = status;
+        return;
+    }
+
+    if ((rpc_params->status == NV_OK) || (rpc_params->rmapiRpcFlags & RMAPI_RPC_FLAGS_COPYOUT_ON_ERROR))
+    {
+        if (pEntry->paramsSize != 0)
+            portMemCopy(pEntry->pParams, pEntry->paramsSize, rpc_params->params, pEntry->paramsSize);
+    }
+
+    pEntry->status = rpc_params->status;
+}
+
+/*!
+ * Issue a batch of controls to GSP-RM.
+ *
+ * Batchable controls are sent back to back without waiting for each response,
+ * the responses being collected in order as they come back. Other controls are
+ * issued synchronously at their position in the batch; since GSP-RM answers in
+ * order, waiting for them also collects the responses of the controls before
+ * them.
+ */
+NV_STATUS rpcRmApiControlBatch_GSP
+(
+    RM_API *pRmApi,
+    NvHandle hClient,
+    RMAPI_CONTROL_BATCH_ENTRY *pEntries,
+    NvU32 numEntries
+)
+{
+    NV_STATUS status = NV_OK;
+    OBJGPU *pGpu = (OBJGPU*)pRmApi->pPrivateContext;
+    OBJRPC *pRpc = GPU_GET_RPC(pGpu);
+    NvU32 gpuMaskRelease = 0;
+    NvU32 lastSequence = 0;
+    NvBool bPending = NV_FALSE;
+    NvU32 i;
+
+    NV_ASSERT_OR_RETURN((pEntries != NULL) || (numEntries == 0), NV_ERR_INVALID_ARGUMENT);
+
+    if (!rmDeviceGpuLockIsOwner(pGpu->gpuInstance))
+    {
+        NV_PRINTF(LEVEL_WARNING, "Calling RPC RmControl batch without adequate locks!\n");
+        RPC_LOCK_DEBUG_DUMP_STACK();
+
+        NV_ASSERT_OK_OR_RETURN(
+            rmGpuGroupLockAcquire(pGpu->gpuInstance, GPU_LOCK_GRP_SUBDEVICE,
+                GPU_LOCK_FLAGS_SAFE_LOCK_UPGRADE, RM_LOCK_MODULES_RPC, &gpuMaskRelease));
+    }
+
+    for (i = 0; i < numEntries; i++)
+    {
+        RMAPI_CONTROL_BATCH_ENTRY *pEntry = &pEntries[i];
+        rpc_gsp_rm_control_v03_00 *rpc_params;
+        NvU32 ctrlFlags;
+        NV_STATUS rpcStatus;
+
+        if (!_rpcRmApiControlIsBatchable(pRpc, pEntry->cmd, pEntry->pParams, pEntry->paramsSize, &ctrlFlags))
+        {
+            pEntry->status = rpcRmApiControl_GSP(pRmApi, hClient, pEntry->hObject, pEntry->cmd,
+                                                 pEntry->pParams, pEntry->paramsSize);
+            continue;
+        }
+
+        pEntry->status = rpcWriteCommonHeader(pGpu, pRpc, NV_VGPU_MSG_FUNCTION_GSP_RM_CONTROL,
+                                              sizeof(rpc_gsp_rm_control_v03_00) + pEntry->paramsSize);
+        if (pEntry->status != NV_OK)
+            continue;
+
+        rpc_params = &rpc_message->gsp_rm_control_v03_00;
+        rpc_params->hClient           = hClient;
+        rpc_params->hObject           = pEntry->hObject;
+        rpc_params->cmd               = pEntry->cmd;
+        rpc_params->paramsSize        = pEntry->paramsSize;
+        rpc_params->rmapiRpcFlags     = RMAPI_RPC_FLAGS_NONE;
+        rpc_params->rmctrlFlags       = 0;
+        rpc_params->rmctrlAccessRight = 0;
+
+        // Honored by _rpcRmApiControlBatchComplete() as in rpcRmApiControl_GSP()
+        if (ctrlFlags & RMCTRL_FLAGS_COPYOUT_ON_ERROR)
+            rpc_params->rmapiRpcFlags |= RMAPI_RPC_FLAGS_COPYOUT_ON_ERROR;
+
+        if (pEntry->paramsSize != 0)
+            portMemCopy(rpc_params->params, pEntry->paramsSize, pEntry->pParams, pEntry->paramsSize);
+
+        // Overwritten by _rpcRmApiControlBatchComplete(), including on failure
+        pEntry->status = NV_ERR_INVALID_STATE;
+
+        rpcStatus = _issueRpcDeferred(pGpu, pRpc, _rpcRmApiControlBatchComplete, pEntry, &lastSequence);
+        if (rpcStatus != NV_OK)
+        {
+            pEntry->status = rpcStatus;
+            continue;
+        }
+
+        bPending = NV_TRUE;
+    }
+
+    if (bPending)
+        (void)rpcWaitDeferred(pGpu, pRpc, lastSequence);
+
+    for (i = 0; i < numEntries; i++)
+    {
+        if (pEntries[i].status != NV_OK)
+        {
+            NV_PRINTF_COND((pRpc->bQuietPrints || _rpcRmApiControlIsQuietStatus(pEntries[i].status)),
+                LEVEL_INFO, LEVEL_WARNING,
+                "GspRmControl batch entry %u failed: hClient=0x%08x; hObject=0x%08x; cmd=0x%08x; status=0x%08x\n",
+                i, hClient, pEntries[i].hObject, pEntries[i].cmd, pEntries[i].status);
+
+            if (status == NV_OK)
+                status = pEntries[i].status;
+        }
+    }
+
+    if (gpuMaskRelease != 0)
+    {
+        rmGpuGroupLockRelease(gpuMaskRelease, GPUS_LOCK_FLAGS_NONE);
+    }
+
+    return status;
+}
+
 NV_STATUS rpcRmApiAlloc_GSP
 (
     RM_API  *pRmApi,
@@ -11511,6 +11923,17 @@ NV_STATUS rpcRmApiFree_GSP
     rpc_params->hObjectParent = NV01_NULL_OBJECT;
     rpc_params->hObjectOld = hObject;
 
+    //
+    // GSP-RM processes RPCs in order, so any later RPC touching the freed
+    // object observes the free. Failures are reported when the response is
+    // retired.
+    //
+    if (pRpc->bDeferFree)
+    {
+        status = _issueRpcDeferred(pGpu, pRpc, NULL, NULL, NULL);
+        goto done;
+    }
+
     status = _issueRpcAndWait(pGpu, pRpc);
     if (status != NV_OK)
     {